@@ -441,6 +441,32 @@ ErrCode BackgroundTaskManager::ActiveContinuousTask(int32_t uid, int32_t pid, co
     return proxy_->ActiveContinuousTask(uid, pid, key);
 }
 
+ErrCode BackgroundTaskManager::StopContinuousTasks(const std::vector<ContinuousTaskControlInfo> &taskList,
+    uint32_t taskType)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    GET_BACK_GROUND_TASK_MANAGER_PROXY_RETURN
+
+    return proxy_->StopContinuousTasks(taskList, taskType);
+}
+
+ErrCode BackgroundTaskManager::SuspendContinuousTasks(const std::vector<ContinuousTaskControlInfo> &taskList,
+    bool isStandby)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    GET_BACK_GROUND_TASK_MANAGER_PROXY_RETURN
+
+    return proxy_->SuspendContinuousTasks(taskList, isStandby);
+}
+
+ErrCode BackgroundTaskManager::ActiveContinuousTasks(const std::vector<ContinuousTaskControlInfo> &taskList)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    GET_BACK_GROUND_TASK_MANAGER_PROXY_RETURN
+
+    return proxy_->ActiveContinuousTasks(taskList);
+}
+
 ErrCode BackgroundTaskManager::AVSessionNotifyUpdateNotification(int32_t uid, int32_t pid, bool isPublish)
 {
     std::lock_guard<std::mutex> lock(mutex_);
@@ -602,6 +628,37 @@ ErrCode BackgroundTaskManager::GetAllContinuousTaskApps(
     return result;
 }
 
+ErrCode BackgroundTaskManager::GetContinuousTaskAppsDelta(uint64_t sinceGeneration, uint64_t &generation,
+    bool &isFullResync, std::vector<std::shared_ptr<ContinuousTaskCallbackInfo>> &addedList,
+    std::vector<std::shared_ptr<ContinuousTaskCallbackInfo>> &updatedList,
+    std::vector<std::shared_ptr<ContinuousTaskCallbackInfo>> &removedList)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    GET_BACK_GROUND_TASK_MANAGER_PROXY_RETURN
+
+    std::vector<ContinuousTaskCallbackInfo> added;
+    std::vector<ContinuousTaskCallbackInfo> updated;
+    std::vector<ContinuousTaskCallbackInfo> removed;
+    ErrCode result = proxy_->GetContinuousTaskAppsDelta(sinceGeneration, generation, isFullResync, added, updated,
+        removed);
+    if (result != ERR_OK) {
+        return result;
+    }
+    addedList.clear();
+    updatedList.clear();
+    removedList.clear();
+    for (const auto &item : added) {
+        addedList.push_back(std::make_shared<ContinuousTaskCallbackInfo>(item));
+    }
+    for (const auto &item : updated) {
+        updatedList.push_back(std::make_shared<ContinuousTaskCallbackInfo>(item));
+    }
+    for (const auto &item : removed) {
+        removedList.push_back(std::make_shared<ContinuousTaskCallbackInfo>(item));
+    }
+    return result;
+}
+
 ErrCode BackgroundTaskManager::SendNotificationByDeteTask(const std::set<std::string> &taskKeys)
 {
     std::lock_guard<std::mutex> lock(mutex_);
@@ -21,6 +21,7 @@
 #include "bgtaskmgr_inner_errors.h"
 #include "continuous_task_request.h"
 #include "background_task_state_info.h"
+#include "continuous_task_control_info.h"
 #include "background_common.h"
 
 namespace OHOS {
@@ -191,6 +192,30 @@ public:
      */
     static ErrCode ActiveContinuousTask(int32_t uid, int32_t pid, const std::string &key);
 
+    /**
+     * @brief Request stop continuous tasks in batch, applied by the service in one pass.
+     * @param taskList uid, pid and key of the continuous tasks.
+     * @param taskType continuous task type.
+     * @return Returns ERR_OK if success, else failure.
+     */
+    static ErrCode StopContinuousTasks(const std::vector<ContinuousTaskControlInfo> &taskList, uint32_t taskType);
+
+    /**
+     * @brief Request suspend continuous tasks in batch, applied by the service in one pass.
+     * @param taskList uid, pid, key and suspend reason of the continuous tasks.
+     * @param isStandby whether it is standby send, default is false.
+     * @return Returns ERR_OK if success, else failure.
+     */
+    static ErrCode SuspendContinuousTasks(const std::vector<ContinuousTaskControlInfo> &taskList,
+        bool isStandby = false);
+
+    /**
+     * @brief Request active continuous tasks in batch, applied by the service in one pass.
+     * @param taskList uid, pid and key of the continuous tasks.
+     * @return Returns ERR_OK if success, else failure.
+     */
+    static ErrCode ActiveContinuousTasks(const std::vector<ContinuousTaskControlInfo> &taskList);
+
     /**
      * @brief AVsession notify update notification.
      * @param uid app uid.
@@ -299,6 +324,22 @@ public:
      */
     static ErrCode GetAllContinuousTaskApps(std::vector<std::shared_ptr<ContinuousTaskCallbackInfo>> &list);
 
+    /**
+     * @brief Get continuous task running infos changed since a generation, include suspend.
+     * @param sinceGeneration generation returned by the last query, 0 for the first query.
+     * @param generation generation of the returned infos, pass it in the next query.
+     * @param isFullResync true if all running infos are returned in addedList and the cached infos should be
+     * dropped, happens on the first query, after service restart or when the caller is too far behind.
+     * @param addedList infos of the tasks started since the generation.
+     * @param updatedList infos of the tasks changed since the generation.
+     * @param removedList last infos of the tasks stopped since the generation.
+     * @return Returns ERR_OK if success, else failure.
+     */
+    static ErrCode GetContinuousTaskAppsDelta(uint64_t sinceGeneration, uint64_t &generation, bool &isFullResync,
+        std::vector<std::shared_ptr<ContinuousTaskCallbackInfo>> &addedList,
+        std::vector<std::shared_ptr<ContinuousTaskCallbackInfo>> &updatedList,
+        std::vector<std::shared_ptr<ContinuousTaskCallbackInfo>> &removedList);
+
     /**
      * @brief send continuous task notification by suspend
      * @param taskKeys continuous task key
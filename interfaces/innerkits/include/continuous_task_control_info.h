@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FOUNDATION_RESOURCESCHEDULE_BACKGROUND_TASK_MGR_INTERFACES_INNERKITS_INCLUDE_CONTINUOUS_TASK_CONTROL_INFO_H
+#define FOUNDATION_RESOURCESCHEDULE_BACKGROUND_TASK_MGR_INTERFACES_INNERKITS_INCLUDE_CONTINUOUS_TASK_CONTROL_INFO_H
+
+#include <string>
+#include "parcel.h"
+
+namespace OHOS {
+namespace BackgroundTaskMgr {
+/**
+ * One entry of a batched suspend, active or stop request sent by system services.
+ */
+class ContinuousTaskControlInfo : public Parcelable {
+public:
+    ContinuousTaskControlInfo() = default;
+    ContinuousTaskControlInfo(int32_t uid, int32_t pid, const std::string &key, int32_t reason = 0)
+        : uid_(uid), pid_(pid), key_(key), reason_(reason) {}
+
+    static ContinuousTaskControlInfo* Unmarshalling(Parcel& in);
+    bool Marshalling(Parcel& out) const override;
+    void SetUid(int32_t uid);
+    void SetPid(int32_t pid);
+    void SetKey(const std::string &key);
+    void SetReason(int32_t reason);
+    int32_t GetUid() const;
+    int32_t GetPid() const;
+    std::string GetKey() const;
+    int32_t GetReason() const;
+
+private:
+    bool ReadFromParcel(Parcel& in);
+
+    int32_t uid_ {-1};
+    int32_t pid_ {-1};
+    std::string key_ {""};
+    int32_t reason_ {0};
+};
+}  // namespace BackgroundTaskMgr
+}  // namespace OHOS
+#endif  // FOUNDATION_RESOURCESCHEDULE_BACKGROUND_TASK_MGR_INTERFACES_INNERKITS_INCLUDE_CONTINUOUS_TASK_CONTROL_INFO_H
@@ -130,6 +130,23 @@ ErrCode BackgroundTaskMgrHelper::ActiveContinuousTask(int32_t uid, int32_t pid,
     return DelayedSingleton<BackgroundTaskManager>::GetInstance()->ActiveContinuousTask(uid, pid, key);
 }
 
+ErrCode BackgroundTaskMgrHelper::StopContinuousTasks(const std::vector<ContinuousTaskControlInfo> &taskList,
+    uint32_t taskType)
+{
+    return DelayedSingleton<BackgroundTaskManager>::GetInstance()->StopContinuousTasks(taskList, taskType);
+}
+
+ErrCode BackgroundTaskMgrHelper::SuspendContinuousTasks(const std::vector<ContinuousTaskControlInfo> &taskList,
+    bool isStandby)
+{
+    return DelayedSingleton<BackgroundTaskManager>::GetInstance()->SuspendContinuousTasks(taskList, isStandby);
+}
+
+ErrCode BackgroundTaskMgrHelper::ActiveContinuousTasks(const std::vector<ContinuousTaskControlInfo> &taskList)
+{
+    return DelayedSingleton<BackgroundTaskManager>::GetInstance()->ActiveContinuousTasks(taskList);
+}
+
 ErrCode BackgroundTaskMgrHelper::AVSessionNotifyUpdateNotification(int32_t uid, int32_t pid, bool isPublish)
 {
     return DelayedSingleton<BackgroundTaskManager>::GetInstance()->
@@ -198,6 +215,15 @@ ErrCode BackgroundTaskMgrHelper::GetAllContinuousTaskApps(
     return DelayedSingleton<BackgroundTaskManager>::GetInstance()->GetAllContinuousTaskApps(list);
 }
 
+ErrCode BackgroundTaskMgrHelper::GetContinuousTaskAppsDelta(uint64_t sinceGeneration, uint64_t &generation,
+    bool &isFullResync, std::vector<std::shared_ptr<ContinuousTaskCallbackInfo>> &addedList,
+    std::vector<std::shared_ptr<ContinuousTaskCallbackInfo>> &updatedList,
+    std::vector<std::shared_ptr<ContinuousTaskCallbackInfo>> &removedList)
+{
+    return DelayedSingleton<BackgroundTaskManager>::GetInstance()->GetContinuousTaskAppsDelta(sinceGeneration,
+        generation, isFullResync, addedList, updatedList, removedList);
+}
+
 ErrCode BackgroundTaskMgrHelper::SendNotificationByDeteTask(const std::set<std::string> &taskKeys)
 {
     return DelayedSingleton<BackgroundTaskManager>::GetInstance()->SendNotificationByDeteTask(taskKeys);
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "continuous_task_control_info.h"
+#include "ipc_util.h"
+#include "continuous_task_log.h"
+
+namespace OHOS {
+namespace BackgroundTaskMgr {
+bool ContinuousTaskControlInfo::Marshalling(Parcel& out) const
+{
+    WRITE_PARCEL_WITH_RET(out, Int32, uid_, false);
+    WRITE_PARCEL_WITH_RET(out, Int32, pid_, false);
+    WRITE_PARCEL_WITH_RET(out, String, key_, false);
+    WRITE_PARCEL_WITH_RET(out, Int32, reason_, false);
+    return true;
+}
+
+ContinuousTaskControlInfo* ContinuousTaskControlInfo::Unmarshalling(Parcel &in)
+{
+    ContinuousTaskControlInfo* info = new (std::nothrow) ContinuousTaskControlInfo();
+    if (info && !info->ReadFromParcel(in)) {
+        BGTASK_LOGE("read from parcel failed");
+        delete info;
+        info = nullptr;
+    }
+    return info;
+}
+
+bool ContinuousTaskControlInfo::ReadFromParcel(Parcel& in)
+{
+    READ_PARCEL_WITH_RET(in, Int32, uid_, false);
+    READ_PARCEL_WITH_RET(in, Int32, pid_, false);
+    READ_PARCEL_WITH_RET(in, String, key_, false);
+    READ_PARCEL_WITH_RET(in, Int32, reason_, false);
+    return true;
+}
+
+void ContinuousTaskControlInfo::SetUid(int32_t uid)
+{
+    uid_ = uid;
+}
+
+void ContinuousTaskControlInfo::SetPid(int32_t pid)
+{
+    pid_ = pid;
+}
+
+void ContinuousTaskControlInfo::SetKey(const std::string &key)
+{
+    key_ = key;
+}
+
+void ContinuousTaskControlInfo::SetReason(int32_t reason)
+{
+    reason_ = reason;
+}
+
+int32_t ContinuousTaskControlInfo::GetUid() const
+{
+    return uid_;
+}
+
+int32_t ContinuousTaskControlInfo::GetPid() const
+{
+    return pid_;
+}
+
+std::string ContinuousTaskControlInfo::GetKey() const
+{
+    return key_;
+}
+
+int32_t ContinuousTaskControlInfo::GetReason() const
+{
+    return reason_;
+}
+}  // namespace BackgroundTaskMgr
+}  // namespace OHOS
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FOUNDATION_RESOURCESCHEDULE_BACKGROUND_TASK_MGR_SERVICES_COMMON_INCLUDE_BUNDLE_INFO_CACHE_H
+#define FOUNDATION_RESOURCESCHEDULE_BACKGROUND_TASK_MGR_SERVICES_COMMON_INCLUDE_BUNDLE_INFO_CACHE_H
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "lru_cache.h"
+#include "singleton.h"
+
+namespace OHOS {
+namespace BackgroundTaskMgr {
+/**
+ * Bundle metadata read from the bundle manager that the background task managers check on every request.
+ */
+struct BundleMetadata {
+    std::string bundleName {""};
+    int32_t userId {-1};
+    int32_t appIndex {0};
+    bool isSystemApp {false};
+    std::string appId {""};
+    std::string appIdentifier {""};
+    std::vector<std::string> reqPermissions {};
+    // 仅记录配置了长时任务类型的 ability
+    std::unordered_map<std::string, uint32_t> abilityBgModes {};
+};
+
+/**
+ * Size bounded cache of bundle metadata, app labels and uid bundle names shared by the service, entries are
+ * dropped by the bundle events of the system event observer and when the bundle manager dies, and the least
+ * recently used entry is evicted when the cache is full.
+ */
+class BundleInfoCache {
+public:
+    /**
+     * @brief Get bundle metadata, read from the bundle manager on cache miss.
+     *
+     * @return True if the metadata is valid.
+     */
+    bool GetBundleMetadata(const std::string &bundleName, int32_t userId, BundleMetadata &metadata);
+
+    /**
+     * @brief Get app label of the bundle in current system language, read from the bundle manager on cache miss.
+     */
+    std::string GetAppLabel(const std::string &bundleName);
+
+    /**
+     * @brief Get bundle name of the uid, read from the bundle manager on cache miss.
+     *
+     * @return True if the uid belongs to a bundle.
+     */
+    bool GetBundleNameForUid(int32_t uid, std::string &bundleName);
+
+    /**
+     * @brief Read metadata and label of a newly installed bundle ahead of its first request.
+     */
+    void Prefetch(const std::string &bundleName, int32_t userId);
+
+    /**
+     * @brief Drop cached entries of the bundle, all users are dropped if userId is negative.
+     */
+    void InvalidateBundle(const std::string &bundleName, int32_t userId);
+
+    /**
+     * @brief Drop all app labels, used when the system language changes.
+     */
+    void InvalidateAppLabels();
+    void Clear();
+
+    size_t GetMetadataCount();
+    size_t GetAppLabelCount();
+    size_t GetBundleNameCount();
+
+private:
+    using MetadataKey = std::pair<std::string, int32_t>;
+
+    bool FetchBundleMetadata(const std::string &bundleName, int32_t userId, BundleMetadata &metadata);
+
+    std::mutex cacheMutex_;
+    // 每次失效递增，未命中期间发生失效的查询结果不写入缓存
+    uint64_t generation_ {0};
+    LruCache<MetadataKey, BundleMetadata> metadataCache_;
+    LruCache<std::string, std::string> appLabelCache_;
+    LruCache<int32_t, std::string> bundleNameCache_;
+
+    DECLARE_DELAYED_SINGLETON(BundleInfoCache);
+};
+}  // namespace BackgroundTaskMgr
+}  // namespace OHOS
+#endif  // FOUNDATION_RESOURCESCHEDULE_BACKGROUND_TASK_MGR_SERVICES_COMMON_INCLUDE_BUNDLE_INFO_CACHE_H
@@ -30,6 +30,7 @@ using OHOS::AppExecFwk::Constants::UNSPECIFIED_USERID;
 class BundleManagerHelper : public DelayedSingleton<BundleManagerHelper> {
 public:
     std::string GetClientBundleName(int32_t uid);
+    bool GetBundleNameForUid(int32_t uid, std::string &bundleName);
     bool CheckPermission(const std::string &permission);
     bool CheckACLPermission(const std::string &permission, uint64_t callingTokenId);
     bool IsSystemApp(uint64_t fullTokenId);
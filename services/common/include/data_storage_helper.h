@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2022-2025 Huawei Device Co., Ltd.
+ * Copyright (c) 2022-2026 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -16,10 +16,17 @@
 #ifndef FOUNDATION_RESOURCESCHEDULE_BACKGROUND_TASK_MGR_DATA_STORAGE_HELPER_H
 #define FOUNDATION_RESOURCESCHEDULE_BACKGROUND_TASK_MGR_DATA_STORAGE_HELPER_H
 
+#include <functional>
+#include <map>
+#include <mutex>
+#include <set>
+#include <utility>
 #include <unique_fd.h>
 
+#include "event_handler.h"
 #include "singleton.h"
 #include "nlohmann/json.hpp"
+#include "record_snapshot.h"
 
 #include "bg_efficiency_resources_mgr.h"
 #include "bg_continuous_task_mgr.h"
@@ -28,11 +35,19 @@ namespace OHOS {
 namespace BackgroundTaskMgr {
 class DataStorageHelper : public DelayedSingleton<BgContinuousTaskMgr> {
 using ResourceRecordMap = std::unordered_map<int32_t, std::shared_ptr<ResourceApplicationRecord>>;
+using ResourceRecordFilter = std::function<bool(bool isProcess, int32_t mapKey,
+    const std::shared_ptr<ResourceApplicationRecord> &record)>;
+using RecordKeyFilter = std::function<bool(uint32_t section, const std::string &key)>;
 public:
     ErrCode RefreshTaskRecord(const std::unordered_map<std::string, std::shared_ptr<ContinuousTaskRecord>> &allRecord);
     ErrCode RestoreTaskRecord(std::unordered_map<std::string, std::shared_ptr<ContinuousTaskRecord>> &allRecord);
+    ErrCode AppendTaskRecord(const std::string &key, const std::shared_ptr<ContinuousTaskRecord> &record);
+    ErrCode AppendTaskRecords(
+        const std::vector<std::pair<std::string, std::shared_ptr<ContinuousTaskRecord>>> &records);
+    bool NeedCompactTaskRecord();
     ErrCode RefreshResourceRecord(const ResourceRecordMap &appRecord, const ResourceRecordMap &processRecord);
-    ErrCode RestoreResourceRecord(ResourceRecordMap &appRecord, ResourceRecordMap &processRecord);
+    ErrCode RestoreResourceRecord(ResourceRecordMap &appRecord, ResourceRecordMap &processRecord,
+        const ResourceRecordFilter &filter = nullptr);
     bool ParseFastSuspendDozeTime(const std::string &FilePath, int &time);
     std::string GetConfigFileAbsolutePath(const std::string &relativePath);
     int32_t ParseJsonValueFromFile(nlohmann::json &value, const std::string &filePath);
@@ -42,22 +57,61 @@ public:
     ErrCode OnBackup(MessageParcel& data, MessageParcel& reply);
     ErrCode OnRestore(MessageParcel& data, MessageParcel& reply,
         std::unordered_map<std::string, std::shared_ptr<BannerNotificationRecord>>& allRecord);
+    ErrCode FlushPendingRecord();
 
 private:
     int32_t SaveJsonValueToFile(const std::string &value, const std::string &filePath);
+    int32_t SaveBinaryValueToFile(const std::string &value, const std::string &filePath);
+    int32_t ReplaceFileContent(const std::string &value, const std::string &filePath);
+    bool LoadRecordSnapshot(const std::string &filePath, const RecordSnapshot::Visitor &visitor);
     bool ConvertFullPath(const std::string &partialPath, std::string &fullPath);
     void ConvertMapToString(const ResourceRecordMap &appRecord,
         const ResourceRecordMap &processRecord, std::string &recordString);
     void ConvertMapToJson(const ResourceRecordMap &appRecord, nlohmann::json &root);
-    void DivideJsonToMap(nlohmann::json &root,
-        ResourceRecordMap &appRecord, ResourceRecordMap &processRecord);
-    void ConvertJsonToMap(const nlohmann::json &value, ResourceRecordMap &recordMap);
+    void ConvertMapToSnapshot(const ResourceRecordMap &recordMap, uint32_t section, RecordSnapshot &snapshot);
+    ErrCode StreamJsonRecordsFromFile(const std::string &filePath, int32_t recordDepth,
+        const RecordKeyFilter &keyFilter, const RecordSnapshot::Visitor &visitor);
     ErrCode ConvertStringToJson(const std::string &recordString,
         nlohmann::json &appRecord, nlohmann::json &processRecord);
-    void ReportUserDataSizeEvent();
+    void ScheduleUserDataSizeSample();
+    void SampleUserDataSize();
+    void ReportUserDataSizeEvent(const std::vector<std::string> &paths, const std::vector<uint64_t> &folderSize);
     DECLARE_DELAYED_SINGLETON(DataStorageHelper);
     std::string SetReplyCode(int32_t replyCode);
     bool GetAuthRecord(UniqueFd &fd);
+    ErrCode MergeAuthRecordShards();
+    std::string ConvertTaskRecordToString(
+        const std::unordered_map<std::string, std::shared_ptr<ContinuousTaskRecord>> &allRecord);
+    void StageShardRecord(std::map<std::string, std::string> &records, const std::set<int32_t> &users,
+        const std::string &basePath, const std::string &manifestPath, std::set<int32_t> &stagedUsers);
+    bool LoadShardManifest(const std::string &manifestPath, std::set<int32_t> &users);
+    int32_t ReplayTaskJournal(std::unordered_map<std::string, std::shared_ptr<ContinuousTaskRecord>> &allRecord);
+    ErrCode SchedulePendingRecord();
+    bool PostFlushTask(int64_t delayMs);
+    void HandleFlushResult(ErrCode result, std::map<std::string, std::string> &failedRecords,
+        std::string &failedJournal);
+    ErrCode WriteRecordFile(const std::string &value, const std::string &filePath);
+    ErrCode AppendRecordFile(const std::string &value, const std::string &filePath);
+
+private:
+    std::mutex fileMutex_;
+    std::mutex pendingMutex_;
+    std::shared_ptr<AppExecFwk::EventHandler> persistHandler_ {nullptr};
+    int32_t writeBehindWindow_ {0};
+    bool binarySnapshot_ {false};
+    bool isFlushScheduled_ {false};
+    int32_t flushFailures_ {0};
+    ErrCode lastFlushResult_ {ERR_OK};
+    std::map<std::string, std::string> pendingRecords_ {};
+    std::set<std::string> pendingRemovals_ {};
+    std::map<std::string, std::pair<size_t, size_t>> writtenRecords_ {};
+    std::set<int32_t> taskShardUsers_ {};
+    std::set<int32_t> authShardUsers_ {};
+    std::string pendingTaskJournal_ {""};
+    int32_t taskJournalEntries_ {0};
+    bool isDataSizeSampleScheduled_ {false};
+    int64_t lastReportedDataSize_ {-1};
+    int64_t lastDataSizeReportTime_ {0};
 };
 }  // namespace BackgroundTaskMgr
 }  // namespace OHOS
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FOUNDATION_RESOURCESCHEDULE_BACKGROUND_TASK_MGR_SERVICES_COMMON_INCLUDE_EVENT_LANE_SCHEDULER_H
+#define FOUNDATION_RESOURCESCHEDULE_BACKGROUND_TASK_MGR_SERVICES_COMMON_INCLUDE_EVENT_LANE_SCHEDULER_H
+
+#include <array>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "event_handler.h"
+#include "singleton.h"
+
+namespace OHOS {
+namespace BackgroundTaskMgr {
+/**
+ * Lanes of the shared service event runner. Blocking ipc requests wait on the runner from binder threads and are
+ * posted ahead of queued work, deferred maintenance never delays them.
+ */
+enum class EventLane : uint32_t {
+    IPC = 0,
+    MAINTENANCE,
+    LANE_BUTT,
+};
+
+struct EventLaneMetrics {
+    uint64_t posted {0};
+    uint64_t executed {0};
+    uint64_t dropped {0};
+    uint64_t pending {0};
+    uint64_t maxPending {0};
+    uint64_t totalWaitUs {0};
+    uint64_t maxWaitUs {0};
+    uint64_t maxExecUs {0};
+};
+
+class EventLaneScheduler {
+public:
+    /**
+     * @brief Post a task on the lane and wait until it is executed.
+     *
+     * @param handler Handler of the caller, all handlers of the service share one runner.
+     * @param lane Lane of the task.
+     * @param task Task to execute.
+     * @return True if the task has been executed.
+     */
+    bool PostSyncTask(const std::shared_ptr<AppExecFwk::EventHandler> &handler, EventLane lane,
+        const std::function<void()> &task);
+
+    /**
+     * @brief Post a task on the lane without waiting.
+     *
+     * @param name Name of the task, can be used to remove it from the handler.
+     * @param delayTime Delay time in milliseconds.
+     * @return True if the task has been posted.
+     */
+    bool PostTask(const std::shared_ptr<AppExecFwk::EventHandler> &handler, EventLane lane,
+        const std::function<void()> &task, const std::string &name = "", int64_t delayTime = 0);
+
+    EventLaneMetrics GetLaneMetrics(EventLane lane) const;
+    void ResetLaneMetrics();
+    void DumpLaneMetrics(std::vector<std::string> &dumpInfo) const;
+
+private:
+    struct LaneCounter {
+        std::atomic<uint64_t> posted {0};
+        std::atomic<uint64_t> executed {0};
+        std::atomic<uint64_t> dropped {0};
+        std::atomic<uint64_t> pending {0};
+        std::atomic<uint64_t> maxPending {0};
+        std::atomic<uint64_t> totalWaitUs {0};
+        std::atomic<uint64_t> maxWaitUs {0};
+        std::atomic<uint64_t> maxExecUs {0};
+    };
+    class LaneTicket;
+
+    std::function<void()> WrapTask(EventLane lane, const std::function<void()> &task, int64_t delayTime);
+    static AppExecFwk::EventQueue::Priority GetLanePriority(EventLane lane);
+    static const char *GetLaneName(EventLane lane);
+    static void UpdateMax(std::atomic<uint64_t> &target, uint64_t value);
+
+    std::array<std::shared_ptr<LaneCounter>, static_cast<size_t>(EventLane::LANE_BUTT)> counters_ {};
+
+    DECLARE_DELAYED_SINGLETON(EventLaneScheduler);
+};
+}  // namespace BackgroundTaskMgr
+}  // namespace OHOS
+#endif  // FOUNDATION_RESOURCESCHEDULE_BACKGROUND_TASK_MGR_SERVICES_COMMON_INCLUDE_EVENT_LANE_SCHEDULER_H
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FOUNDATION_RESOURCESCHEDULE_BACKGROUND_TASK_MGR_SERVICES_COMMON_INCLUDE_FOREGROUND_APP_TRACKER_H
+#define FOUNDATION_RESOURCESCHEDULE_BACKGROUND_TASK_MGR_SERVICES_COMMON_INCLUDE_FOREGROUND_APP_TRACKER_H
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <unordered_map>
+
+#include "process_data.h"
+#include "singleton.h"
+
+namespace OHOS {
+namespace BackgroundTaskMgr {
+/**
+ * Foreground state of all uids, shared by the task managers. The state is maintained from the process events of
+ * the app state observer and only queried from app manager when the observer (re)connects. Writers are serialized
+ * and publish an immutable snapshot, readers only load the snapshot and never wait for a writer.
+ */
+class ForegroundAppTracker : public DelayedSingleton<ForegroundAppTracker> {
+public:
+    void OnProcessStateChanged(const AppExecFwk::ProcessData &processData);
+    void OnProcessDied(const AppExecFwk::ProcessData &processData);
+
+    /**
+     * @brief Set whether a process of the uid is in foreground.
+     */
+    void UpdateProcessState(int32_t uid, int32_t pid, bool isForeground);
+
+    /**
+     * @brief Replace the state by the foreground applications queried from app manager.
+     *
+     * @return False if the query failed, the state is kept.
+     */
+    bool Resync();
+
+    /**
+     * @brief Whether the state has been resynced from app manager at least once.
+     */
+    bool HasResynced() const;
+
+    bool IsUidForeground(int32_t uid) const;
+    void ForEachForegroundUid(const std::function<void(int32_t)> &func) const;
+    void Clear();
+
+private:
+    using ForegroundUidMap = std::unordered_map<int32_t, std::set<int32_t>>;
+
+    void PublishLocked();
+
+    std::mutex updateMutex_;
+    ForegroundUidMap foregroundUids_ {};
+    std::atomic<bool> hasResynced_ {false};
+    std::shared_ptr<const ForegroundUidMap> snapshot_ {std::make_shared<const ForegroundUidMap>()};
+    DECLARE_DELAYED_SINGLETON(ForegroundAppTracker);
+};
+}  // namespace BackgroundTaskMgr
+}  // namespace OHOS
+#endif  // FOUNDATION_RESOURCESCHEDULE_BACKGROUND_TASK_MGR_SERVICES_COMMON_INCLUDE_FOREGROUND_APP_TRACKER_H
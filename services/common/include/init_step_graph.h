@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FOUNDATION_RESOURCESCHEDULE_BACKGROUND_TASK_MGR_SERVICES_COMMON_INCLUDE_INIT_STEP_GRAPH_H
+#define FOUNDATION_RESOURCESCHEDULE_BACKGROUND_TASK_MGR_SERVICES_COMMON_INCLUDE_INIT_STEP_GRAPH_H
+
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "event_handler.h"
+
+namespace OHOS {
+namespace BackgroundTaskMgr {
+enum class InitStepState : uint8_t {
+    PENDING,
+    RUNNING,
+    SUCCEEDED,
+    FAILED,
+};
+
+struct InitStepCost {
+    std::string name {""};
+    InitStepState state {InitStepState::PENDING};
+    uint64_t costMs {0};
+};
+
+/**
+ * Runs the init steps of a manager as a dependency graph. A step starts as soon as all its dependencies have
+ * succeeded, steps without an order between them run concurrently on temporary worker runners, and steps bound
+ * to the caller run on the calling thread so they may touch state owned by the caller's task runner. A failed
+ * step skips all the steps depending on it. The cost of every step is logged when the graph finishes.
+ */
+class InitStepGraph {
+public:
+    using Step = std::function<bool()>;
+
+    explicit InitStepGraph(const std::string &name);
+
+    /**
+     * @brief Add a step, rejected if the name is already used or a dependency has not been added before.
+     *
+     * @param name Step name, also used in logs.
+     * @param step Returns false if the init failed.
+     * @param dependencies Names of the steps that must succeed before this step starts.
+     * @param onCaller Whether the step runs on the thread calling Run.
+     */
+    bool AddStep(const std::string &name, Step step, const std::vector<std::string> &dependencies = {},
+        bool onCaller = false);
+
+    /**
+     * @brief Run all steps and wait until they finish.
+     *
+     * @return True if every step has succeeded.
+     */
+    bool Run();
+
+    std::vector<InitStepCost> GetStepCosts();
+
+private:
+    struct StepNode {
+        std::string name {""};
+        Step step {nullptr};
+        std::vector<size_t> dependencies {};
+        bool onCaller {false};
+        InitStepState state {InitStepState::PENDING};
+        uint64_t costMs {0};
+    };
+
+    bool IsReady(const StepNode &node) const;
+    void StartWorkerSteps();
+    void RunStep(size_t index);
+    std::shared_ptr<AppExecFwk::EventHandler> GetWorker();
+    void ReportStepCosts(uint64_t totalCostMs);
+
+    std::string name_ {""};
+    std::mutex mutex_;
+    std::condition_variable finished_;
+    std::vector<StepNode> nodes_ {};
+    std::vector<std::shared_ptr<AppExecFwk::EventHandler>> workers_ {};
+    size_t nextWorker_ {0};
+    uint32_t runningCount_ {0};
+};
+}  // namespace BackgroundTaskMgr
+}  // namespace OHOS
+#endif  // FOUNDATION_RESOURCESCHEDULE_BACKGROUND_TASK_MGR_SERVICES_COMMON_INCLUDE_INIT_STEP_GRAPH_H
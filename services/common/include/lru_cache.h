@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FOUNDATION_RESOURCESCHEDULE_BACKGROUND_TASK_MGR_SERVICES_COMMON_INCLUDE_LRU_CACHE_H
+#define FOUNDATION_RESOURCESCHEDULE_BACKGROUND_TASK_MGR_SERVICES_COMMON_INCLUDE_LRU_CACHE_H
+
+#include <functional>
+#include <list>
+#include <map>
+#include <utility>
+
+namespace OHOS {
+namespace BackgroundTaskMgr {
+/**
+ * Map with a fixed capacity, the least recently used entry is evicted when a new key is inserted into a full
+ * cache. find and emplace of an existing key mark the entry as most recently used. Not thread safe.
+ */
+template<typename Key, typename Value>
+class LruCache {
+public:
+    using value_type = std::pair<const Key, Value>;
+    using iterator = typename std::list<value_type>::iterator;
+    using const_iterator = typename std::list<value_type>::const_iterator;
+
+    explicit LruCache(size_t capacity) : capacity_(capacity == 0 ? 1 : capacity) {}
+
+    iterator begin()
+    {
+        return entries_.begin();
+    }
+
+    iterator end()
+    {
+        return entries_.end();
+    }
+
+    const_iterator begin() const
+    {
+        return entries_.begin();
+    }
+
+    const_iterator end() const
+    {
+        return entries_.end();
+    }
+
+    size_t size() const
+    {
+        return entries_.size();
+    }
+
+    bool empty() const
+    {
+        return entries_.empty();
+    }
+
+    size_t capacity() const
+    {
+        return capacity_;
+    }
+
+    size_t count(const Key &key) const
+    {
+        return index_.count(key);
+    }
+
+    iterator find(const Key &key)
+    {
+        auto iter = index_.find(key);
+        if (iter == index_.end()) {
+            return entries_.end();
+        }
+        Touch(iter->second);
+        return iter->second;
+    }
+
+    std::pair<iterator, bool> emplace(const Key &key, const Value &value)
+    {
+        auto iter = find(key);
+        if (iter != entries_.end()) {
+            return std::make_pair(iter, false);
+        }
+        if (entries_.size() >= capacity_) {
+            index_.erase(entries_.back().first);
+            entries_.pop_back();
+        }
+        entries_.emplace_front(key, value);
+        index_.emplace(key, entries_.begin());
+        return std::make_pair(entries_.begin(), true);
+    }
+
+    size_t erase(const Key &key)
+    {
+        auto iter = index_.find(key);
+        if (iter == index_.end()) {
+            return 0;
+        }
+        entries_.erase(iter->second);
+        index_.erase(iter);
+        return 1;
+    }
+
+    size_t erase_if(const std::function<bool(const value_type &)> &predicate)
+    {
+        size_t erased = 0;
+        auto iter = entries_.begin();
+        while (iter != entries_.end()) {
+            if (predicate(*iter)) {
+                index_.erase(iter->first);
+                iter = entries_.erase(iter);
+                erased++;
+            } else {
+                iter++;
+            }
+        }
+        return erased;
+    }
+
+    void clear()
+    {
+        entries_.clear();
+        index_.clear();
+    }
+
+private:
+    void Touch(iterator iter)
+    {
+        entries_.splice(entries_.begin(), entries_, iter);
+    }
+
+    size_t capacity_ {1};
+    std::list<value_type> entries_ {};
+    std::map<Key, iterator> index_ {};
+};
+}  // namespace BackgroundTaskMgr
+}  // namespace OHOS
+#endif  // FOUNDATION_RESOURCESCHEDULE_BACKGROUND_TASK_MGR_SERVICES_COMMON_INCLUDE_LRU_CACHE_H
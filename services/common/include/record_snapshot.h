@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FOUNDATION_RESOURCESCHEDULE_BACKGROUND_TASK_MGR_SERVICES_COMMON_INCLUDE_RECORD_SNAPSHOT_H
+#define FOUNDATION_RESOURCESCHEDULE_BACKGROUND_TASK_MGR_SERVICES_COMMON_INCLUDE_RECORD_SNAPSHOT_H
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+#include "nlohmann/json.hpp"
+
+namespace OHOS {
+namespace BackgroundTaskMgr {
+/**
+ * Binary snapshot layout, all integers little endian:
+ *   header: magic(u32) | version(u16) | reserved(u16) | recordCount(u32)
+ *   record: section(u32) | keyLen(u32) | payloadLen(u32) | crc32(u32) | key | payload
+ * payload is the msgpack encoding of the record json, crc32 covers section, key and payload.
+ */
+class RecordSnapshot {
+public:
+    using Visitor = std::function<void(uint32_t section, const std::string &key, const nlohmann::json &value)>;
+
+    RecordSnapshot();
+
+    /**
+     * @brief Append one record to the snapshot.
+     *
+     * @param section Caller defined group of the record.
+     * @param key Record key.
+     * @param value Record content.
+     */
+    void Append(uint32_t section, const std::string &key, const nlohmann::json &value);
+
+    /**
+     * @brief Finish the snapshot and take the encoded buffer.
+     *
+     * @return Encoded snapshot.
+     */
+    std::string Finish();
+
+    /**
+     * @brief Check whether the buffer starts with a snapshot header of a supported version.
+     */
+    static bool IsSnapshot(const uint8_t *data, size_t size);
+
+    /**
+     * @brief Walk all records of the buffer, records with a bad crc are skipped.
+     *
+     * @param data Encoded snapshot, may point into a mapped file.
+     * @param size Size of data.
+     * @param visitor Called for each valid record.
+     * @return True if the header is valid and the buffer is not truncated.
+     */
+    static bool Decode(const uint8_t *data, size_t size, const Visitor &visitor);
+
+    /**
+     * @brief Feed data into a crc32 register, the caller handles the initial value and final xor.
+     */
+    static uint32_t Crc32(uint32_t crc, const uint8_t *data, size_t size);
+
+private:
+    std::string buffer_ {""};
+    uint32_t recordCount_ {0};
+};
+}  // namespace BackgroundTaskMgr
+}  // namespace OHOS
+#endif  // FOUNDATION_RESOURCESCHEDULE_BACKGROUND_TASK_MGR_SERVICES_COMMON_INCLUDE_RECORD_SNAPSHOT_H
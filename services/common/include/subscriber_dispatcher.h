@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FOUNDATION_RESOURCESCHEDULE_BACKGROUND_TASK_MGR_SERVICES_COMMON_INCLUDE_SUBSCRIBER_DISPATCHER_H
+#define FOUNDATION_RESOURCESCHEDULE_BACKGROUND_TASK_MGR_SERVICES_COMMON_INCLUDE_SUBSCRIBER_DISPATCHER_H
+
+#include <atomic>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "event_handler.h"
+#include "iremote_object.h"
+#include "singleton.h"
+
+namespace OHOS {
+namespace BackgroundTaskMgr {
+enum class SubscriberSource : uint32_t {
+    CONTINUOUS_TASK = 0,
+    TRANSIENT_TASK,
+    EFFICIENCY_RESOURCES,
+};
+
+struct SubscriberEvent {
+    // 事件类型由调用方定义，合并后以先入队事件的类型投递
+    uint32_t eventType {0};
+    // 为空时不参与合并
+    std::string coalesceKey {""};
+    // 同一 coalesceKey 最近一个未投递事件的类型在此列表中时，本事件并入该事件
+    std::vector<uint32_t> foldInto {};
+    // 同一 coalesceKey 最近一个未投递事件的类型在此列表中时，两个事件相互抵消，都不再投递
+    std::vector<uint32_t> cancelOut {};
+    // 事件携带的信息会被后续事件覆盖，队列满时优先丢弃
+    bool droppable {false};
+    std::function<void(uint32_t eventType)> delivery {nullptr};
+    // 订阅者丢失过状态事件时，积压投递完成后调用，通知订阅者重新查询全量状态
+    std::function<void()> resync {nullptr};
+};
+
+struct SubscriberDispatcherStats {
+    uint64_t dispatched {0};
+    uint64_t delivered {0};
+    uint64_t coalesced {0};
+    uint64_t dropped {0};
+    uint64_t droppedStateEvents {0};
+    uint64_t resyncs {0};
+    uint64_t slowDeliveries {0};
+    uint64_t blockedSubscribers {0};
+};
+
+/**
+ * Delivers subscriber callbacks off the task runners. Every subscriber of every source manager owns a bounded
+ * queue that is drained in order by one runner of a small dispatcher pool, so a slow subscriber only delays its
+ * own events. Subscribers that keep blocking their deliveries are paused for a cool-down, and are told to resync
+ * once their backlog is delivered if a state changing event had to be dropped.
+ */
+class SubscriberDispatcher {
+public:
+    /**
+     * @brief Queue an event to the subscriber.
+     *
+     * @param source Manager that sends the event, queues of different managers never affect each other.
+     * @param remote Remote object of the subscriber, used as the queue key. The event is delivered in place if
+     * it is null.
+     * @param event Event to deliver.
+     * @return True if the event has been queued or merged into a queued event.
+     */
+    bool Dispatch(SubscriberSource source, const sptr<IRemoteObject> &remote, SubscriberEvent event);
+
+    /**
+     * @brief Drop the queue of a subscriber that unsubscribed from the source manager or died.
+     */
+    void RemoveSubscriber(SubscriberSource source, const sptr<IRemoteObject> &remote);
+
+    /**
+     * @brief Wait until all queued events have been delivered.
+     */
+    void Flush();
+
+    SubscriberDispatcherStats GetStats();
+    void DumpDispatcherInfo(std::vector<std::string> &dumpInfo);
+
+private:
+    using QueueKey = std::pair<SubscriberSource, IRemoteObject *>;
+
+    struct SubscriberQueue {
+        SubscriberSource source {SubscriberSource::CONTINUOUS_TASK};
+        sptr<IRemoteObject> remote {nullptr};
+        size_t runnerIndex {0};
+        std::list<SubscriberEvent> events {};
+        bool draining {false};
+        bool blocked {false};
+        bool removed {false};
+        bool needResync {false};
+        std::function<void()> resync {nullptr};
+        uint32_t slowCount {0};
+        uint64_t delivered {0};
+        uint64_t dropped {0};
+        uint64_t maxExecUs {0};
+    };
+
+    bool TryCoalesce(SubscriberQueue &queue, SubscriberEvent &event);
+    void DropOneEvent(SubscriberQueue &queue);
+    bool PopNextEvent(SubscriberQueue &queue, SubscriberEvent &event);
+    void ScheduleDrain(const std::shared_ptr<SubscriberQueue> &queue);
+    void Drain(const std::shared_ptr<SubscriberQueue> &queue);
+    void OnDelivered(const std::shared_ptr<SubscriberQueue> &queue, uint64_t execUs);
+    void Unblock(const std::shared_ptr<SubscriberQueue> &queue);
+    bool HasDrainingQueue();
+
+    std::mutex queueMutex_;
+    std::map<QueueKey, std::shared_ptr<SubscriberQueue>> queues_ {};
+    std::vector<std::shared_ptr<AppExecFwk::EventHandler>> handlers_ {};
+    size_t nextRunnerIndex_ {0};
+    std::atomic<uint64_t> dispatched_ {0};
+    std::atomic<uint64_t> delivered_ {0};
+    std::atomic<uint64_t> coalesced_ {0};
+    std::atomic<uint64_t> dropped_ {0};
+    std::atomic<uint64_t> droppedStateEvents_ {0};
+    std::atomic<uint64_t> resyncs_ {0};
+    std::atomic<uint64_t> slowDeliveries_ {0};
+    std::atomic<uint64_t> blockedSubscribers_ {0};
+
+    DECLARE_DELAYED_SINGLETON(SubscriberDispatcher);
+};
+}  // namespace BackgroundTaskMgr
+}  // namespace OHOS
+#endif  // FOUNDATION_RESOURCESCHEDULE_BACKGROUND_TASK_MGR_SERVICES_COMMON_INCLUDE_SUBSCRIBER_DISPATCHER_H
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FOUNDATION_RESOURCESCHEDULE_BACKGROUND_TASK_MGR_SERVICES_COMMON_INCLUDE_SUBSCRIBER_EVENT_PARCEL_H
+#define FOUNDATION_RESOURCESCHEDULE_BACKGROUND_TASK_MGR_SERVICES_COMMON_INCLUDE_SUBSCRIBER_EVENT_PARCEL_H
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "ibackground_task_subscriber.h"
+#include "iremote_object.h"
+#include "parcel.h"
+
+namespace OHOS {
+namespace BackgroundTaskMgr {
+/**
+ * Callback payload of one subscriber event. The payload is marshalled at most once, on the first send to a remote
+ * subscriber, and the same bytes are copied into the request of every other remote subscriber. Subscribers living
+ * in the service process are called directly by the caller and never marshal the payload.
+ */
+class SubscriberEventParcel {
+public:
+    explicit SubscriberEventParcel(const std::shared_ptr<Parcelable> &info);
+
+    /**
+     * @brief Send the payload to a subscriber proxy with the ipc code of the callback.
+     *
+     * @param remote Remote object of the subscriber.
+     * @param code Ipc code of the subscriber callback.
+     * @return False if the subscriber is not a remote proxy or the payload can not be marshalled, the caller then
+     * calls the subscriber interface instead.
+     */
+    bool SendRequest(const sptr<IRemoteObject> &remote, IBackgroundTaskSubscriberIpcCode code);
+
+    bool IsMarshalled() const;
+
+private:
+    bool Marshal();
+
+    std::shared_ptr<Parcelable> info_ {nullptr};
+    std::once_flag marshalFlag_;
+    std::atomic<bool> marshalled_ {false};
+    std::vector<uint8_t> payload_ {};
+};
+}  // namespace BackgroundTaskMgr
+}  // namespace OHOS
+#endif  // FOUNDATION_RESOURCESCHEDULE_BACKGROUND_TASK_MGR_SERVICES_COMMON_INCLUDE_SUBSCRIBER_EVENT_PARCEL_H
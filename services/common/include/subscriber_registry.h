@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FOUNDATION_RESOURCESCHEDULE_BACKGROUND_TASK_MGR_SERVICES_COMMON_INCLUDE_SUBSCRIBER_REGISTRY_H
+#define FOUNDATION_RESOURCESCHEDULE_BACKGROUND_TASK_MGR_SERVICES_COMMON_INCLUDE_SUBSCRIBER_REGISTRY_H
+
+#include <functional>
+#include <iterator>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+#include "iremote_object.h"
+
+namespace OHOS {
+namespace BackgroundTaskMgr {
+/**
+ * Subscribers keyed by their remote object, kept in registration order. Every subscriber is also listed in the
+ * event buckets selected by the bit mask of its bucket getter, so an event only visits the subscribers interested
+ * in it. Buckets are rebuilt on the first lookup after a change. Not thread safe.
+ */
+template<typename Info>
+class SubscriberRegistry {
+public:
+    using iterator = typename std::list<Info>::iterator;
+    using const_iterator = typename std::list<Info>::const_iterator;
+    using KeyGetter = std::function<sptr<IRemoteObject>(const Info &)>;
+    using BucketGetter = std::function<uint32_t(const Info &)>;
+
+    /**
+     * @brief Registry of subscriber interfaces with all subscribers in bucket 0.
+     */
+    SubscriberRegistry() : SubscriberRegistry(1, GetInterfaceRemote, GetDefaultBuckets) {}
+
+    SubscriberRegistry(uint32_t bucketCount, KeyGetter keyGetter, BucketGetter bucketGetter)
+        : keyGetter_(keyGetter), bucketGetter_(bucketGetter), buckets_(bucketCount) {}
+
+    iterator begin()
+    {
+        return entries_.begin();
+    }
+
+    iterator end()
+    {
+        return entries_.end();
+    }
+
+    const_iterator begin() const
+    {
+        return entries_.begin();
+    }
+
+    const_iterator end() const
+    {
+        return entries_.end();
+    }
+
+    size_t size() const
+    {
+        return entries_.size();
+    }
+
+    bool empty() const
+    {
+        return entries_.empty();
+    }
+
+    /**
+     * @brief Append a subscriber, rejected if its remote object is null or already registered.
+     */
+    bool emplace_back(const Info &info)
+    {
+        sptr<IRemoteObject> remote = keyGetter_(info);
+        if (remote == nullptr || index_.count(remote.GetRefPtr()) > 0) {
+            return false;
+        }
+        entries_.emplace_back(info);
+        index_.emplace(remote.GetRefPtr(), std::prev(entries_.end()));
+        bucketsStale_ = true;
+        return true;
+    }
+
+    iterator find(const sptr<IRemoteObject> &remote)
+    {
+        if (remote == nullptr) {
+            return entries_.end();
+        }
+        auto iter = index_.find(remote.GetRefPtr());
+        return iter == index_.end() ? entries_.end() : iter->second;
+    }
+
+    iterator erase(iterator iter)
+    {
+        sptr<IRemoteObject> remote = keyGetter_(*iter);
+        if (remote != nullptr) {
+            index_.erase(remote.GetRefPtr());
+        }
+        bucketsStale_ = true;
+        return entries_.erase(iter);
+    }
+
+    size_t erase(const sptr<IRemoteObject> &remote)
+    {
+        auto iter = find(remote);
+        if (iter == entries_.end()) {
+            return 0;
+        }
+        erase(iter);
+        return 1;
+    }
+
+    void clear()
+    {
+        entries_.clear();
+        index_.clear();
+        bucketsStale_ = true;
+    }
+
+    /**
+     * @brief Called after the fields read by the bucket getter of a registered subscriber have changed.
+     */
+    void Reclassify()
+    {
+        bucketsStale_ = true;
+    }
+
+    const std::vector<Info> &GetBucket(uint32_t bucket)
+    {
+        if (bucketsStale_) {
+            RebuildBuckets();
+        }
+        return bucket < buckets_.size() ? buckets_[bucket] : emptyBucket_;
+    }
+
+private:
+    static sptr<IRemoteObject> GetInterfaceRemote(const Info &info)
+    {
+        if (info == nullptr) {
+            return nullptr;
+        }
+        return info->AsObject();
+    }
+
+    static uint32_t GetDefaultBuckets(const Info &)
+    {
+        return 1u;
+    }
+
+    void RebuildBuckets()
+    {
+        for (auto &bucket : buckets_) {
+            bucket.clear();
+        }
+        for (const auto &info : entries_) {
+            uint32_t mask = bucketGetter_(info);
+            for (uint32_t bucket = 0; bucket < buckets_.size(); bucket++) {
+                if ((mask & (1u << bucket)) != 0) {
+                    buckets_[bucket].emplace_back(info);
+                }
+            }
+        }
+        bucketsStale_ = false;
+    }
+
+    KeyGetter keyGetter_ {nullptr};
+    BucketGetter bucketGetter_ {nullptr};
+    std::list<Info> entries_ {};
+    std::unordered_map<IRemoteObject *, iterator> index_ {};
+    std::vector<std::vector<Info>> buckets_ {};
+    std::vector<Info> emptyBucket_ {};
+    bool bucketsStale_ {false};
+};
+}  // namespace BackgroundTaskMgr
+}  // namespace OHOS
+#endif  // FOUNDATION_RESOURCESCHEDULE_BACKGROUND_TASK_MGR_SERVICES_COMMON_INCLUDE_SUBSCRIBER_REGISTRY_H
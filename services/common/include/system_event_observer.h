@@ -36,6 +36,7 @@ public:
     bool Unsubscribe();
 
 private:
+    void OnReceiveEventBundleInfoCache(const EventFwk::CommonEventData &eventData);
     void OnReceiveEventContinuousTask(const EventFwk::CommonEventData &eventData);
     void OnReceiveEventEfficiencyRes(const EventFwk::CommonEventData &eventData);
 
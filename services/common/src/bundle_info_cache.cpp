@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "bundle_info_cache.h"
+
+#include "bgtask_hitrace_chain.h"
+#include "bundle_manager_helper.h"
+#include "continuous_task_log.h"
+
+namespace OHOS {
+namespace BackgroundTaskMgr {
+namespace {
+constexpr size_t MAX_BUNDLE_METADATA_CACHE = 128;
+constexpr size_t MAX_APP_LABEL_CACHE = 128;
+constexpr size_t MAX_BUNDLE_NAME_CACHE = 256;
+constexpr uint32_t INVALID_BGMODE = 0;
+}
+
+BundleInfoCache::BundleInfoCache() : metadataCache_(MAX_BUNDLE_METADATA_CACHE), appLabelCache_(MAX_APP_LABEL_CACHE),
+    bundleNameCache_(MAX_BUNDLE_NAME_CACHE) {}
+
+BundleInfoCache::~BundleInfoCache() {}
+
+bool BundleInfoCache::GetBundleMetadata(const std::string &bundleName, int32_t userId, BundleMetadata &metadata)
+{
+    uint64_t generation = 0;
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex_);
+        auto iter = metadataCache_.find(std::make_pair(bundleName, userId));
+        if (iter != metadataCache_.end()) {
+            metadata = iter->second;
+            return true;
+        }
+        generation = generation_;
+    }
+    // 不持锁访问 BMS，期间收到包变更事件则本次结果不写入缓存
+    if (!FetchBundleMetadata(bundleName, userId, metadata)) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    if (generation == generation_) {
+        metadataCache_.emplace(std::make_pair(bundleName, userId), metadata);
+    }
+    return true;
+}
+
+bool BundleInfoCache::FetchBundleMetadata(const std::string &bundleName, int32_t userId, BundleMetadata &metadata)
+{
+    BgTaskHiTraceChain traceChain(__func__);
+    AppExecFwk::BundleInfo bundleInfo;
+    int32_t flag = static_cast<int32_t>(AppExecFwk::BundleFlag::GET_BUNDLE_WITH_ABILITIES) |
+        static_cast<int32_t>(AppExecFwk::BundleFlag::GET_BUNDLE_WITH_REQUESTED_PERMISSION);
+    if (!BundleManagerHelper::GetInstance()->GetBundleInfoByFlags(bundleName, flag, bundleInfo, userId)) {
+        BGTASK_LOGE("get bundle info: %{public}s failure!", bundleName.c_str());
+        return false;
+    }
+    metadata.bundleName = bundleName;
+    metadata.userId = userId;
+    metadata.appIndex = bundleInfo.appIndex;
+    metadata.isSystemApp = bundleInfo.applicationInfo.isSystemApp;
+    metadata.appId = bundleInfo.appId;
+    metadata.appIdentifier = bundleInfo.signatureInfo.appIdentifier;
+    metadata.reqPermissions = bundleInfo.reqPermissions;
+    metadata.abilityBgModes.clear();
+    for (const auto &abilityInfo : bundleInfo.abilityInfos) {
+        if (abilityInfo.backgroundModes != INVALID_BGMODE) {
+            metadata.abilityBgModes.emplace(abilityInfo.name, abilityInfo.backgroundModes);
+        }
+    }
+    return true;
+}
+
+std::string BundleInfoCache::GetAppLabel(const std::string &bundleName)
+{
+    uint64_t generation = 0;
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex_);
+        auto iter = appLabelCache_.find(bundleName);
+        if (iter != appLabelCache_.end()) {
+            return iter->second;
+        }
+        generation = generation_;
+    }
+    BgTaskHiTraceChain traceChain(__func__);
+    AppExecFwk::BundleResourceInfo bundleResourceInfo;
+    if (!BundleManagerHelper::GetInstance()->GetBundleResourceInfo(bundleName,
+        AppExecFwk::ResourceFlag::GET_RESOURCE_INFO_ALL, bundleResourceInfo)) {
+        return "";
+    }
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    if (generation == generation_) {
+        appLabelCache_.emplace(bundleName, bundleResourceInfo.label);
+    }
+    return bundleResourceInfo.label;
+}
+
+bool BundleInfoCache::GetBundleNameForUid(int32_t uid, std::string &bundleName)
+{
+    uint64_t generation = 0;
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex_);
+        auto iter = bundleNameCache_.find(uid);
+        if (iter != bundleNameCache_.end()) {
+            bundleName = iter->second;
+            return true;
+        }
+        generation = generation_;
+    }
+    if (!BundleManagerHelper::GetInstance()->GetBundleNameForUid(uid, bundleName)) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    if (generation == generation_) {
+        bundleNameCache_.emplace(uid, bundleName);
+    }
+    return true;
+}
+
+void BundleInfoCache::Prefetch(const std::string &bundleName, int32_t userId)
+{
+    if (bundleName.empty()) {
+        return;
+    }
+    BundleMetadata metadata;
+    GetBundleMetadata(bundleName, userId, metadata);
+    GetAppLabel(bundleName);
+}
+
+void BundleInfoCache::InvalidateBundle(const std::string &bundleName, int32_t userId)
+{
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    generation_++;
+    if (userId >= 0) {
+        metadataCache_.erase(std::make_pair(bundleName, userId));
+    } else {
+        metadataCache_.erase_if([&bundleName](const auto &entry) { return entry.first.first == bundleName; });
+    }
+    appLabelCache_.erase(bundleName);
+    // 卸载后 uid 可能被重新分配，该包所有用户的 uid 均失效
+    bundleNameCache_.erase_if([&bundleName](const auto &entry) { return entry.second == bundleName; });
+}
+
+void BundleInfoCache::InvalidateAppLabels()
+{
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    generation_++;
+    appLabelCache_.clear();
+}
+
+void BundleInfoCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    generation_++;
+    metadataCache_.clear();
+    appLabelCache_.clear();
+    bundleNameCache_.clear();
+}
+
+size_t BundleInfoCache::GetMetadataCount()
+{
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    return metadataCache_.size();
+}
+
+size_t BundleInfoCache::GetAppLabelCount()
+{
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    return appLabelCache_.size();
+}
+
+size_t BundleInfoCache::GetBundleNameCount()
+{
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    return bundleNameCache_.size();
+}
+}  // namespace BackgroundTaskMgr
+}  // namespace OHOS
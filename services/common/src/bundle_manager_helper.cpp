@@ -20,6 +20,7 @@
 #include "system_ability_definition.h"
 #include "tokenid_kit.h"
 
+#include "bundle_info_cache.h"
 #include "continuous_task_log.h"
 
 namespace OHOS {
@@ -56,6 +57,21 @@ std::string BundleManagerHelper::GetClientBundleName(int32_t uid)
     return bundle;
 }
 
+bool BundleManagerHelper::GetBundleNameForUid(int32_t uid, std::string &bundleName)
+{
+    std::lock_guard<std::mutex> lock(connectionMutex_);
+    Connect();
+    if (bundleMgr_ == nullptr) {
+        BGTASK_LOGE("Bundle mgr proxy is nullptr");
+        return false;
+    }
+    if (bundleMgr_->GetNameForUid(uid, bundleName) != ERR_OK) {
+        BGTASK_LOGE("Get bundle name failed, uid: %{public}d", uid);
+        return false;
+    }
+    return true;
+}
+
 bool BundleManagerHelper::CheckPermission(const std::string &permission)
 {
     Security::AccessToken::AccessTokenID callerToken = IPCSkeleton::GetCallingTokenID();
@@ -206,8 +222,12 @@ void BundleManagerHelper::Disconnect()
 
 void BundleManagerHelper::OnRemoteDied(const wptr<IRemoteObject> &object)
 {
-    std::lock_guard<std::mutex> lock(connectionMutex_);
-    Disconnect();
+    {
+        std::lock_guard<std::mutex> lock(connectionMutex_);
+        Disconnect();
+    }
+    // 包管理服务重启期间的包变更事件可能丢失，缓存的包信息全部失效
+    DelayedSingleton<BundleInfoCache>::GetInstance()->Clear();
 }
 }  // namespace BackgroundTaskMgr
 }  // namespace OHOS
\ No newline at end of file
@@ -14,12 +14,16 @@
  */
 #include "data_storage_helper.h"
 
+#include <algorithm>
+#include <cinttypes>
+#include <cstdlib>
+#include <cstring>
 #include <fcntl.h>
 #include <file_ex.h>
-#include <fstream>
 #include <unistd.h>
 #include <securec.h>
 #include <sstream>
+#include <sys/mman.h>
 #include <sys/sendfile.h>
 #include <sys/stat.h>
 #include <sys/statfs.h>
@@ -29,16 +33,38 @@
 #include "config_policy_utils.h"
 #include "directory_ex.h"
 #include "hisysevent.h"
+#include "parameters.h"
+#include "record_snapshot.h"
+#include "time_provider.h"
 
 namespace OHOS {
 namespace BackgroundTaskMgr {
 namespace {
 static constexpr char TASK_RECORD_FILE_PATH[] = "/data/service/el1/public/background_task_mgr/running_task";
+static constexpr char TASK_JOURNAL_FILE_PATH[] = "/data/service/el1/public/background_task_mgr/running_task_journal";
 static const std::string RESOURCE_RECORD_FILE_PATH = "/data/service/el1/public/background_task_mgr/resource_record";
+static constexpr char TASK_RECORD_SNAPSHOT_PATH[] = "/data/service/el1/public/background_task_mgr/running_task.bin";
+static const std::string RESOURCE_RECORD_SNAPSHOT_PATH =
+    "/data/service/el1/public/background_task_mgr/resource_record.bin";
 static constexpr char AUTH_RECORD_FILE_PATH[] = "/data/service/el1/public/background_task_mgr/auth_record";
+static constexpr char TASK_RECORD_MANIFEST_PATH[] =
+    "/data/service/el1/public/background_task_mgr/running_task.manifest";
+static constexpr char AUTH_RECORD_MANIFEST_PATH[] =
+    "/data/service/el1/public/background_task_mgr/auth_record.manifest";
+static constexpr char SNAPSHOT_SUFFIX[] = ".bin";
+static constexpr char TMP_FILE_SUFFIX[] = ".tmp";
+static constexpr char MANIFEST_VERSION[] = "version";
+static constexpr char MANIFEST_USERS[] = "users";
+constexpr int32_t MANIFEST_VERSION_VALUE = 1;
 static const std::string APP_RESOURCE_RECORD = "appResourceRecord";
 static const std::string PROCESS_RESOURCE_RECORD = "processResourceRecord";
 static const std::string AUTH_RECORD = "authRecord";
+static constexpr char JOURNAL_OP[] = "op";
+static constexpr char JOURNAL_KEY[] = "key";
+static constexpr char JOURNAL_VALUE[] = "value";
+constexpr int32_t JOURNAL_OP_UPSERT = 0;
+constexpr int32_t JOURNAL_OP_DELETE = 1;
+constexpr int32_t MAX_TASK_JOURNAL_ENTRIES = 100; // 日志条目超过该值后触发合并
 const std::string PARAM = "param";
 const std::string FAST_FROZEN = "fast_frozen";
 const std::string ENABLE = "enable";
@@ -46,72 +72,286 @@ const std::string DOZE_TIME = "doze_time";
 constexpr int32_t EXTENSION_SUCCESS_CODE = 0;
 constexpr int32_t EXTENSION_ERROR_CODE = 13500099;
 constexpr int32_t MAX_AUTH_RECORD_SIZE = 400 * 1000; // 单个应用授权记录数据大小为400
+static constexpr char PERSIST_RUNNER_NAME[] = "BgTaskPersistence";
+static constexpr char PERSIST_WINDOW_PARAM[] = "persist.sys.bgtask_persist_window";
+static constexpr char TASK_FLUSH_PENDING_RECORD[] = "TaskFlushPendingRecord";
+constexpr int32_t PERSIST_WINDOW_DEFAULT = 200; // 写盘合并窗口, 单位ms, 小于等于0时同步写盘
+constexpr int32_t MAX_FLUSH_RETRY = 5; // 落盘失败后按指数退避重试的次数
+constexpr int64_t MAX_FLUSH_RETRY_DELAY = 30 * MSEC_PER_SEC;
+static constexpr char BINARY_SNAPSHOT_PARAM[] = "persist.sys.bgtask_binary_snapshot";
+static constexpr char TASK_SAMPLE_USER_DATA_SIZE[] = "TaskSampleUserDataSize";
+static constexpr char USER_DATA_FOLDER_PATH[] = "/data/service/el1/public/background_task_mgr/";
+constexpr int64_t USER_DATA_SIZE_SAMPLE_INTERVAL = 10 * MSEC_PER_MIN; // 落盘后最多每10分钟采样一次目录大小
+constexpr int64_t USER_DATA_SIZE_REPORT_INTERVAL = MSEC_PER_DAY; // 大小无明显变化时每天最多上报一次
+constexpr int64_t USER_DATA_SIZE_THRESHOLD = 1024 * 1024; // 目录大小变化超过1MB时上报
+constexpr uint32_t SECTION_TASK_RECORD = 0;
+constexpr uint32_t SECTION_APP_RESOURCE_RECORD = 0;
+constexpr uint32_t SECTION_PROCESS_RESOURCE_RECORD = 1;
+constexpr int32_t RECORD_DEPTH = 1;
+constexpr int32_t RESOURCE_RECORD_DEPTH = 2;
+
+std::string GetShardFilePath(const std::string &basePath, int32_t userId)
+{
+    return basePath + "." + std::to_string(userId);
 }
 
-DataStorageHelper::DataStorageHelper() {}
+bool IsTaskSnapshotFile(const std::string &filePath)
+{
+    // 分片文件及清单均以 running_task. 为前缀, 增量日志文件除外
+    return filePath.rfind(std::string(TASK_RECORD_FILE_PATH) + ".", 0) == 0;
+}
+
+bool IsBinarySnapshotFile(const std::string &filePath)
+{
+    size_t suffixLen = strlen(SNAPSHOT_SUFFIX);
+    return filePath.size() > suffixLen &&
+        filePath.compare(filePath.size() - suffixLen, suffixLen, SNAPSHOT_SUFFIX) == 0;
+}
+
+uint32_t GetRecordSection(const std::string &name)
+{
+    return name == PROCESS_RESOURCE_RECORD ? SECTION_PROCESS_RESOURCE_RECORD : SECTION_APP_RESOURCE_RECORD;
+}
+
+// 同一份记录只保留一种格式，返回另一种格式的文件路径
+std::string GetStaleRecordFile(const std::string &filePath)
+{
+    if (IsBinarySnapshotFile(filePath)) {
+        return filePath.substr(0, filePath.size() - strlen(SNAPSHOT_SUFFIX));
+    }
+    if ((IsTaskSnapshotFile(filePath) && filePath != TASK_RECORD_MANIFEST_PATH) ||
+        filePath == RESOURCE_RECORD_FILE_PATH) {
+        return filePath + SNAPSHOT_SUFFIX;
+    }
+    return "";
+}
+}
+
+DataStorageHelper::DataStorageHelper()
+{
+    writeBehindWindow_ = OHOS::system::GetIntParameter(PERSIST_WINDOW_PARAM, PERSIST_WINDOW_DEFAULT);
+    binarySnapshot_ = OHOS::system::GetBoolParameter(BINARY_SNAPSHOT_PARAM, false);
+    auto runner = AppExecFwk::EventRunner::Create(PERSIST_RUNNER_NAME);
+    persistHandler_ = std::make_shared<AppExecFwk::EventHandler>(runner);
+}
 
 DataStorageHelper::~DataStorageHelper() {}
 
 ErrCode DataStorageHelper::RefreshTaskRecord(const std::unordered_map<std::string,
     std::shared_ptr<ContinuousTaskRecord>> &allRecord)
 {
-    nlohmann::json root;
+    // 按用户分片，切换或删除用户时内容未变化的分片不会重写
+    std::map<int32_t, std::unordered_map<std::string, std::shared_ptr<ContinuousTaskRecord>>> shards;
     for (const auto &iter : allRecord) {
-        auto record = iter.second;
-        std::string data = record->ParseToJsonStr();
-        nlohmann::json recordJson = nlohmann::json::parse(data, nullptr, false);;
-        if (!recordJson.is_discarded()) {
-            root[iter.first] = recordJson;
+        shards[iter.second->GetUserId()].emplace(iter.first, iter.second);
+    }
+    std::map<std::string, std::string> records;
+    std::set<int32_t> users;
+    for (const auto &shard : shards) {
+        std::string shardPath = GetShardFilePath(TASK_RECORD_FILE_PATH, shard.first);
+        if (binarySnapshot_) {
+            shardPath += SNAPSHOT_SUFFIX;
         }
+        records[shardPath] = ConvertTaskRecordToString(shard.second);
+        users.emplace(shard.first);
     }
-    if (access(TASK_RECORD_FILE_PATH, F_OK) == ERR_OK) {
-        BGTASK_LOGD("the file: %{private}s already exists.", TASK_RECORD_FILE_PATH);
-    } else {
-        FILE *file = fopen(TASK_RECORD_FILE_PATH, "w+");
-        if (file == nullptr) {
-            BGTASK_LOGE("Fail to open file: %{private}s, errno: %{public}s", TASK_RECORD_FILE_PATH, strerror(errno));
-            return ERR_BGTASK_CREATE_FILE_ERR;
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex_);
+        StageShardRecord(records, users, TASK_RECORD_FILE_PATH, TASK_RECORD_MANIFEST_PATH, taskShardUsers_);
+        // 旧版本未分片的快照已被分片替代
+        pendingRemovals_.insert(TASK_RECORD_FILE_PATH);
+        pendingRemovals_.insert(TASK_RECORD_SNAPSHOT_PATH);
+        // 全量快照覆盖之前所有未落盘的增量日志
+        pendingTaskJournal_.clear();
+        taskJournalEntries_ = 0;
+    }
+    return SchedulePendingRecord();
+}
+
+ErrCode DataStorageHelper::AppendTaskRecord(const std::string &key,
+    const std::shared_ptr<ContinuousTaskRecord> &record)
+{
+    return AppendTaskRecords({{key, record}});
+}
+
+ErrCode DataStorageHelper::AppendTaskRecords(
+    const std::vector<std::pair<std::string, std::shared_ptr<ContinuousTaskRecord>>> &records)
+{
+    if (records.empty()) {
+        return ERR_OK;
+    }
+    std::string journal;
+    for (const auto &item : records) {
+        nlohmann::json entry;
+        entry[JOURNAL_KEY] = item.first;
+        if (item.second == nullptr) {
+            entry[JOURNAL_OP] = JOURNAL_OP_DELETE;
+        } else {
+            entry[JOURNAL_OP] = JOURNAL_OP_UPSERT;
+            item.second->ParseToJson(entry[JOURNAL_VALUE]);
         }
-        int closeResult = fclose(file);
-        if (closeResult < 0) {
-            BGTASK_LOGE("Fail to close file: %{private}s, errno: %{public}s", TASK_RECORD_FILE_PATH, strerror(errno));
-            return ERR_BGTASK_CREATE_FILE_ERR;
+        // 每条日志占一行，恢复时逐行回放
+        journal.append(entry.dump()).append("\n");
+    }
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex_);
+        pendingTaskJournal_.append(journal);
+        taskJournalEntries_ += static_cast<int32_t>(records.size());
+    }
+    return SchedulePendingRecord();
+}
+
+std::string DataStorageHelper::ConvertTaskRecordToString(const std::unordered_map<std::string,
+    std::shared_ptr<ContinuousTaskRecord>> &allRecord)
+{
+    if (binarySnapshot_) {
+        RecordSnapshot snapshot;
+        for (const auto &iter : allRecord) {
+            nlohmann::json value;
+            iter.second->ParseToJson(value);
+            snapshot.Append(SECTION_TASK_RECORD, iter.first, value);
+        }
+        return snapshot.Finish();
+    }
+    nlohmann::json root;
+    for (const auto &iter : allRecord) {
+        // 直接序列化到目标节点，避免中间字符串及二次解析
+        iter.second->ParseToJson(root[iter.first]);
+    }
+    return root.dump(CommonUtils::jsonFormat_);
+}
+
+void DataStorageHelper::StageShardRecord(std::map<std::string, std::string> &records, const std::set<int32_t> &users,
+    const std::string &basePath, const std::string &manifestPath, std::set<int32_t> &stagedUsers)
+{
+    for (auto userId : stagedUsers) {
+        if (users.find(userId) != users.end()) {
+            continue;
+        }
+        std::string shardPath = GetShardFilePath(basePath, userId);
+        for (const auto &path : { shardPath, shardPath + SNAPSHOT_SUFFIX }) {
+            pendingRecords_.erase(path);
+            pendingRemovals_.insert(path);
+        }
+    }
+    stagedUsers = users;
+    nlohmann::json manifest;
+    manifest[MANIFEST_VERSION] = MANIFEST_VERSION_VALUE;
+    manifest[MANIFEST_USERS] = users;
+    records[manifestPath] = manifest.dump(CommonUtils::jsonFormat_);
+    for (auto &iter : records) {
+        pendingRemovals_.erase(iter.first);
+        pendingRecords_[iter.first] = std::move(iter.second);
+    }
+}
+
+bool DataStorageHelper::LoadShardManifest(const std::string &manifestPath, std::set<int32_t> &users)
+{
+    nlohmann::json manifest;
+    if (ParseJsonValueFromFile(manifest, manifestPath) != ERR_OK || !manifest.is_object() ||
+        !CommonUtils::CheckJsonValue(manifest, { MANIFEST_USERS }) || !manifest[MANIFEST_USERS].is_array()) {
+        return false;
+    }
+    for (const auto &userId : manifest[MANIFEST_USERS]) {
+        if (userId.is_number_integer()) {
+            users.emplace(userId.get<int32_t>());
         }
     }
-    return SaveJsonValueToFile(root.dump(CommonUtils::jsonFormat_), TASK_RECORD_FILE_PATH);
+    return true;
+}
+
+bool DataStorageHelper::NeedCompactTaskRecord()
+{
+    std::lock_guard<std::mutex> lock(pendingMutex_);
+    return taskJournalEntries_ >= MAX_TASK_JOURNAL_ENTRIES;
 }
 
 ErrCode DataStorageHelper::RestoreTaskRecord(std::unordered_map<std::string,
     std::shared_ptr<ContinuousTaskRecord>> &allRecord)
 {
-    nlohmann::json root;
-    if (ParseJsonValueFromFile(root, TASK_RECORD_FILE_PATH) != ERR_OK) {
+    FlushPendingRecord();
+    std::lock_guard<std::mutex> lock(fileMutex_);
+    auto visitor = [&allRecord](uint32_t, const std::string &key, const nlohmann::json &value) {
+        std::shared_ptr<ContinuousTaskRecord> record = std::make_shared<ContinuousTaskRecord>();
+        if (record->ParseFromJson(value)) {
+            allRecord.emplace(key, record);
+        }
+    };
+    std::set<int32_t> users;
+    bool hasSnapshot = LoadShardManifest(TASK_RECORD_MANIFEST_PATH, users);
+    for (auto userId : users) {
+        // 优先读取二进制快照，不存在时从json文件导入
+        std::string shardPath = GetShardFilePath(TASK_RECORD_FILE_PATH, userId);
+        if (!LoadRecordSnapshot(shardPath + SNAPSHOT_SUFFIX, visitor)) {
+            StreamJsonRecordsFromFile(shardPath, RECORD_DEPTH, nullptr, visitor);
+        }
+    }
+    // 兼容未分片的旧版本快照
+    bool hasLegacySnapshot = LoadRecordSnapshot(TASK_RECORD_SNAPSHOT_PATH, visitor) ||
+        StreamJsonRecordsFromFile(TASK_RECORD_FILE_PATH, RECORD_DEPTH, nullptr, visitor) == ERR_OK;
+    hasSnapshot = hasSnapshot || hasLegacySnapshot;
+    int32_t entries = ReplayTaskJournal(allRecord);
+    {
+        std::lock_guard<std::mutex> pendingLock(pendingMutex_);
+        taskJournalEntries_ = entries;
+        taskShardUsers_ = users;
+    }
+    if (!hasSnapshot && entries == 0) {
         return ERR_BGTASK_DATA_STORAGE_ERR;
     }
-    for (auto iter = root.begin(); iter != root.end(); iter++) {
-        nlohmann::json recordJson = iter.value();
+    return ERR_OK;
+}
+
+int32_t DataStorageHelper::ReplayTaskJournal(std::unordered_map<std::string,
+    std::shared_ptr<ContinuousTaskRecord>> &allRecord)
+{
+    std::string realPath;
+    if (!ConvertFullPath(TASK_JOURNAL_FILE_PATH, realPath)) {
+        return 0;
+    }
+    std::string data;
+    LoadStringFromFile(realPath.c_str(), data);
+    std::istringstream stream(data);
+    std::string line;
+    int32_t entries = 0;
+    while (std::getline(stream, line)) {
+        if (line.empty()) {
+            continue;
+        }
+        // 写入中断时最后一行可能不完整，直接跳过
+        nlohmann::json entry = nlohmann::json::parse(line, nullptr, false);
+        if (entry.is_discarded() || !entry.is_object() || !CommonUtils::CheckJsonValue(entry, {JOURNAL_OP, JOURNAL_KEY})
+            || !entry[JOURNAL_OP].is_number_integer() || !entry[JOURNAL_KEY].is_string()) {
+            BGTASK_LOGW("skip invalid task journal entry");
+            continue;
+        }
+        entries++;
+        std::string key = entry[JOURNAL_KEY].get<std::string>();
+        if (entry[JOURNAL_OP].get<int32_t>() == JOURNAL_OP_DELETE) {
+            allRecord.erase(key);
+            continue;
+        }
+        if (!entry.contains(JOURNAL_VALUE)) {
+            continue;
+        }
         std::shared_ptr<ContinuousTaskRecord> record = std::make_shared<ContinuousTaskRecord>();
-        if (record->ParseFromJson(recordJson)) {
-            allRecord.emplace(iter.key(), record);
+        if (record->ParseFromJson(entry[JOURNAL_VALUE])) {
+            allRecord[key] = record;
         }
     }
-    return ERR_OK;
+    return entries;
 }
 
 ErrCode DataStorageHelper::RestoreAuthRecord(std::unordered_map<std::string,
     std::shared_ptr<BannerNotificationRecord>> &authRecord)
 {
-    nlohmann::json root;
     BGTASK_LOGI("RestoreAuthRecord start");
-    if (ParseJsonValueFromFile(root, AUTH_RECORD_FILE_PATH) != ERR_OK) {
-        BGTASK_LOGE("bannerNotification parse json value from file fail.");
-        return ERR_BGTASK_DATA_STORAGE_ERR;
-    }
-    for (auto iter = root.begin(); iter != root.end(); iter++) {
-        nlohmann::json recordJson = iter.value();
+    FlushPendingRecord();
+    std::lock_guard<std::mutex> lock(fileMutex_);
+    auto visitor = [&authRecord](uint32_t, const std::string &key, const nlohmann::json &value) {
         std::shared_ptr<BannerNotificationRecord> record = std::make_shared<BannerNotificationRecord>();
-        if (!record->ParseFromJson(recordJson)) {
-            continue;
+        if (!record->ParseFromJson(value)) {
+            return;
         }
         auto findRecord = [record](const auto &iter) {
             auto oldRecord = iter.second;
@@ -121,8 +361,24 @@ ErrCode DataStorageHelper::RestoreAuthRecord(std::unordered_map<std::string,
         };
         auto findRecordIter = find_if(authRecord.begin(), authRecord.end(), findRecord);
         if (findRecordIter == authRecord.end()) {
-            authRecord.emplace(iter.key(), record);
+            authRecord.emplace(key, record);
         }
+    };
+    std::set<int32_t> users;
+    bool hasManifest = LoadShardManifest(AUTH_RECORD_MANIFEST_PATH, users);
+    for (auto userId : users) {
+        StreamJsonRecordsFromFile(GetShardFilePath(AUTH_RECORD_FILE_PATH, userId), RECORD_DEPTH, nullptr, visitor);
+    }
+    {
+        std::lock_guard<std::mutex> pendingLock(pendingMutex_);
+        authShardUsers_ = users;
+    }
+    // 未分片的授权记录来自旧版本或备份恢复
+    bool hasLegacyRecord =
+        StreamJsonRecordsFromFile(AUTH_RECORD_FILE_PATH, RECORD_DEPTH, nullptr, visitor) == ERR_OK;
+    if (!hasManifest && !hasLegacyRecord) {
+        BGTASK_LOGE("bannerNotification parse json value from file fail.");
+        return ERR_BGTASK_DATA_STORAGE_ERR;
     }
     return ERR_OK;
 }
@@ -130,58 +386,239 @@ ErrCode DataStorageHelper::RestoreAuthRecord(std::unordered_map<std::string,
 ErrCode DataStorageHelper::RefreshResourceRecord(const ResourceRecordMap &appRecord,
     const ResourceRecordMap &processRecord)
 {
+    std::string filePath = RESOURCE_RECORD_FILE_PATH;
     std::string record {""};
-    ConvertMapToString(appRecord, processRecord, record);
-    if (access(RESOURCE_RECORD_FILE_PATH.c_str(), F_OK) == ERR_OK) {
-        BGTASK_LOGD("the file: %{private}s already exists.", RESOURCE_RECORD_FILE_PATH.c_str());
+    if (binarySnapshot_) {
+        RecordSnapshot snapshot;
+        ConvertMapToSnapshot(appRecord, SECTION_APP_RESOURCE_RECORD, snapshot);
+        ConvertMapToSnapshot(processRecord, SECTION_PROCESS_RESOURCE_RECORD, snapshot);
+        filePath = RESOURCE_RECORD_SNAPSHOT_PATH;
+        record = snapshot.Finish();
     } else {
-        FILE *file = fopen(RESOURCE_RECORD_FILE_PATH.c_str(), "w+");
-        if (file == nullptr) {
-            BGTASK_LOGE("Fail to open file: %{private}s, errno: %{public}s",
-                RESOURCE_RECORD_FILE_PATH.c_str(), strerror(errno));
-            return ERR_BGTASK_CREATE_FILE_ERR;
-        }
-        int closeResult = fclose(file);
-        if (closeResult < 0) {
-            BGTASK_LOGE("Fail to close file: %{private}s, errno: %{public}s",
-                RESOURCE_RECORD_FILE_PATH.c_str(), strerror(errno));
-            return ERR_BGTASK_CREATE_FILE_ERR;
-        }
+        ConvertMapToString(appRecord, processRecord, record);
+    }
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex_);
+        pendingRecords_[filePath] = std::move(record);
     }
-    return SaveJsonValueToFile(record, RESOURCE_RECORD_FILE_PATH);
+    return SchedulePendingRecord();
 }
 
 ErrCode DataStorageHelper::RefreshAuthRecord(
     const std::unordered_map<std::string, std::shared_ptr<BannerNotificationRecord>> &authRecord)
 {
-    nlohmann::json root;
+    std::map<int32_t, nlohmann::json> shards;
     for (const auto &iter : authRecord) {
-        auto record = iter.second;
-        std::string data = record->ParseToJsonStr();
-        nlohmann::json recordJson = nlohmann::json::parse(data, nullptr, false);;
-        if (!recordJson.is_discarded()) {
-            root[iter.first] = recordJson;
+        // 直接序列化到目标节点，避免中间字符串及二次解析
+        iter.second->ParseToJson(shards[iter.second->GetUserId()][iter.first]);
+    }
+    std::map<std::string, std::string> records;
+    std::set<int32_t> users;
+    for (const auto &shard : shards) {
+        records[GetShardFilePath(AUTH_RECORD_FILE_PATH, shard.first)] = shard.second.dump(CommonUtils::jsonFormat_);
+        users.emplace(shard.first);
+    }
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex_);
+        StageShardRecord(records, users, AUTH_RECORD_FILE_PATH, AUTH_RECORD_MANIFEST_PATH, authShardUsers_);
+        pendingRemovals_.insert(AUTH_RECORD_FILE_PATH);
+    }
+    return SchedulePendingRecord();
+}
+
+ErrCode DataStorageHelper::SchedulePendingRecord()
+{
+    if (persistHandler_ == nullptr || writeBehindWindow_ <= 0) {
+        return FlushPendingRecord();
+    }
+    ErrCode lastResult = ERR_OK;
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex_);
+        // 上次落盘失败且尚未恢复时返回错误，调用方可改为写全量快照
+        lastResult = lastFlushResult_;
+        if (isFlushScheduled_) {
+            return lastResult;
+        }
+        isFlushScheduled_ = true;
+    }
+    // 窗口期内的多次刷新合并为一次落盘
+    if (!PostFlushTask(writeBehindWindow_)) {
+        BGTASK_LOGW("post flush task failed, flush directly");
+        return FlushPendingRecord();
+    }
+    return lastResult;
+}
+
+bool DataStorageHelper::PostFlushTask(int64_t delayMs)
+{
+    auto task = []() {
+        DelayedSingleton<DataStorageHelper>::GetInstance()->FlushPendingRecord();
+    };
+    return persistHandler_->PostTask(task, TASK_FLUSH_PENDING_RECORD, delayMs);
+}
+
+ErrCode DataStorageHelper::FlushPendingRecord()
+{
+    std::map<std::string, std::string> pendingRecords;
+    std::set<std::string> pendingRemovals;
+    std::string pendingTaskJournal;
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex_);
+        isFlushScheduled_ = false;
+        pendingRecords.swap(pendingRecords_);
+        pendingRemovals.swap(pendingRemovals_);
+        pendingTaskJournal.swap(pendingTaskJournal_);
+    }
+    std::lock_guard<std::mutex> lock(fileMutex_);
+    ErrCode result = ERR_OK;
+    bool hasTaskSnapshot = false;
+    std::map<std::string, std::string> failedRecords;
+    for (auto &iter : pendingRecords) {
+        hasTaskSnapshot = hasTaskSnapshot || IsTaskSnapshotFile(iter.first);
+        // 仅比较长度和哈希判断内容未变, 不常驻已落盘的完整内容
+        std::pair<size_t, size_t> digest {iter.second.size(), std::hash<std::string> {}(iter.second)};
+        auto writtenIter = writtenRecords_.find(iter.first);
+        if (writtenIter != writtenRecords_.end() && writtenIter->second == digest &&
+            access(iter.first.c_str(), F_OK) == ERR_OK) {
+            continue;
+        }
+        ErrCode ret = WriteRecordFile(iter.second, iter.first);
+        if (ret != ERR_OK) {
+            BGTASK_LOGE("write record file: %{private}s failed, ret: %{public}d", iter.first.c_str(), ret);
+            writtenRecords_.erase(iter.first);
+            failedRecords.emplace(iter.first, std::move(iter.second));
+            result = ret;
+            continue;
+        }
+        writtenRecords_[iter.first] = digest;
+    }
+    // 新的分片全部落盘后才删除失效的分片和旧版本文件，否则留待下次落盘
+    if (result != ERR_OK) {
+        std::lock_guard<std::mutex> pendingLock(pendingMutex_);
+        for (const auto &path : pendingRemovals) {
+            if (pendingRecords_.find(path) == pendingRecords_.end()) {
+                pendingRemovals_.insert(path);
+            }
         }
+        pendingRemovals.clear();
     }
-    if (access(AUTH_RECORD_FILE_PATH, F_OK) == ERR_OK) {
-        BGTASK_LOGD("the file: %{private}s already exists.", AUTH_RECORD_FILE_PATH);
+    for (const auto &path : pendingRemovals) {
+        writtenRecords_.erase(path);
+        if (access(path.c_str(), F_OK) == ERR_OK && unlink(path.c_str()) != 0) {
+            BGTASK_LOGW("Fail to remove file: %{private}s, errno: %{public}s", path.c_str(), strerror(errno));
+        }
+    }
+    // 全量快照落盘后，之前的增量日志已失效
+    if (hasTaskSnapshot && result == ERR_OK && access(TASK_JOURNAL_FILE_PATH, F_OK) == ERR_OK &&
+        truncate(TASK_JOURNAL_FILE_PATH, 0) != 0) {
+        BGTASK_LOGE("Fail to truncate file: %{private}s, errno: %{public}s",
+            TASK_JOURNAL_FILE_PATH, strerror(errno));
+        result = ERR_BGTASK_DATA_STORAGE_ERR;
+    }
+    std::string failedJournal;
+    if (!pendingTaskJournal.empty()) {
+        ErrCode ret = AppendRecordFile(pendingTaskJournal, TASK_JOURNAL_FILE_PATH);
+        if (ret != ERR_OK) {
+            failedJournal.swap(pendingTaskJournal);
+            result = ret;
+        }
+    }
+    HandleFlushResult(result, failedRecords, failedJournal);
+    return result;
+}
+
+void DataStorageHelper::HandleFlushResult(ErrCode result, std::map<std::string, std::string> &failedRecords,
+    std::string &failedJournal)
+{
+    int64_t retryDelay = writeBehindWindow_ > 0 ? writeBehindWindow_ : PERSIST_WINDOW_DEFAULT;
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex_);
+        lastFlushResult_ = result;
+        if (result == ERR_OK) {
+            flushFailures_ = 0;
+            return;
+        }
+        // 写盘失败的数据放回待写队列，写盘期间又暂存了全量快照时旧的增量日志已被覆盖
+        if (!failedJournal.empty() && pendingRecords_.find(TASK_RECORD_MANIFEST_PATH) == pendingRecords_.end()) {
+            pendingTaskJournal_.insert(0, failedJournal);
+        }
+        // 写盘期间暂存了更新的数据时以新数据为准
+        for (auto &iter : failedRecords) {
+            if (pendingRecords_.find(iter.first) == pendingRecords_.end() &&
+                pendingRemovals_.find(iter.first) == pendingRemovals_.end()) {
+                pendingRecords_.emplace(iter.first, std::move(iter.second));
+            }
+        }
+        if (isFlushScheduled_ || persistHandler_ == nullptr) {
+            return;
+        }
+        if (flushFailures_ >= MAX_FLUSH_RETRY) {
+            BGTASK_LOGE("flush failed %{public}d times, wait for next refresh", flushFailures_);
+            return;
+        }
+        retryDelay = std::min(retryDelay << flushFailures_, MAX_FLUSH_RETRY_DELAY);
+        flushFailures_++;
+        isFlushScheduled_ = true;
+    }
+    BGTASK_LOGW("flush failed, ret: %{public}d, retry after %{public}" PRId64 " ms", result, retryDelay);
+    if (!PostFlushTask(retryDelay)) {
+        std::lock_guard<std::mutex> lock(pendingMutex_);
+        isFlushScheduled_ = false;
+    }
+}
+
+ErrCode DataStorageHelper::WriteRecordFile(const std::string &value, const std::string &filePath)
+{
+    if (access(filePath.c_str(), F_OK) == ERR_OK) {
+        BGTASK_LOGD("the file: %{private}s already exists.", filePath.c_str());
     } else {
-        FILE *file = fopen(AUTH_RECORD_FILE_PATH, "w+");
+        FILE *file = fopen(filePath.c_str(), "w+");
         if (file == nullptr) {
-            BGTASK_LOGE("Fail to open file: %{private}s, errno: %{public}s", AUTH_RECORD_FILE_PATH, strerror(errno));
+            BGTASK_LOGE("Fail to open file: %{private}s, errno: %{public}s", filePath.c_str(), strerror(errno));
             return ERR_BGTASK_CREATE_FILE_ERR;
         }
         int closeResult = fclose(file);
         if (closeResult < 0) {
-            BGTASK_LOGE("Fail to close file: %{private}s, errno: %{public}s", AUTH_RECORD_FILE_PATH, strerror(errno));
+            BGTASK_LOGE("Fail to close file: %{private}s, errno: %{public}s", filePath.c_str(), strerror(errno));
             return ERR_BGTASK_CREATE_FILE_ERR;
         }
     }
-    return SaveJsonValueToFile(root.dump(CommonUtils::jsonFormat_), AUTH_RECORD_FILE_PATH);
+    ErrCode ret = IsBinarySnapshotFile(filePath) ? SaveBinaryValueToFile(value, filePath) :
+        SaveJsonValueToFile(value, filePath);
+    if (ret != ERR_OK) {
+        return ret;
+    }
+    std::string staleFile = GetStaleRecordFile(filePath);
+    if (!staleFile.empty()) {
+        writtenRecords_.erase(staleFile);
+    }
+    if (!staleFile.empty() && access(staleFile.c_str(), F_OK) == ERR_OK && unlink(staleFile.c_str()) != 0) {
+        BGTASK_LOGW("Fail to remove file: %{private}s, errno: %{public}s", staleFile.c_str(), strerror(errno));
+    }
+    return ERR_OK;
+}
+
+ErrCode DataStorageHelper::AppendRecordFile(const std::string &value, const std::string &filePath)
+{
+    FILE *file = fopen(filePath.c_str(), "a");
+    if (file == nullptr) {
+        BGTASK_LOGE("Fail to open file: %{private}s, errno: %{public}s", filePath.c_str(), strerror(errno));
+        return ERR_BGTASK_CREATE_FILE_ERR;
+    }
+    size_t res = fwrite(value.c_str(), 1, value.length(), file);
+    int closeResult = fclose(file);
+    if (res != value.length() || closeResult < 0) {
+        BGTASK_LOGE("Fail to write file: %{private}s, errno: %{public}s", filePath.c_str(), strerror(errno));
+        return ERR_BGTASK_DATA_STORAGE_ERR;
+    }
+    return ERR_OK;
 }
 
 ErrCode DataStorageHelper::OnBackup(MessageParcel& data, MessageParcel& reply)
 {
+    // 备份前将未落盘的授权记录写入文件，并将各用户分片合并为备份文件
+    FlushPendingRecord();
+    MergeAuthRecordShards();
     std::string replyCode = SetReplyCode(EXTENSION_SUCCESS_CODE);
     FILE *file = nullptr;
     char tmpPath[PATH_MAX] = {0};
@@ -225,6 +662,7 @@ ErrCode DataStorageHelper::OnBackup(MessageParcel& data, MessageParcel& reply)
 ErrCode DataStorageHelper::OnRestore(MessageParcel& data, MessageParcel& reply,
     std::unordered_map<std::string, std::shared_ptr<BannerNotificationRecord>>& allRecord)
 {
+    FlushPendingRecord();
     std::string replyCode = SetReplyCode(EXTENSION_SUCCESS_CODE);
     UniqueFd srcFd(data.ReadFileDescriptor());
     bool getAuthRet = GetAuthRecord(srcFd);
@@ -239,10 +677,36 @@ ErrCode DataStorageHelper::OnRestore(MessageParcel& data, MessageParcel& reply,
     if (ret != ERR_OK) {
         return ret;
     }
+    // 恢复的记录重新按用户分片保存
+    RefreshAuthRecord(allRecord);
     BGTASK_LOGI("OnRestore success!");
     return ERR_OK;
 }
 
+ErrCode DataStorageHelper::MergeAuthRecordShards()
+{
+    std::lock_guard<std::mutex> lock(fileMutex_);
+    std::set<int32_t> users;
+    if (!LoadShardManifest(AUTH_RECORD_MANIFEST_PATH, users)) {
+        return ERR_OK;
+    }
+    nlohmann::json root;
+    if (ParseJsonValueFromFile(root, AUTH_RECORD_FILE_PATH) != ERR_OK || !root.is_object()) {
+        root = nlohmann::json::object();
+    }
+    for (auto userId : users) {
+        nlohmann::json shard;
+        if (ParseJsonValueFromFile(shard, GetShardFilePath(AUTH_RECORD_FILE_PATH, userId)) != ERR_OK ||
+            !shard.is_object()) {
+            continue;
+        }
+        for (auto iter = shard.begin(); iter != shard.end(); iter++) {
+            root[iter.key()] = iter.value();
+        }
+    }
+    return WriteRecordFile(root.dump(CommonUtils::jsonFormat_), AUTH_RECORD_FILE_PATH);
+}
+
 bool DataStorageHelper::GetAuthRecord(UniqueFd &fd)
 {
     struct stat statBuf;
@@ -262,6 +726,15 @@ bool DataStorageHelper::GetAuthRecord(UniqueFd &fd)
         BGTASK_LOGE("Read file failed, errno: %{public}s", strerror(errno));
         return false;
     }
+    // 授权记录按用户分片后，合并文件可能不存在
+    if (access(AUTH_RECORD_FILE_PATH, F_OK) != ERR_OK) {
+        FILE *newFile = fopen(AUTH_RECORD_FILE_PATH, "w+");
+        if (newFile == nullptr) {
+            BGTASK_LOGE("Fail to create file, errno: %{public}s", strerror(errno));
+            return false;
+        }
+        fclose(newFile);
+    }
     char tmpPath[PATH_MAX] = {0};
     if (realpath(AUTH_RECORD_FILE_PATH, tmpPath) == nullptr) {
         BGTASK_LOGE("realpath fail, errno: %{public}s", strerror(errno));
@@ -302,38 +775,168 @@ std::string DataStorageHelper::SetReplyCode(int32_t replyCode)
 }
 
 ErrCode DataStorageHelper::RestoreResourceRecord(ResourceRecordMap &appRecord,
-    ResourceRecordMap &processRecord)
+    ResourceRecordMap &processRecord, const ResourceRecordFilter &filter)
 {
-    nlohmann::json root;
-    if (ParseJsonValueFromFile(root, RESOURCE_RECORD_FILE_PATH) != ERR_OK) {
+    FlushPendingRecord();
+    std::lock_guard<std::mutex> lock(fileMutex_);
+    // 仅凭key即可判断的记录在解析前丢弃，无需构造记录对象
+    auto keyFilter = [&filter](uint32_t section, const std::string &key) {
+        return filter == nullptr ||
+            filter(section == SECTION_PROCESS_RESOURCE_RECORD, std::atoi(key.c_str()), nullptr);
+    };
+    auto visitor = [&appRecord, &processRecord, &filter, &keyFilter](uint32_t section, const std::string &key,
+        const nlohmann::json &value) {
+        if (!keyFilter(section, key)) {
+            return;
+        }
+        bool isProcess = section == SECTION_PROCESS_RESOURCE_RECORD;
+        int32_t mapKey = std::atoi(key.c_str());
+        std::shared_ptr<ResourceApplicationRecord> recordPtr = std::make_shared<ResourceApplicationRecord>();
+        recordPtr->ParseFromJson(value);
+        if (filter != nullptr && !filter(isProcess, mapKey, recordPtr)) {
+            return;
+        }
+        auto &recordMap = isProcess ? processRecord : appRecord;
+        recordMap.emplace(mapKey, recordPtr);
+    };
+    if (LoadRecordSnapshot(RESOURCE_RECORD_SNAPSHOT_PATH, visitor)) {
+        return ERR_OK;
+    }
+    if (StreamJsonRecordsFromFile(RESOURCE_RECORD_FILE_PATH, RESOURCE_RECORD_DEPTH, keyFilter, visitor) != ERR_OK) {
         BGTASK_LOGD("can not read string form file: %{private}s", RESOURCE_RECORD_FILE_PATH.c_str());
         return ERR_BGTASK_DATA_STORAGE_ERR;
     }
-    DivideJsonToMap(root, appRecord, processRecord);
+    return ERR_OK;
+}
+
+ErrCode DataStorageHelper::StreamJsonRecordsFromFile(const std::string &filePath, int32_t recordDepth,
+    const RecordKeyFilter &keyFilter, const RecordSnapshot::Visitor &visitor)
+{
+    std::string realPath;
+    if (!ConvertFullPath(filePath, realPath)) {
+        BGTASK_LOGE("Get real path failed");
+        return ERR_BGTASK_DATA_STORAGE_ERR;
+    }
+    std::string data;
+    LoadStringFromFile(realPath.c_str(), data);
+    uint32_t section = 0;
+    std::string recordKey;
+    // 逐条记录回调后立即丢弃，不在内存中构造整个文件的json对象
+    auto callback = [&](int32_t depth, nlohmann::json::parse_event_t event, nlohmann::json &parsed) {
+        if (event == nlohmann::json::parse_event_t::key) {
+            if (depth == recordDepth - 1) {
+                section = GetRecordSection(parsed.get<std::string>());
+            } else if (depth == recordDepth) {
+                recordKey = parsed.get<std::string>();
+                return keyFilter == nullptr || keyFilter(section, recordKey);
+            }
+            return true;
+        }
+        if (event == nlohmann::json::parse_event_t::object_end && depth == recordDepth) {
+            visitor(section, recordKey, parsed);
+            return false;
+        }
+        return true;
+    };
+    nlohmann::json root = nlohmann::json::parse(data, callback, false);
+    if (root.is_discarded()) {
+        BGTASK_LOGE("failed due to data is discarded");
+        return ERR_BGTASK_DATA_STORAGE_ERR;
+    }
     return ERR_OK;
 }
 
 int32_t DataStorageHelper::SaveJsonValueToFile(const std::string &value, const std::string &filePath)
 {
-    std::ofstream fout;
+    int32_t ret = ReplaceFileContent(value + "\n", filePath);
+    if (ret != ERR_OK) {
+        return ret;
+    }
+    if (IsTaskSnapshotFile(filePath)) {
+        ScheduleUserDataSizeSample();
+    }
+    return ERR_OK;
+}
+
+int32_t DataStorageHelper::SaveBinaryValueToFile(const std::string &value, const std::string &filePath)
+{
+    int32_t ret = ReplaceFileContent(value, filePath);
+    if (ret != ERR_OK) {
+        return ret;
+    }
+    if (IsTaskSnapshotFile(filePath)) {
+        ScheduleUserDataSizeSample();
+    }
+    return ERR_OK;
+}
+
+int32_t DataStorageHelper::ReplaceFileContent(const std::string &value, const std::string &filePath)
+{
     std::string realPath;
     if (!ConvertFullPath(filePath, realPath)) {
-        BGTASK_LOGE("SaveJsonValueToFile Get real file path: %{private}s failed", filePath.c_str());
+        BGTASK_LOGE("ReplaceFileContent Get real file path: %{private}s failed", filePath.c_str());
         return ERR_BGTASK_GET_ACTUAL_FILE_ERR;
     }
-    fout.open(realPath, std::ios::out);
-    if (!fout.is_open()) {
-        BGTASK_LOGE("Open file: %{private}s failed.", filePath.c_str());
+    // 先写临时文件并刷盘再原子替换，写入中断时保留上一份完整文件
+    std::string tmpPath = realPath + TMP_FILE_SUFFIX;
+    UniqueFd fd(open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, S_IRUSR | S_IWUSR));
+    if (fd.Get() < 0) {
+        BGTASK_LOGE("Open file: %{private}s failed, errno: %{public}s", tmpPath.c_str(), strerror(errno));
         return ERR_BGTASK_OPEN_FILE_ERR;
     }
-    fout << value.c_str() << std::endl;
-    fout.close();
-    if (filePath == TASK_RECORD_FILE_PATH) {
-        ReportUserDataSizeEvent();
+    size_t written = 0;
+    while (written < value.size()) {
+        ssize_t len = write(fd.Get(), value.data() + written, value.size() - written);
+        if (len < 0 && errno == EINTR) {
+            continue;
+        }
+        if (len <= 0) {
+            break;
+        }
+        written += static_cast<size_t>(len);
+    }
+    if (written != value.size() || fsync(fd.Get()) != 0 || rename(tmpPath.c_str(), realPath.c_str()) != 0) {
+        BGTASK_LOGE("Write file: %{private}s failed, errno: %{public}s", filePath.c_str(), strerror(errno));
+        unlink(tmpPath.c_str());
+        return ERR_BGTASK_DATA_STORAGE_ERR;
+    }
+    // 目录项落盘后再删除旧格式文件
+    UniqueFd dirFd(open(realPath.substr(0, realPath.rfind('/') + 1).c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC));
+    if (dirFd.Get() < 0 || fsync(dirFd.Get()) != 0) {
+        BGTASK_LOGE("Sync dir of file: %{private}s failed, errno: %{public}s", filePath.c_str(), strerror(errno));
+        return ERR_BGTASK_DATA_STORAGE_ERR;
     }
     return ERR_OK;
 }
 
+bool DataStorageHelper::LoadRecordSnapshot(const std::string &filePath, const RecordSnapshot::Visitor &visitor)
+{
+    std::string realPath;
+    if (!ConvertFullPath(filePath, realPath)) {
+        return false;
+    }
+    int fd = open(realPath.c_str(), O_RDONLY);
+    if (fd < 0) {
+        BGTASK_LOGE("Fail to open file: %{private}s, errno: %{public}s", filePath.c_str(), strerror(errno));
+        return false;
+    }
+    struct stat statBuf;
+    if (fstat(fd, &statBuf) < 0 || statBuf.st_size <= 0) {
+        close(fd);
+        return false;
+    }
+    size_t size = static_cast<size_t>(statBuf.st_size);
+    void *addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED) {
+        BGTASK_LOGE("Fail to mmap file: %{private}s, errno: %{public}s", filePath.c_str(), strerror(errno));
+        return false;
+    }
+    bool ret = RecordSnapshot::Decode(static_cast<const uint8_t *>(addr), size, visitor);
+    munmap(addr, size);
+    return ret;
+}
+
 bool DataStorageHelper::ParseFastSuspendDozeTime(const std::string &FilePath, int &time)
 {
     nlohmann::json jsonObj;
@@ -436,29 +1039,13 @@ void DataStorageHelper::ConvertMapToJson(const ResourceRecordMap &appRecord, nlo
     }
 }
 
-void DataStorageHelper::DivideJsonToMap(nlohmann::json &root,
-    ResourceRecordMap &appRecord, ResourceRecordMap &processRecord)
-{
-    if (root.contains(APP_RESOURCE_RECORD) && root.at(APP_RESOURCE_RECORD).is_object()) {
-        nlohmann::json appRecordJson = root.at(APP_RESOURCE_RECORD);
-        ConvertJsonToMap(appRecordJson, appRecord);
-    } else {
-        BGTASK_LOGE("can not read appRecord, json init fail");
-    }
-    if (root.contains(PROCESS_RESOURCE_RECORD) && root.at(PROCESS_RESOURCE_RECORD).is_object()) {
-        nlohmann::json processrecordJson = root.at(PROCESS_RESOURCE_RECORD);
-        ConvertJsonToMap(processrecordJson, processRecord);
-    } else {
-        BGTASK_LOGE("can not read processRecord, json init fail");
-    }
-}
-
-void DataStorageHelper::ConvertJsonToMap(const nlohmann::json &value, ResourceRecordMap &recordMap)
+void DataStorageHelper::ConvertMapToSnapshot(const ResourceRecordMap &recordMap, uint32_t section,
+    RecordSnapshot &snapshot)
 {
-    for (auto iter = value.begin(); iter != value.end(); iter++) {
-        std::shared_ptr<ResourceApplicationRecord> recordPtr = std::make_shared<ResourceApplicationRecord>();
-        recordPtr->ParseFromJson(iter.value());
-        recordMap.emplace(static_cast<uint32_t>(std::atoi(iter.key().c_str())), recordPtr);
+    for (const auto &iter : recordMap) {
+        nlohmann::json value;
+        iter.second->ParseToJson(value);
+        snapshot.Append(section, std::to_string(iter.first), value);
     }
 }
 
@@ -483,13 +1070,50 @@ std::vector<uint64_t> GetFileOrFolderSize(const std::vector<std::string>& paths)
     return folderSize;
 }
 
-void DataStorageHelper::ReportUserDataSizeEvent()
+void DataStorageHelper::ScheduleUserDataSizeSample()
 {
-    std::vector<std::string> paths = {
-        "/data/service/el1/public/background_task_mgr/"
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex_);
+        if (isDataSizeSampleScheduled_) {
+            return;
+        }
+        isDataSizeSampleScheduled_ = true;
+    }
+    // 目录遍历及打点放到采样任务中，写盘路径只做标记
+    auto task = []() {
+        DelayedSingleton<DataStorageHelper>::GetInstance()->SampleUserDataSize();
     };
-    uint64_t remainPartitionSize = GetRemainPartitionSize("/data");
+    if (persistHandler_ == nullptr ||
+        !persistHandler_->PostTask(task, TASK_SAMPLE_USER_DATA_SIZE, USER_DATA_SIZE_SAMPLE_INTERVAL)) {
+        BGTASK_LOGW("post sample user data size task failed");
+        std::lock_guard<std::mutex> lock(pendingMutex_);
+        isDataSizeSampleScheduled_ = false;
+    }
+}
+
+void DataStorageHelper::SampleUserDataSize()
+{
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex_);
+        isDataSizeSampleScheduled_ = false;
+    }
+    std::vector<std::string> paths = { USER_DATA_FOLDER_PATH };
     std::vector<uint64_t> folderSize = GetFileOrFolderSize(paths);
+    int64_t totalSize = static_cast<int64_t>(folderSize.front());
+    int64_t curTime = TimeProvider::GetCurrentTime();
+    if (lastReportedDataSize_ >= 0 && std::abs(totalSize - lastReportedDataSize_) < USER_DATA_SIZE_THRESHOLD &&
+        curTime - lastDataSizeReportTime_ < USER_DATA_SIZE_REPORT_INTERVAL) {
+        return;
+    }
+    lastReportedDataSize_ = totalSize;
+    lastDataSizeReportTime_ = curTime;
+    ReportUserDataSizeEvent(paths, folderSize);
+}
+
+void DataStorageHelper::ReportUserDataSizeEvent(const std::vector<std::string> &paths,
+    const std::vector<uint64_t> &folderSize)
+{
+    uint64_t remainPartitionSize = GetRemainPartitionSize("/data");
     HiSysEventWrite(HiviewDFX::HiSysEvent::Domain::FILEMANAGEMENT, "USER_DATA_SIZE",
         HiviewDFX::HiSysEvent::EventType::STATISTIC,
         "COMPONENT_NAME", "background_task_mgr",
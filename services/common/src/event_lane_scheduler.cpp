@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "event_lane_scheduler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+
+#include "bgtaskmgr_log_wrapper.h"
+#include "time_provider.h"
+
+namespace OHOS {
+namespace BackgroundTaskMgr {
+namespace {
+constexpr uint64_t IPC_LANE_SLOW_WAIT_US = 100000;
+
+uint64_t GetSteadyTimeUs()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+}
+
+/**
+ * Travels with the posted task. A task leaves the pending count of its lane when it starts to run, or when it
+ * is destroyed without running because it has been removed from the queue.
+ */
+class EventLaneScheduler::LaneTicket {
+public:
+    LaneTicket(const std::shared_ptr<LaneCounter> &counter, uint64_t readyTimeUs)
+        : counter_(counter), readyTimeUs_(readyTimeUs) {}
+
+    ~LaneTicket()
+    {
+        if (!executed_) {
+            counter_->pending--;
+            counter_->dropped++;
+        }
+    }
+
+    uint64_t Begin()
+    {
+        executed_ = true;
+        counter_->pending--;
+        uint64_t now = GetSteadyTimeUs();
+        uint64_t waitUs = now > readyTimeUs_ ? now - readyTimeUs_ : 0;
+        counter_->totalWaitUs += waitUs;
+        UpdateMax(counter_->maxWaitUs, waitUs);
+        return waitUs;
+    }
+
+    void End(uint64_t execUs)
+    {
+        counter_->executed++;
+        UpdateMax(counter_->maxExecUs, execUs);
+    }
+
+private:
+    std::shared_ptr<LaneCounter> counter_;
+    uint64_t readyTimeUs_ {0};
+    bool executed_ {false};
+};
+
+EventLaneScheduler::EventLaneScheduler()
+{
+    for (auto &counter : counters_) {
+        counter = std::make_shared<LaneCounter>();
+    }
+}
+
+EventLaneScheduler::~EventLaneScheduler() {}
+
+bool EventLaneScheduler::PostSyncTask(const std::shared_ptr<AppExecFwk::EventHandler> &handler, EventLane lane,
+    const std::function<void()> &task)
+{
+    if (handler == nullptr || lane >= EventLane::LANE_BUTT) {
+        BGTASK_LOGE("post sync task failed, handler is null or lane is invalid");
+        return false;
+    }
+    return handler->PostSyncTask(WrapTask(lane, task, 0), GetLanePriority(lane));
+}
+
+bool EventLaneScheduler::PostTask(const std::shared_ptr<AppExecFwk::EventHandler> &handler, EventLane lane,
+    const std::function<void()> &task, const std::string &name, int64_t delayTime)
+{
+    if (handler == nullptr || lane >= EventLane::LANE_BUTT) {
+        BGTASK_LOGE("post task failed, handler is null or lane is invalid");
+        return false;
+    }
+    return handler->PostTask(WrapTask(lane, task, delayTime), name, delayTime, GetLanePriority(lane));
+}
+
+std::function<void()> EventLaneScheduler::WrapTask(EventLane lane, const std::function<void()> &task,
+    int64_t delayTime)
+{
+    auto counter = counters_[static_cast<size_t>(lane)];
+    counter->posted++;
+    UpdateMax(counter->maxPending, ++counter->pending);
+    // 延迟任务的排队时间从到期时刻开始统计
+    uint64_t readyTimeUs = GetSteadyTimeUs() + static_cast<uint64_t>(std::max<int64_t>(0, delayTime)) *
+        USEC_PER_MSEC;
+    auto ticket = std::make_shared<LaneTicket>(counter, readyTimeUs);
+    return [ticket, task, lane]() {
+        uint64_t waitUs = ticket->Begin();
+        if (lane == EventLane::IPC && waitUs >= IPC_LANE_SLOW_WAIT_US) {
+            BGTASK_LOGW("ipc task waited %{public}" PRIu64 " us on runner", waitUs);
+        }
+        uint64_t beginUs = GetSteadyTimeUs();
+        if (task) {
+            task();
+        }
+        ticket->End(GetSteadyTimeUs() - beginUs);
+    };
+}
+
+EventLaneMetrics EventLaneScheduler::GetLaneMetrics(EventLane lane) const
+{
+    EventLaneMetrics metrics;
+    if (lane >= EventLane::LANE_BUTT) {
+        return metrics;
+    }
+    const auto &counter = counters_[static_cast<size_t>(lane)];
+    metrics.posted = counter->posted.load();
+    metrics.executed = counter->executed.load();
+    metrics.dropped = counter->dropped.load();
+    metrics.pending = counter->pending.load();
+    metrics.maxPending = counter->maxPending.load();
+    metrics.totalWaitUs = counter->totalWaitUs.load();
+    metrics.maxWaitUs = counter->maxWaitUs.load();
+    metrics.maxExecUs = counter->maxExecUs.load();
+    return metrics;
+}
+
+void EventLaneScheduler::ResetLaneMetrics()
+{
+    for (auto &counter : counters_) {
+        // pending 由在途任务维护，不清零
+        counter->posted = 0;
+        counter->executed = 0;
+        counter->dropped = 0;
+        counter->maxPending = counter->pending.load();
+        counter->totalWaitUs = 0;
+        counter->maxWaitUs = 0;
+        counter->maxExecUs = 0;
+    }
+}
+
+void EventLaneScheduler::DumpLaneMetrics(std::vector<std::string> &dumpInfo) const
+{
+    for (uint32_t index = 0; index < static_cast<uint32_t>(EventLane::LANE_BUTT); index++) {
+        auto lane = static_cast<EventLane>(index);
+        EventLaneMetrics metrics = GetLaneMetrics(lane);
+        uint64_t avgWaitUs = metrics.executed == 0 ? 0 : metrics.totalWaitUs / metrics.executed;
+        std::string info = std::string("lane: ") + GetLaneName(lane) + "\n"
+            + "\tposted: " + std::to_string(metrics.posted)
+            + ", executed: " + std::to_string(metrics.executed)
+            + ", dropped: " + std::to_string(metrics.dropped) + "\n"
+            + "\tpending: " + std::to_string(metrics.pending)
+            + ", maxPending: " + std::to_string(metrics.maxPending) + "\n"
+            + "\tavgWaitUs: " + std::to_string(avgWaitUs)
+            + ", maxWaitUs: " + std::to_string(metrics.maxWaitUs)
+            + ", maxExecUs: " + std::to_string(metrics.maxExecUs) + "\n";
+        dumpInfo.emplace_back(info);
+    }
+}
+
+AppExecFwk::EventQueue::Priority EventLaneScheduler::GetLanePriority(EventLane lane)
+{
+    // 维护任务保持默认的 LOW 优先级，IDLE 事件在队列空闲时不会唤醒线程，延迟任务可能无法按时执行
+    return lane == EventLane::IPC ? AppExecFwk::EventQueue::Priority::HIGH : AppExecFwk::EventQueue::Priority::LOW;
+}
+
+const char *EventLaneScheduler::GetLaneName(EventLane lane)
+{
+    switch (lane) {
+        case EventLane::IPC:
+            return "ipc";
+        case EventLane::MAINTENANCE:
+            return "maintenance";
+        default:
+            return "unknown";
+    }
+}
+
+void EventLaneScheduler::UpdateMax(std::atomic<uint64_t> &target, uint64_t value)
+{
+    uint64_t current = target.load();
+    while (value > current && !target.compare_exchange_weak(current, value)) {}
+}
+}  // namespace BackgroundTaskMgr
+}  // namespace OHOS
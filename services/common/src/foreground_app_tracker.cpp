@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "foreground_app_tracker.h"
+
+#include <vector>
+
+#include "app_mgr_helper.h"
+#include "bgtaskmgr_log_wrapper.h"
+
+namespace OHOS {
+namespace BackgroundTaskMgr {
+ForegroundAppTracker::ForegroundAppTracker() {}
+
+ForegroundAppTracker::~ForegroundAppTracker() {}
+
+void ForegroundAppTracker::OnProcessStateChanged(const AppExecFwk::ProcessData &processData)
+{
+    bool isForeground = processData.state == AppExecFwk::AppProcessState::APP_STATE_FOREGROUND ||
+        processData.state == AppExecFwk::AppProcessState::APP_STATE_FOCUS;
+    UpdateProcessState(processData.uid, processData.pid, isForeground);
+}
+
+void ForegroundAppTracker::OnProcessDied(const AppExecFwk::ProcessData &processData)
+{
+    UpdateProcessState(processData.uid, processData.pid, false);
+}
+
+void ForegroundAppTracker::UpdateProcessState(int32_t uid, int32_t pid, bool isForeground)
+{
+    std::lock_guard<std::mutex> lock(updateMutex_);
+    if (isForeground) {
+        if (!foregroundUids_[uid].insert(pid).second) {
+            return;
+        }
+    } else {
+        auto iter = foregroundUids_.find(uid);
+        if (iter == foregroundUids_.end() || iter->second.erase(pid) == 0) {
+            return;
+        }
+        if (iter->second.empty()) {
+            foregroundUids_.erase(iter);
+        }
+    }
+    PublishLocked();
+}
+
+bool ForegroundAppTracker::Resync()
+{
+    // 查询期间阻塞状态更新，避免查询结果覆盖更新的事件
+    std::lock_guard<std::mutex> lock(updateMutex_);
+    std::vector<AppExecFwk::AppStateData> fgApps;
+    if (!AppMgrHelper::GetInstance()->GetForegroundApplications(fgApps)) {
+        BGTASK_LOGE("resync foreground apps failed");
+        return false;
+    }
+    foregroundUids_.clear();
+    for (const auto &appStateData : fgApps) {
+        foregroundUids_[appStateData.uid].insert(appStateData.pid);
+    }
+    PublishLocked();
+    hasResynced_.store(true);
+    BGTASK_LOGI("resync foreground apps, uid size: %{public}zu", foregroundUids_.size());
+    return true;
+}
+
+bool ForegroundAppTracker::HasResynced() const
+{
+    return hasResynced_.load();
+}
+
+bool ForegroundAppTracker::IsUidForeground(int32_t uid) const
+{
+    auto snapshot = std::atomic_load(&snapshot_);
+    return snapshot->count(uid) != 0;
+}
+
+void ForegroundAppTracker::ForEachForegroundUid(const std::function<void(int32_t)> &func) const
+{
+    auto snapshot = std::atomic_load(&snapshot_);
+    for (const auto &item : *snapshot) {
+        func(item.first);
+    }
+}
+
+void ForegroundAppTracker::Clear()
+{
+    std::lock_guard<std::mutex> lock(updateMutex_);
+    foregroundUids_.clear();
+    PublishLocked();
+}
+
+void ForegroundAppTracker::PublishLocked()
+{
+    std::atomic_store(&snapshot_, std::shared_ptr<const ForegroundUidMap>(
+        std::make_shared<ForegroundUidMap>(foregroundUids_)));
+}
+}  // namespace BackgroundTaskMgr
+}  // namespace OHOS
@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "init_step_graph.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+
+#include "bgtaskmgr_log_wrapper.h"
+
+namespace OHOS {
+namespace BackgroundTaskMgr {
+namespace {
+const std::string INIT_RUNNER_NAME = "BgtaskInit";
+constexpr size_t MAX_INIT_WORKERS = 3;
+
+uint64_t GetSteadyTimeMs()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+const char *GetStateName(InitStepState state)
+{
+    switch (state) {
+        case InitStepState::SUCCEEDED:
+            return "succeeded";
+        case InitStepState::FAILED:
+            return "failed";
+        case InitStepState::RUNNING:
+            return "running";
+        default:
+            return "skipped";
+    }
+}
+}
+
+InitStepGraph::InitStepGraph(const std::string &name) : name_(name) {}
+
+bool InitStepGraph::AddStep(const std::string &name, Step step, const std::vector<std::string> &dependencies,
+    bool onCaller)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto findNode = [this](const std::string &target) {
+        return std::find_if(nodes_.begin(), nodes_.end(),
+            [&target](const StepNode &node) { return node.name == target; });
+    };
+    if (!step || findNode(name) != nodes_.end()) {
+        BGTASK_LOGE("%{public}s add init step %{public}s failed", name_.c_str(), name.c_str());
+        return false;
+    }
+    StepNode node;
+    node.name = name;
+    node.step = step;
+    node.onCaller = onCaller;
+    for (const auto &dependency : dependencies) {
+        auto iter = findNode(dependency);
+        if (iter == nodes_.end()) {
+            BGTASK_LOGE("%{public}s init step %{public}s depends on unknown step %{public}s", name_.c_str(),
+                name.c_str(), dependency.c_str());
+            return false;
+        }
+        node.dependencies.push_back(static_cast<size_t>(iter - nodes_.begin()));
+    }
+    nodes_.emplace_back(std::move(node));
+    return true;
+}
+
+bool InitStepGraph::Run()
+{
+    uint64_t beginMs = GetSteadyTimeMs();
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        StartWorkerSteps();
+        auto iter = std::find_if(nodes_.begin(), nodes_.end(),
+            [this](const StepNode &node) { return node.onCaller && IsReady(node); });
+        if (iter != nodes_.end()) {
+            size_t index = static_cast<size_t>(iter - nodes_.begin());
+            iter->state = InitStepState::RUNNING;
+            runningCount_++;
+            lock.unlock();
+            RunStep(index);
+            lock.lock();
+            continue;
+        }
+        if (runningCount_ == 0) {
+            break;
+        }
+        finished_.wait(lock);
+    }
+    // 所有步骤已结束，释放临时工作线程
+    auto workers = std::move(workers_);
+    workers_.clear();
+    lock.unlock();
+    workers.clear();
+    ReportStepCosts(GetSteadyTimeMs() - beginMs);
+    std::lock_guard<std::mutex> guard(mutex_);
+    return std::all_of(nodes_.begin(), nodes_.end(),
+        [](const StepNode &node) { return node.state == InitStepState::SUCCEEDED; });
+}
+
+bool InitStepGraph::IsReady(const StepNode &node) const
+{
+    if (node.state != InitStepState::PENDING) {
+        return false;
+    }
+    return std::all_of(node.dependencies.begin(), node.dependencies.end(),
+        [this](size_t index) { return nodes_[index].state == InitStepState::SUCCEEDED; });
+}
+
+void InitStepGraph::StartWorkerSteps()
+{
+    for (size_t index = 0; index < nodes_.size(); index++) {
+        auto &node = nodes_[index];
+        if (node.onCaller || !IsReady(node)) {
+            continue;
+        }
+        auto worker = GetWorker();
+        if (worker == nullptr) {
+            // 无法创建工作线程时退化为在调用线程执行
+            node.onCaller = true;
+            continue;
+        }
+        node.state = InitStepState::RUNNING;
+        runningCount_++;
+        worker->PostTask([this, index]() { this->RunStep(index); }, name_ + "_" + node.name);
+    }
+}
+
+void InitStepGraph::RunStep(size_t index)
+{
+    Step step;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        step = nodes_[index].step;
+    }
+    uint64_t beginMs = GetSteadyTimeMs();
+    bool result = step();
+    uint64_t costMs = GetSteadyTimeMs() - beginMs;
+    std::lock_guard<std::mutex> lock(mutex_);
+    nodes_[index].state = result ? InitStepState::SUCCEEDED : InitStepState::FAILED;
+    nodes_[index].costMs = costMs;
+    runningCount_--;
+    finished_.notify_all();
+}
+
+std::shared_ptr<AppExecFwk::EventHandler> InitStepGraph::GetWorker()
+{
+    if (workers_.size() < MAX_INIT_WORKERS) {
+        auto runner = AppExecFwk::EventRunner::Create(INIT_RUNNER_NAME + std::to_string(workers_.size()));
+        if (runner != nullptr) {
+            workers_.emplace_back(std::make_shared<AppExecFwk::EventHandler>(runner));
+            return workers_.back();
+        }
+    }
+    if (workers_.empty()) {
+        return nullptr;
+    }
+    return workers_[nextWorker_++ % workers_.size()];
+}
+
+std::vector<InitStepCost> InitStepGraph::GetStepCosts()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<InitStepCost> costs;
+    for (const auto &node : nodes_) {
+        InitStepCost cost;
+        cost.name = node.name;
+        cost.state = node.state;
+        cost.costMs = node.costMs;
+        costs.emplace_back(cost);
+    }
+    return costs;
+}
+
+void InitStepGraph::ReportStepCosts(uint64_t totalCostMs)
+{
+    for (const auto &cost : GetStepCosts()) {
+        BGTASK_LOGI("%{public}s init step %{public}s %{public}s, cost %{public}" PRIu64 " ms", name_.c_str(),
+            cost.name.c_str(), GetStateName(cost.state), cost.costMs);
+    }
+    BGTASK_LOGI("%{public}s init finished, cost %{public}" PRIu64 " ms", name_.c_str(), totalCostMs);
+}
+}  // namespace BackgroundTaskMgr
+}  // namespace OHOS
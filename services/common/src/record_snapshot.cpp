@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "record_snapshot.h"
+
+#include <array>
+
+#include "continuous_task_log.h"
+
+namespace OHOS {
+namespace BackgroundTaskMgr {
+namespace {
+constexpr uint32_t SNAPSHOT_MAGIC = 0x4E534742; // "BGSN"
+constexpr uint16_t SNAPSHOT_VERSION = 1;
+constexpr size_t HEADER_SIZE = 12;
+constexpr size_t HEADER_COUNT_OFFSET = 8;
+constexpr size_t RECORD_HEADER_SIZE = 16;
+constexpr uint32_t CRC32_POLY = 0xEDB88320;
+constexpr uint32_t CRC32_INIT = 0xFFFFFFFF;
+constexpr uint32_t BYTE_BITS = 8;
+constexpr uint32_t BYTE_MASK = 0xFF;
+constexpr uint32_t CRC_TABLE_SIZE = 256;
+
+void PutU16(std::string &buffer, uint16_t value)
+{
+    buffer.push_back(static_cast<char>(value & BYTE_MASK));
+    buffer.push_back(static_cast<char>((value >> BYTE_BITS) & BYTE_MASK));
+}
+
+void PutU32(std::string &buffer, uint32_t value)
+{
+    for (uint32_t i = 0; i < sizeof(uint32_t); i++) {
+        buffer.push_back(static_cast<char>((value >> (i * BYTE_BITS)) & BYTE_MASK));
+    }
+}
+
+void SetU32(std::string &buffer, size_t offset, uint32_t value)
+{
+    for (uint32_t i = 0; i < sizeof(uint32_t); i++) {
+        buffer[offset + i] = static_cast<char>((value >> (i * BYTE_BITS)) & BYTE_MASK);
+    }
+}
+
+uint16_t GetU16(const uint8_t *data)
+{
+    return static_cast<uint16_t>(data[0] | (data[1] << BYTE_BITS));
+}
+
+uint32_t GetU32(const uint8_t *data)
+{
+    uint32_t value = 0;
+    for (uint32_t i = 0; i < sizeof(uint32_t); i++) {
+        value |= static_cast<uint32_t>(data[i]) << (i * BYTE_BITS);
+    }
+    return value;
+}
+
+const std::array<uint32_t, CRC_TABLE_SIZE> &GetCrcTable()
+{
+    static const std::array<uint32_t, CRC_TABLE_SIZE> table = []() {
+        std::array<uint32_t, CRC_TABLE_SIZE> result {};
+        for (uint32_t i = 0; i < CRC_TABLE_SIZE; i++) {
+            uint32_t crc = i;
+            for (uint32_t bit = 0; bit < BYTE_BITS; bit++) {
+                crc = (crc & 1) ? (CRC32_POLY ^ (crc >> 1)) : (crc >> 1);
+            }
+            result[i] = crc;
+        }
+        return result;
+    }();
+    return table;
+}
+}
+
+RecordSnapshot::RecordSnapshot()
+{
+    PutU32(buffer_, SNAPSHOT_MAGIC);
+    PutU16(buffer_, SNAPSHOT_VERSION);
+    PutU16(buffer_, 0);
+    PutU32(buffer_, 0);
+}
+
+void RecordSnapshot::Append(uint32_t section, const std::string &key, const nlohmann::json &value)
+{
+    std::vector<uint8_t> payload = nlohmann::json::to_msgpack(value);
+    uint8_t sectionBytes[sizeof(uint32_t)] = {0};
+    for (uint32_t i = 0; i < sizeof(uint32_t); i++) {
+        sectionBytes[i] = static_cast<uint8_t>((section >> (i * BYTE_BITS)) & BYTE_MASK);
+    }
+    uint32_t crc = Crc32(CRC32_INIT, sectionBytes, sizeof(sectionBytes));
+    crc = Crc32(crc, reinterpret_cast<const uint8_t *>(key.data()), key.size());
+    crc = Crc32(crc, payload.data(), payload.size()) ^ CRC32_INIT;
+    PutU32(buffer_, section);
+    PutU32(buffer_, static_cast<uint32_t>(key.size()));
+    PutU32(buffer_, static_cast<uint32_t>(payload.size()));
+    PutU32(buffer_, crc);
+    buffer_.append(key);
+    buffer_.append(payload.begin(), payload.end());
+    recordCount_++;
+}
+
+std::string RecordSnapshot::Finish()
+{
+    SetU32(buffer_, HEADER_COUNT_OFFSET, recordCount_);
+    return std::move(buffer_);
+}
+
+bool RecordSnapshot::IsSnapshot(const uint8_t *data, size_t size)
+{
+    if (data == nullptr || size < HEADER_SIZE) {
+        return false;
+    }
+    return GetU32(data) == SNAPSHOT_MAGIC && GetU16(data + sizeof(uint32_t)) == SNAPSHOT_VERSION;
+}
+
+bool RecordSnapshot::Decode(const uint8_t *data, size_t size, const Visitor &visitor)
+{
+    if (!IsSnapshot(data, size)) {
+        BGTASK_LOGE("invalid record snapshot header");
+        return false;
+    }
+    uint32_t recordCount = GetU32(data + HEADER_COUNT_OFFSET);
+    size_t offset = HEADER_SIZE;
+    for (uint32_t index = 0; index < recordCount; index++) {
+        if (size - offset < RECORD_HEADER_SIZE) {
+            BGTASK_LOGE("record snapshot truncated at record: %{public}u", index);
+            return false;
+        }
+        const uint8_t *record = data + offset;
+        uint32_t keyLen = GetU32(record + sizeof(uint32_t));
+        uint32_t payloadLen = GetU32(record + sizeof(uint32_t) * 2);
+        uint32_t crc = GetU32(record + sizeof(uint32_t) * 3);
+        if (size - offset - RECORD_HEADER_SIZE < static_cast<size_t>(keyLen) + payloadLen) {
+            BGTASK_LOGE("record snapshot truncated at record: %{public}u", index);
+            return false;
+        }
+        const uint8_t *key = record + RECORD_HEADER_SIZE;
+        const uint8_t *payload = key + keyLen;
+        offset += RECORD_HEADER_SIZE + keyLen + payloadLen;
+        uint32_t actualCrc = Crc32(CRC32_INIT, record, sizeof(uint32_t));
+        actualCrc = Crc32(actualCrc, key, keyLen);
+        actualCrc = Crc32(actualCrc, payload, payloadLen) ^ CRC32_INIT;
+        if (actualCrc != crc) {
+            BGTASK_LOGW("skip record: %{public}u, crc mismatch", index);
+            continue;
+        }
+        nlohmann::json value = nlohmann::json::from_msgpack(payload, payload + payloadLen, true, false);
+        if (value.is_discarded()) {
+            BGTASK_LOGW("skip record: %{public}u, payload is discarded", index);
+            continue;
+        }
+        visitor(GetU32(record), std::string(reinterpret_cast<const char *>(key), keyLen), value);
+    }
+    return true;
+}
+
+uint32_t RecordSnapshot::Crc32(uint32_t crc, const uint8_t *data, size_t size)
+{
+    const auto &table = GetCrcTable();
+    for (size_t i = 0; i < size; i++) {
+        crc = table[(crc ^ data[i]) & BYTE_MASK] ^ (crc >> BYTE_BITS);
+    }
+    return crc;
+}
+}  // namespace BackgroundTaskMgr
+}  // namespace OHOS
@@ -0,0 +1,332 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "subscriber_dispatcher.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <iterator>
+
+#include "bgtaskmgr_log_wrapper.h"
+
+namespace OHOS {
+namespace BackgroundTaskMgr {
+namespace {
+const std::string DISPATCHER_RUNNER_NAME = "BgtaskDispatcher";
+const std::string TASK_DRAIN_SUBSCRIBER_EVENTS = "DrainSubscriberEvents";
+const std::string TASK_UNBLOCK_SUBSCRIBER = "UnblockSubscriber";
+constexpr size_t DISPATCHER_POOL_SIZE = 2;
+constexpr size_t MAX_PENDING_EVENTS = 128;
+constexpr uint32_t DRAIN_BATCH_SIZE = 16;
+constexpr uint64_t SLOW_DELIVERY_US = 200000;
+constexpr uint32_t MAX_SLOW_DELIVERIES = 5;
+constexpr int64_t BLOCK_COOL_DOWN_MS = 10000;
+constexpr uint32_t MAX_FLUSH_ROUNDS = 64;
+
+uint64_t GetSteadyTimeUs()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+}
+
+SubscriberDispatcher::SubscriberDispatcher()
+{
+    for (size_t index = 0; index < DISPATCHER_POOL_SIZE; index++) {
+        auto runner = AppExecFwk::EventRunner::Create(DISPATCHER_RUNNER_NAME + std::to_string(index));
+        handlers_.emplace_back(std::make_shared<AppExecFwk::EventHandler>(runner));
+    }
+}
+
+SubscriberDispatcher::~SubscriberDispatcher() {}
+
+bool SubscriberDispatcher::Dispatch(SubscriberSource source, const sptr<IRemoteObject> &remote,
+    SubscriberEvent event)
+{
+    if (!event.delivery) {
+        BGTASK_LOGE("dispatch subscriber event failed, delivery is null");
+        return false;
+    }
+    dispatched_++;
+    if (remote == nullptr) {
+        // 无法区分订阅者时不排队，直接投递
+        event.delivery(event.eventType);
+        delivered_++;
+        return true;
+    }
+    std::shared_ptr<SubscriberQueue> queue;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        auto &target = queues_[QueueKey(source, remote.GetRefPtr())];
+        if (target == nullptr) {
+            target = std::make_shared<SubscriberQueue>();
+            target->source = source;
+            target->remote = remote;
+            target->runnerIndex = nextRunnerIndex_++ % DISPATCHER_POOL_SIZE;
+        }
+        if (event.resync) {
+            target->resync = event.resync;
+        }
+        if (TryCoalesce(*target, event)) {
+            coalesced_++;
+            return true;
+        }
+        if (target->events.size() >= MAX_PENDING_EVENTS) {
+            DropOneEvent(*target);
+        }
+        target->events.emplace_back(std::move(event));
+        // 被暂停的订阅者只积压事件，冷却结束后再投递
+        if (target->draining || target->blocked) {
+            return true;
+        }
+        target->draining = true;
+        queue = target;
+    }
+    ScheduleDrain(queue);
+    return true;
+}
+
+bool SubscriberDispatcher::TryCoalesce(SubscriberQueue &queue, SubscriberEvent &event)
+{
+    if (event.coalesceKey.empty() || (event.foldInto.empty() && event.cancelOut.empty())) {
+        return false;
+    }
+    // 只与同一任务最近一个未投递的事件合并，保持事件之间的先后关系
+    for (auto iter = queue.events.rbegin(); iter != queue.events.rend(); ++iter) {
+        if (iter->coalesceKey != event.coalesceKey) {
+            continue;
+        }
+        if (std::find(event.foldInto.begin(), event.foldInto.end(), iter->eventType) != event.foldInto.end()) {
+            iter->delivery = std::move(event.delivery);
+            return true;
+        }
+        if (std::find(event.cancelOut.begin(), event.cancelOut.end(), iter->eventType) != event.cancelOut.end()) {
+            queue.events.erase(std::next(iter).base());
+            return true;
+        }
+        return false;
+    }
+    return false;
+}
+
+void SubscriberDispatcher::DropOneEvent(SubscriberQueue &queue)
+{
+    queue.dropped++;
+    dropped_++;
+    // 订阅者积压，优先丢弃可被后续事件覆盖的最早事件，避免队列无限增长
+    auto iter = std::find_if(queue.events.begin(), queue.events.end(),
+        [](const SubscriberEvent &event) { return event.droppable; });
+    if (iter != queue.events.end()) {
+        BGTASK_LOGW("subscriber queue is full, drop oldest droppable event: %{public}u, dropped: %{public}" PRIu64,
+            iter->eventType, queue.dropped);
+        queue.events.erase(iter);
+        return;
+    }
+    droppedStateEvents_++;
+    queue.needResync = true;
+    BGTASK_LOGE("subscriber queue is full, drop state event: %{public}u, key: %{public}s, resync later",
+        queue.events.front().eventType, queue.events.front().coalesceKey.c_str());
+    queue.events.pop_front();
+}
+
+bool SubscriberDispatcher::PopNextEvent(SubscriberQueue &queue, SubscriberEvent &event)
+{
+    if (!queue.events.empty()) {
+        event = std::move(queue.events.front());
+        queue.events.pop_front();
+        return true;
+    }
+    if (!queue.needResync) {
+        return false;
+    }
+    queue.needResync = false;
+    if (!queue.resync) {
+        BGTASK_LOGE("subscriber lost state events but has no resync callback");
+        return false;
+    }
+    // 积压投递完成后再通知重新查询，查询结果已包含被丢弃的状态变化
+    auto resync = queue.resync;
+    event.delivery = [resync](uint32_t) { resync(); };
+    resyncs_++;
+    return true;
+}
+
+void SubscriberDispatcher::ScheduleDrain(const std::shared_ptr<SubscriberQueue> &queue)
+{
+    auto handler = handlers_[queue->runnerIndex];
+    if (handler == nullptr) {
+        Drain(queue);
+        return;
+    }
+    handler->PostTask([this, queue]() { this->Drain(queue); }, TASK_DRAIN_SUBSCRIBER_EVENTS);
+}
+
+void SubscriberDispatcher::Drain(const std::shared_ptr<SubscriberQueue> &queue)
+{
+    for (uint32_t count = 0; count < DRAIN_BATCH_SIZE; count++) {
+        SubscriberEvent event;
+        {
+            std::lock_guard<std::mutex> lock(queueMutex_);
+            if (queue->blocked) {
+                queue->draining = false;
+                return;
+            }
+            if (queue->removed || !PopNextEvent(*queue, event)) {
+                queue->draining = false;
+                queue->events.clear();
+                auto iter = queues_.find(QueueKey(queue->source, queue->remote.GetRefPtr()));
+                // 没有积压且投递正常的订阅者不再保留队列
+                if (queue->slowCount == 0 && iter != queues_.end() && iter->second == queue) {
+                    queues_.erase(iter);
+                }
+                return;
+            }
+        }
+        uint64_t beginUs = GetSteadyTimeUs();
+        event.delivery(event.eventType);
+        OnDelivered(queue, GetSteadyTimeUs() - beginUs);
+    }
+    // 一批投递完成后重新排队，让同一线程上的其他订阅者得到执行
+    ScheduleDrain(queue);
+}
+
+void SubscriberDispatcher::OnDelivered(const std::shared_ptr<SubscriberQueue> &queue, uint64_t execUs)
+{
+    delivered_++;
+    std::lock_guard<std::mutex> lock(queueMutex_);
+    queue->delivered++;
+    queue->maxExecUs = std::max(queue->maxExecUs, execUs);
+    if (execUs < SLOW_DELIVERY_US) {
+        queue->slowCount = 0;
+        return;
+    }
+    slowDeliveries_++;
+    queue->slowCount++;
+    BGTASK_LOGW("slow subscriber delivery cost %{public}" PRIu64 " us, count: %{public}u", execUs,
+        queue->slowCount);
+    if (queue->slowCount < MAX_SLOW_DELIVERIES || queue->blocked) {
+        return;
+    }
+    queue->blocked = true;
+    blockedSubscribers_++;
+    BGTASK_LOGE("subscriber is paused after %{public}u slow deliveries, pending: %{public}zu", queue->slowCount,
+        queue->events.size());
+    auto handler = handlers_[queue->runnerIndex];
+    if (handler != nullptr) {
+        handler->PostTask([this, queue]() { this->Unblock(queue); }, TASK_UNBLOCK_SUBSCRIBER,
+            BLOCK_COOL_DOWN_MS);
+    }
+}
+
+void SubscriberDispatcher::Unblock(const std::shared_ptr<SubscriberQueue> &queue)
+{
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        if (queue->removed || !queue->blocked) {
+            return;
+        }
+        queue->blocked = false;
+        queue->slowCount = 0;
+        BGTASK_LOGI("subscriber resumed after cool down, pending: %{public}zu, needResync: %{public}d",
+            queue->events.size(), queue->needResync);
+        if (queue->draining) {
+            return;
+        }
+        queue->draining = true;
+    }
+    ScheduleDrain(queue);
+}
+
+void SubscriberDispatcher::RemoveSubscriber(SubscriberSource source, const sptr<IRemoteObject> &remote)
+{
+    if (remote == nullptr) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(queueMutex_);
+    auto iter = queues_.find(QueueKey(source, remote.GetRefPtr()));
+    if (iter == queues_.end()) {
+        return;
+    }
+    iter->second->removed = true;
+    iter->second->events.clear();
+    queues_.erase(iter);
+}
+
+bool SubscriberDispatcher::HasDrainingQueue()
+{
+    std::lock_guard<std::mutex> lock(queueMutex_);
+    for (const auto &iter : queues_) {
+        if (iter.second->draining) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void SubscriberDispatcher::Flush()
+{
+    for (uint32_t round = 0; round < MAX_FLUSH_ROUNDS && HasDrainingQueue(); round++) {
+        for (const auto &handler : handlers_) {
+            if (handler != nullptr) {
+                handler->PostSyncTask([]() {});
+            }
+        }
+    }
+}
+
+SubscriberDispatcherStats SubscriberDispatcher::GetStats()
+{
+    SubscriberDispatcherStats stats;
+    stats.dispatched = dispatched_.load();
+    stats.delivered = delivered_.load();
+    stats.coalesced = coalesced_.load();
+    stats.dropped = dropped_.load();
+    stats.droppedStateEvents = droppedStateEvents_.load();
+    stats.resyncs = resyncs_.load();
+    stats.slowDeliveries = slowDeliveries_.load();
+    stats.blockedSubscribers = blockedSubscribers_.load();
+    return stats;
+}
+
+void SubscriberDispatcher::DumpDispatcherInfo(std::vector<std::string> &dumpInfo)
+{
+    SubscriberDispatcherStats stats = GetStats();
+    std::string info = std::string("subscriber dispatcher\n")
+        + "\tdispatched: " + std::to_string(stats.dispatched)
+        + ", delivered: " + std::to_string(stats.delivered)
+        + ", coalesced: " + std::to_string(stats.coalesced)
+        + ", dropped: " + std::to_string(stats.dropped)
+        + ", droppedStateEvents: " + std::to_string(stats.droppedStateEvents)
+        + ", resyncs: " + std::to_string(stats.resyncs) + "\n"
+        + "\tslowDeliveries: " + std::to_string(stats.slowDeliveries)
+        + ", blockedSubscribers: " + std::to_string(stats.blockedSubscribers) + "\n";
+    std::lock_guard<std::mutex> lock(queueMutex_);
+    uint32_t index = 0;
+    for (const auto &iter : queues_) {
+        const auto &queue = iter.second;
+        info += "\tqueue " + std::to_string(index++) + ": source: " + std::to_string(static_cast<uint32_t>(
+            queue->source)) + ", runner: " + std::to_string(queue->runnerIndex)
+            + ", pending: " + std::to_string(queue->events.size())
+            + ", delivered: " + std::to_string(queue->delivered)
+            + ", dropped: " + std::to_string(queue->dropped)
+            + ", maxExecUs: " + std::to_string(queue->maxExecUs)
+            + ", blocked: " + (queue->blocked ? "true" : "false")
+            + ", needResync: " + (queue->needResync ? "true" : "false") + "\n";
+    }
+    dumpInfo.emplace_back(info);
+}
+}  // namespace BackgroundTaskMgr
+}  // namespace OHOS
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "subscriber_event_parcel.h"
+
+#include "bgtaskmgr_log_wrapper.h"
+#include "message_option.h"
+#include "message_parcel.h"
+
+namespace OHOS {
+namespace BackgroundTaskMgr {
+namespace {
+bool IsOnewayCode(IBackgroundTaskSubscriberIpcCode code)
+{
+    // 与 IBackgroundTaskSubscriber.idl 保持一致，效率资源回调为同步调用
+    switch (code) {
+        case IBackgroundTaskSubscriberIpcCode::COMMAND_ON_APP_EFFICIENCY_RESOURCES_APPLY:
+        case IBackgroundTaskSubscriberIpcCode::COMMAND_ON_APP_EFFICIENCY_RESOURCES_RESET:
+        case IBackgroundTaskSubscriberIpcCode::COMMAND_ON_PROC_EFFICIENCY_RESOURCES_APPLY:
+        case IBackgroundTaskSubscriberIpcCode::COMMAND_ON_PROC_EFFICIENCY_RESOURCES_RESET:
+        case IBackgroundTaskSubscriberIpcCode::COMMAND_GET_FLAG:
+            return false;
+        default:
+            return true;
+    }
+}
+}
+
+SubscriberEventParcel::SubscriberEventParcel(const std::shared_ptr<Parcelable> &info) : info_(info) {}
+
+bool SubscriberEventParcel::Marshal()
+{
+    std::call_once(marshalFlag_, [this]() {
+        if (info_ == nullptr) {
+            return;
+        }
+        Parcel parcel;
+        if (!parcel.WriteParcelable(info_.get())) {
+            BGTASK_LOGE("marshal subscriber event payload failed");
+            return;
+        }
+        const uint8_t *data = reinterpret_cast<const uint8_t *>(parcel.GetData());
+        payload_.assign(data, data + parcel.GetDataSize());
+        marshalled_.store(true);
+    });
+    return marshalled_.load();
+}
+
+bool SubscriberEventParcel::SendRequest(const sptr<IRemoteObject> &remote, IBackgroundTaskSubscriberIpcCode code)
+{
+    if (remote == nullptr || !remote->IsProxyObject() || !Marshal()) {
+        return false;
+    }
+    MessageParcel data;
+    MessageParcel reply;
+    MessageOption option(IsOnewayCode(code) ? MessageOption::TF_ASYNC : MessageOption::TF_SYNC);
+    if (!data.WriteInterfaceToken(IBackgroundTaskSubscriber::GetDescriptor()) ||
+        !data.WriteBuffer(payload_.data(), payload_.size())) {
+        BGTASK_LOGE("write subscriber event payload failed, code: %{public}u", static_cast<uint32_t>(code));
+        return true;
+    }
+    int32_t result = remote->SendRequest(static_cast<uint32_t>(code), data, reply, option);
+    if (result != ERR_NONE) {
+        BGTASK_LOGE("send subscriber event failed, code: %{public}u, result: %{public}d",
+            static_cast<uint32_t>(code), result);
+    }
+    return true;
+}
+
+bool SubscriberEventParcel::IsMarshalled() const
+{
+    return marshalled_.load();
+}
+}  // namespace BackgroundTaskMgr
+}  // namespace OHOS
@@ -20,8 +20,10 @@
 #include "common_utils.h"
 #include "bg_continuous_task_mgr.h"
 #include "bgtaskmgr_inner_errors.h"
+#include "bundle_info_cache.h"
 #include "continuous_task_log.h"
 #include "bg_efficiency_resources_mgr.h"
+#include "event_lane_scheduler.h"
 
 namespace OHOS {
 namespace BackgroundTaskMgr {
@@ -29,6 +31,7 @@ namespace {
 const std::string TASK_ON_BUNDLEINFO_CHANGED = "OnBundleInfoChanged";
 const std::string TASK_ON_OS_ACCOUNT_CHANGED = "OnOsAccountChanged";
 const std::string TASK_ON_BUNDLE_RESOURCES_CHANGED = "OnBundleResourcesChanged";
+const std::string TASK_PREFETCH_BUNDLE_INFO = "PrefetchBundleInfo";
 }
 
 SystemEventObserver::SystemEventObserver(const EventFwk::CommonEventSubscribeInfo &subscribeInfo)
@@ -64,10 +67,41 @@ void SystemEventObserver::SetBgContinuousTaskMgr(const std::shared_ptr<BgContinu
 
 void SystemEventObserver::OnReceiveEvent(const EventFwk::CommonEventData &eventData)
 {
+    OnReceiveEventBundleInfoCache(eventData);
     OnReceiveEventContinuousTask(eventData);
     OnReceiveEventEfficiencyRes(eventData);
 }
 
+void SystemEventObserver::OnReceiveEventBundleInfoCache(const EventFwk::CommonEventData &eventData)
+{
+    AAFwk::Want want = eventData.GetWant();
+    std::string action = want.GetAction();
+    auto bundleInfoCache = DelayedSingleton<BundleInfoCache>::GetInstance();
+    if (action == EventFwk::CommonEventSupport::COMMON_EVENT_BUNDLE_RESOURCES_CHANGED) {
+        bundleInfoCache->InvalidateAppLabels();
+        return;
+    }
+    if (action != EventFwk::CommonEventSupport::COMMON_EVENT_PACKAGE_ADDED
+        && action != EventFwk::CommonEventSupport::COMMON_EVENT_PACKAGE_REMOVED
+        && action != EventFwk::CommonEventSupport::COMMON_EVENT_BUNDLE_REMOVED
+        && action != EventFwk::CommonEventSupport::COMMON_EVENT_PACKAGE_FULLY_REMOVED
+        && action != EventFwk::CommonEventSupport::COMMON_EVENT_PACKAGE_CHANGED
+        && action != EventFwk::CommonEventSupport::COMMON_EVENT_PACKAGE_REPLACED) {
+        return;
+    }
+    std::string bundleName = want.GetElement().GetBundleName();
+    int32_t userId = want.GetIntParam(AppExecFwk::Constants::USER_ID, -1);
+    // 在投递到任务线程前失效，保证后续请求读到更新后的包信息
+    bundleInfoCache->InvalidateBundle(bundleName, userId);
+    auto handler = handler_.lock();
+    if (action != EventFwk::CommonEventSupport::COMMON_EVENT_PACKAGE_ADDED || !handler || userId < 0) {
+        return;
+    }
+    auto task = [bundleInfoCache, bundleName, userId]() { bundleInfoCache->Prefetch(bundleName, userId); };
+    DelayedSingleton<EventLaneScheduler>::GetInstance()->PostTask(handler, EventLane::MAINTENANCE, task,
+        TASK_PREFETCH_BUNDLE_INFO);
+}
+
 void SystemEventObserver::OnReceiveEventContinuousTask(const EventFwk::CommonEventData &eventData)
 {
     auto handler = handler_.lock();
@@ -96,7 +130,9 @@ void SystemEventObserver::OnReceiveEventContinuousTask(const EventFwk::CommonEve
         auto task = [bgContinuousTaskMgr]() {
             bgContinuousTaskMgr->OnBundleResourcesChanged();
         };
-        handler->PostTask(task, TASK_ON_BUNDLE_RESOURCES_CHANGED);
+        // 语言切换后刷新通知文案属于后台维护，不抢占同步 IPC 请求
+        DelayedSingleton<EventLaneScheduler>::GetInstance()->PostTask(handler, EventLane::MAINTENANCE, task,
+            TASK_ON_BUNDLE_RESOURCES_CHANGED);
         return;
     }
     std::string bundleName = want.GetElement().GetBundleName();
@@ -44,6 +44,7 @@ public:
     void SetUserId(int32_t userId);
     void SetAppIndex(int32_t appIndex);
     std::string ParseToJsonStr();
+    void ParseToJson(nlohmann::json &root);
     bool ParseFromJson(const nlohmann::json &value);
 
 private:
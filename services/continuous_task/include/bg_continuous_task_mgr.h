@@ -26,7 +26,9 @@
 
 #include "bgtaskmgr_inner_errors.h"
 #include "bundle_info.h"
+#include "bundle_info_cache.h"
 #include "continuous_task_callback_info.h"
+#include "continuous_task_control_info.h"
 #ifdef DISTRIBUTED_NOTIFICATION_ENABLE
 #include "task_notification_subscriber.h"
 #endif
@@ -34,17 +36,25 @@
 #include "background_task_mode.h"
 #include "background_common.h"
 #include "continuous_task_param.h"
+#include "continuous_task_batch.h"
+#include "continuous_task_change_log.h"
+#include "continuous_task_table.h"
 #include "continuous_task_record.h"
 #include "continuous_task_request.h"
 #include "background_task_submode.h"
 #include "ibackground_task_subscriber.h"
 #include "remote_death_recipient.h"
+#include "subscriber_dispatcher.h"
+#include "subscriber_event_parcel.h"
+#include "subscriber_registry.h"
 #include "system_event_observer.h"
 #include "want.h"
 #include "banner_notification_record.h"
 #include "iexpired_callback.h"
 #include "background_task_state_info.h"
 #include "dialog_event_observer.h"
+#include "event_lane_scheduler.h"
+#include "lru_cache.h"
 #include "banner_notification_event_observer.h"
 
 namespace OHOS {
@@ -58,6 +68,8 @@ namespace {
 #else
     static constexpr int32_t CANCEL_REASON_DELETE = 2;
 #endif
+    static constexpr size_t MAX_CACHED_BUNDLE_INFO = 128;
+    static constexpr size_t MAX_TASK_CHANGE_LOG_SIZE = 512;
 }
 class BackgroundTaskMgrService;
 class DataStorageHelper;
@@ -71,6 +83,14 @@ enum class ContinuousTaskEventTriggerType: uint32_t {
     TASK_ACTIVE,
 };
 
+// 订阅者按关注的事件分桶，通知时只遍历对应的桶
+enum ContinuousSubscriberBucket : uint32_t {
+    SUBSCRIBER_BUCKET_SA,
+    SUBSCRIBER_BUCKET_HAP,
+    SUBSCRIBER_BUCKET_HAP_STATE,
+    SUBSCRIBER_BUCKET_BUTT,
+};
+
 
 struct CachedBundleInfo {
     std::unordered_map<std::string, uint32_t> abilityBgMode_ {};
@@ -87,6 +107,28 @@ struct SubscriberInfo {
     uint32_t flag_ {0};
 };
 
+struct ContinuousTaskSnapshotEntry {
+    int32_t uid_ {-1};
+    bool suspendState_ {false};
+    std::shared_ptr<ContinuousTaskInfo> taskInfo_ {nullptr};
+    std::shared_ptr<ContinuousTaskCallbackInfo> appInfo_ {nullptr};
+};
+
+struct ContinuousTaskAppsDelta {
+    uint64_t generation {0};
+    bool isFullResync {false};
+    std::vector<std::shared_ptr<ContinuousTaskCallbackInfo>> addedList {};
+    std::vector<std::shared_ptr<ContinuousTaskCallbackInfo>> updatedList {};
+    std::vector<std::shared_ptr<ContinuousTaskCallbackInfo>> removedList {};
+};
+
+// 只读快照，由任务线程整体替换，查询接口在调用线程直接读取
+struct ContinuousTaskSnapshot {
+    uint64_t version_ {0};
+    uint64_t tableGeneration_ {0};
+    std::unordered_map<std::string, std::shared_ptr<const ContinuousTaskSnapshotEntry>> entries_ {};
+};
+
 struct InnerApiReqBgRunningConfig {
     bool needNotification_;
     uint32_t bgModeId_;
@@ -112,6 +154,7 @@ public:
     ErrCode ShellDump(const std::vector<std::string> &dumpOption, std::vector<std::string> &dumpInfo);
     ErrCode GetContinuousTaskApps(std::vector<std::shared_ptr<ContinuousTaskCallbackInfo>> &list, int32_t uid = -1);
     ErrCode GetAllContinuousTaskApps(std::vector<std::shared_ptr<ContinuousTaskCallbackInfo>> &list);
+    ErrCode GetContinuousTaskAppsDelta(uint64_t sinceGeneration, ContinuousTaskAppsDelta &delta);
     ErrCode AVSessionNotifyUpdateNotification(int32_t uid, int32_t pid, bool isPublish = false);
     ErrCode DebugContinuousTaskInner(const sptr<ContinuousTaskParamForInner> &taskParam);
     ErrCode IsModeSupported(const sptr<ContinuousTaskParam> &taskParam);
@@ -141,6 +184,7 @@ public:
     bool Init(const std::shared_ptr<AppExecFwk::EventRunner>& runner);
     void InitNecessaryState();
     void InitRequiredResourceInfo();
+    void LoadDeferredNotificationPrompt();
     void Clear();
     int32_t GetBgTaskUid();
     void StopContinuousTask(int32_t uid, int32_t pid, uint32_t taskType, const std::string &key);
@@ -148,6 +192,9 @@ public:
         int32_t uid, int32_t pid, int32_t reason, const std::string &key, bool isStandby = false);
     void SuspendContinuousAudioTask(int32_t uid);
     void ActiveContinuousTask(int32_t uid, int32_t pid, const std::string &key, bool isStandby = false);
+    void StopContinuousTasks(const std::vector<ContinuousTaskControlInfo> &taskList, uint32_t taskType);
+    void SuspendContinuousTasks(const std::vector<ContinuousTaskControlInfo> &taskList, bool isStandby = false);
+    void ActiveContinuousTasks(const std::vector<ContinuousTaskControlInfo> &taskList, bool isStandby = false);
     void OnRemoveSystemAbility(int32_t systemAbilityId, const std::string& deviceId);
     void HandleRemoveTaskByMode(uint32_t mode);
     void OnBannerNotificationActionButtonClick(const int32_t buttonType, const int32_t uid,
@@ -190,6 +237,19 @@ private:
     ErrCode SendContinuousTaskNotification(std::shared_ptr<ContinuousTaskRecord> &ContinuousTaskRecordPtr);
     ErrCode GetContinuousTaskAppsInner(std::vector<std::shared_ptr<ContinuousTaskCallbackInfo>> &list, int32_t uid,
         bool includeSuspended = false);
+    std::shared_ptr<ContinuousTaskInfo> CreateContinuousTaskInfo(const std::shared_ptr<ContinuousTaskRecord> &record);
+    std::shared_ptr<ContinuousTaskCallbackInfo> CreateContinuousTaskAppInfo(
+        const std::shared_ptr<ContinuousTaskRecord> &record);
+    void PublishTaskSnapshot();
+    void PublishTaskSnapshot(const std::vector<std::string> &changedKeys);
+    void RecordTaskChanges(const std::shared_ptr<const ContinuousTaskSnapshot> &current,
+        const std::shared_ptr<const ContinuousTaskSnapshot> &snapshot);
+    std::shared_ptr<const ContinuousTaskSnapshot> GetTaskSnapshot() const;
+    std::shared_ptr<const ContinuousTaskSnapshot> GetCommittedTaskSnapshot() const;
+    bool GetAllContinuousTasksFromSnapshot(int32_t uid, std::vector<std::shared_ptr<ContinuousTaskInfo>> &list,
+        bool includeSuspended = true, bool exemptUid = false);
+    bool GetContinuousTaskAppsFromSnapshot(std::vector<std::shared_ptr<ContinuousTaskCallbackInfo>> &list,
+        int32_t uid, bool includeSuspended = false);
     ErrCode AVSessionNotifyUpdateNotificationInner(int32_t uid, int32_t pid, bool isPublish = false);
     void RemoveAudioPlaybackDelayTask(int32_t uid);
     ErrCode StopBackgroundRunningByContext(int32_t uid, const std::string &abilityName, int32_t abilityId);
@@ -204,7 +264,7 @@ private:
     bool AddAppNameInfos(const AppExecFwk::BundleInfo &bundleInfo, CachedBundleInfo &cachedBundleInfo);
     bool CheckProcessUidInfo(const std::vector<AppExecFwk::RunningProcessInfo> &allProcesses, int32_t uid);
     uint32_t GetBackgroundModeInfo(int32_t uid, const std::string &abilityName);
-    bool AddAbilityBgModeInfos(const AppExecFwk::BundleInfo &bundleInfo, CachedBundleInfo &cachedBundleInfo);
+    bool AddAbilityBgModeInfos(const BundleMetadata &metadata, CachedBundleInfo &cachedBundleInfo);
     bool RegisterNotificationSubscriber();
     bool RegisterSysCommEventListener();
     bool RegisterDialogClickListener();
@@ -217,15 +277,28 @@ private:
     ErrCode FormatNotificationText(std::string &notificationText, const std::vector<uint32_t> &checkModes,
         const std::string &mergeBlueNotificationText,
         std::vector<std::tuple<Global::Resource::ResourceManager::NapiValueType, std::string>> &jsParams);
+    bool GetCachedMergedNotificationText(const std::vector<uint32_t> &checkModes, std::string &notificationText);
+    void ClearMergedNotificationTextCache();
     ErrCode SingleModeNotificationText(std::string &notificationText, const std::vector<uint32_t> &checkModes,
         const std::string &mergeBlueNotificationText, const std::shared_ptr<ContinuousTaskRecord> record);
     bool FormatBannerNotificationContext(const std::string &appName, std::string &bannerContent);
     bool SetCachedBundleInfo(int32_t uid, int32_t userId, const std::string &bundleName);
+    void RefillCachedBundleInfo(const std::shared_ptr<ContinuousTaskRecord> &record);
     void HandleStopContinuousTask(int32_t uid, int32_t pid, uint32_t taskType, const std::string &key);
+    void HandleStopContinuousTask(int32_t uid, int32_t pid, uint32_t taskType, const std::string &key,
+        ContinuousTaskBatch &batch);
+    void SuspendContinuousTaskInner(int32_t uid, int32_t pid, int32_t reason, const std::string &key,
+        bool isStandby, ContinuousTaskBatch &batch);
     void HandleSuspendContinuousTask(int32_t uid, int32_t pid, int32_t reason, const std::string &key);
+    void HandleSuspendContinuousTask(int32_t uid, int32_t pid, int32_t reason, const std::string &key,
+        ContinuousTaskBatch &batch);
     void HandleSuspendContinuousAudioTask(int32_t uid);
+    void ActiveContinuousTaskInner(int32_t uid, int32_t pid, const std::string &key, bool isStandby,
+        ContinuousTaskBatch &batch);
     void HandleActiveContinuousTask(int32_t uid, int32_t pid, const std::string &key);
+    void HandleActiveContinuousTask(int32_t uid, int32_t pid, const std::string &key, ContinuousTaskBatch &batch);
     void HandleActiveNotification(std::shared_ptr<ContinuousTaskRecord> record);
+    void ReindexTaskRecord(const std::shared_ptr<ContinuousTaskRecord> &record);
     void OnRemoteSubscriberDiedInner(const wptr<IRemoteObject> &object);
     void OnContinuousTaskChanged(const std::shared_ptr<ContinuousTaskRecord> continuousTaskInfo,
         ContinuousTaskEventTriggerType changeEventType);
@@ -243,6 +316,10 @@ private:
     ErrCode CheckSpecialNotificationText(std::string &notificationText,
         const std::shared_ptr<ContinuousTaskRecord> continuousTaskRecord, uint32_t mode);
     int32_t RefreshTaskRecord();
+    int32_t RefreshTaskRecord(const std::string &key);
+    int32_t RefreshTaskRecord(const std::vector<std::string> &keys);
+    void CommitTaskBatch(ContinuousTaskBatch &batch);
+    void CompactTaskRecordDelayed();
     void HandleAppContinuousTaskStop(int32_t uid);
     bool checkPidCondition(const std::vector<AppExecFwk::RunningProcessInfo> &allProcesses, int32_t pid);
     bool checkNotificationCondition(const std::set<std::string> &notificationLabels, const std::string &label);
@@ -250,7 +327,9 @@ private:
     std::string GetMainAbilityLabel(const std::string &bundleName, int32_t userId);
     std::string GetNotificationText(const std::shared_ptr<ContinuousTaskRecord> record);
     void RemoveContinuousTaskRecordByUidAndMode(int32_t uid, uint32_t mode);
+    void RemoveContinuousTaskRecordByUidAndMode(int32_t uid, uint32_t mode, ContinuousTaskBatch &batch);
     void RemoveContinuousTaskRecordByUid(int32_t uid);
+    void RemoveContinuousTaskRecordByUid(int32_t uid, ContinuousTaskBatch &batch);
     void ReclaimProcessMemory(int32_t pid);
     void SetReason(const std::string &mapKey, int32_t reason, int32_t detailedCancelReason = 0);
     uint32_t GetModeNumByTypeIds(const std::vector<uint32_t> &typeIds);
@@ -263,9 +342,14 @@ private:
     void NotifySubscribersTaskActive(const std::shared_ptr<ContinuousTaskCallbackInfo> &continuousTaskCallbackInfo);
     void ReportHisysEvent(ContinuousTaskEventTriggerType changeEventType,
         const std::shared_ptr<ContinuousTaskRecord> &continuousTaskInfo);
+    void DispatchToSubscriber(const std::shared_ptr<SubscriberInfo> &subscriberInfo,
+        ContinuousTaskEventTriggerType type, const std::shared_ptr<ContinuousTaskCallbackInfo> &callbackInfo,
+        const std::shared_ptr<SubscriberEventParcel> &parcel);
     bool CanNotifyHap(const std::shared_ptr<SubscriberInfo> subscriberInfo,
         const std::shared_ptr<ContinuousTaskCallbackInfo> &callbackInfo);
     bool IsExistCallback(int32_t uid, uint32_t type);
+    static sptr<IRemoteObject> GetSubscriberRemote(const std::shared_ptr<SubscriberInfo> &subscriberInfo);
+    static uint32_t GetSubscriberBuckets(const std::shared_ptr<SubscriberInfo> &subscriberInfo);
     ErrCode CheckCombinedTaskNotification(std::shared_ptr<ContinuousTaskRecord> &record, bool &sendNotification);
     bool StopContinuousTaskByUserInner(const std::string &key, bool isSubNotification);
     bool StopBannerContinuousTaskByUserInner(const std::string &label);
@@ -299,8 +383,10 @@ private:
         const std::string &type, const std::shared_ptr<ContinuousTaskRecord> &continuousTaskRecord, int32_t ret);
     void ClearBgOsAccountTask(const std::vector<int32_t> &activatedOsAccountIds);
     ErrCode CancelNotification(const std::shared_ptr<ContinuousTaskRecord> continuousTaskInfo);
-    void HandleSuspendContinuousTaskByStandby(int32_t uid, int32_t pid, int32_t mode, const std::string &key);
-    void HandleActiveContinuousTaskByStandby(int32_t uid, int32_t pid, const std::string &key);
+    void HandleSuspendContinuousTaskByStandby(int32_t uid, int32_t pid, int32_t mode, const std::string &key,
+        ContinuousTaskBatch &batch);
+    void HandleActiveContinuousTaskByStandby(int32_t uid, int32_t pid, const std::string &key,
+        ContinuousTaskBatch &batch);
 
 #ifdef HAS_OS_ACCOUNT_CAR
     void ClearBgOsAccountTaskInCar();
@@ -315,9 +401,16 @@ private:
         const int32_t uid, const std::string &label);
 private:
     std::atomic<bool> isSysReady_ {false};
+    bool isTaskRecordCompactPending_ {false};
     int32_t bgTaskUid_ {-1};
     std::shared_ptr<AppExecFwk::EventHandler> handler_ {nullptr};
-    std::unordered_map<std::string, std::shared_ptr<ContinuousTaskRecord>> continuousTaskInfosMap_ {};
+    std::shared_ptr<EventLaneScheduler> laneScheduler_ {DelayedSingleton<EventLaneScheduler>::GetInstance()};
+    std::shared_ptr<BundleInfoCache> bundleInfoCache_ {DelayedSingleton<BundleInfoCache>::GetInstance()};
+    std::shared_ptr<SubscriberDispatcher> subscriberDispatcher_ {
+        DelayedSingleton<SubscriberDispatcher>::GetInstance()};
+    ContinuousTaskTable continuousTaskInfosMap_ {};
+    std::shared_ptr<const ContinuousTaskSnapshot> taskSnapshot_ {nullptr};
+    ContinuousTaskChangeLog taskChangeLog_ {MAX_TASK_CHANGE_LOG_SIZE};
     std::unordered_map<int32_t, bool> avSessionNotification_ {};
     std::mutex delayTasksMutex_;
     std::unordered_set<int32_t> delayTasks_;
@@ -330,21 +423,25 @@ private:
     std::shared_ptr<SystemEventObserver> systemEventListener_ {nullptr};
     std::shared_ptr<DialogEventObserver> dialogClickListener_ {nullptr};
     std::shared_ptr<BannerNotificationEventObserver> bannerNotificationClickListener_ {nullptr};
-    std::list<std::shared_ptr<SubscriberInfo>> bgTaskSubscribers_ {};
+    SubscriberRegistry<std::shared_ptr<SubscriberInfo>> bgTaskSubscribers_ {SUBSCRIBER_BUCKET_BUTT,
+        GetSubscriberRemote, GetSubscriberBuckets};
     sptr<RemoteDeathRecipient> susriberDeathRecipient_ {nullptr};
-    std::unordered_map<int32_t, CachedBundleInfo> cachedBundleInfos_ {};
+    LruCache<int32_t, CachedBundleInfo> cachedBundleInfos_ {MAX_CACHED_BUNDLE_INFO};
     std::unordered_map<int32_t, std::vector<uint32_t>> applyTaskOnForeground_ {};
     std::unordered_map<std::string, std::shared_ptr<BannerNotificationRecord>> bannerNotificationRecord_ {};
-    std::set<int32_t> appOnForeground_ {};
     std::vector<std::string> continuousTaskText_ {};
     std::vector<std::string> continuousTaskSubText_ {};
     std::vector<std::string> startingTaskText_ {};
     std::vector<std::string> bannerNotificationBtn_ {};
+    // 启动时延后加载通知文案，首次使用或空闲时加载
+    bool notificationPromptDeferred_ {false};
     sptr<AuthExpiredCallbackDeathRecipient> authCallbackDeathRecipient_ {nullptr};
     std::map<std::string, sptr<IExpiredCallback>> expiredCallbackMap_;
     int32_t continuousTaskIdIndex_ = 0;
     std::unordered_set<int32_t> disableRequestUidList_ {};
     std::map<uint32_t, std::pair<std::string, std::string>> modeForNotificationText_ {};
+    std::string mergedNotificationTextLocale_ {""};
+    std::map<std::vector<uint32_t>, std::string> mergedNotificationTexts_ {};
 
     DECLARE_DELAYED_SINGLETON(BgContinuousTaskMgr);
 };
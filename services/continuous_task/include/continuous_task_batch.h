@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FOUNDATION_RESOURCESCHEDULE_BACKGROUND_TASK_MGR_SERVICES_CONTINUOUS_TASK_INCLUDE_CONTINUOUS_TASK_BATCH_H
+#define FOUNDATION_RESOURCESCHEDULE_BACKGROUND_TASK_MGR_SERVICES_CONTINUOUS_TASK_INCLUDE_CONTINUOUS_TASK_BATCH_H
+
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "continuous_task_record.h"
+
+namespace OHOS {
+namespace BackgroundTaskMgr {
+/**
+ * Collects the side effects of a multi-task mutation so that they are applied once at commit:
+ * one persistence write, one deduplicated notification cancel pass and one stop callback per uid.
+ */
+class ContinuousTaskBatch {
+public:
+    /**
+     * @brief Record a task that has been erased from the task map.
+     *
+     * @param key Key of the task in the task map.
+     * @param record The erased task, cancel event is published at commit.
+     */
+    void RemoveTask(const std::string &key, const std::shared_ptr<ContinuousTaskRecord> &record);
+
+    /**
+     * @brief Record a task whose content changed and needs to be persisted.
+     */
+    void UpdateTask(const std::string &key);
+
+    /**
+     * @brief Record a notification to cancel, duplicated and invalid ids are ignored.
+     */
+    void CancelNotification(const std::string &label, int32_t notificationId);
+
+    /**
+     * @brief Record a uid whose continuous task stop needs to be checked.
+     */
+    void StopUid(int32_t uid);
+
+    bool IsEmpty() const;
+    const std::vector<std::shared_ptr<ContinuousTaskRecord>> &GetRemovedTasks() const;
+    const std::vector<std::string> &GetChangedKeys() const;
+    const std::set<std::pair<std::string, int32_t>> &GetNotifications() const;
+    const std::set<int32_t> &GetStoppedUids() const;
+
+private:
+    std::vector<std::shared_ptr<ContinuousTaskRecord>> removedTasks_ {};
+    std::vector<std::string> changedKeys_ {};
+    std::set<std::string> changedKeySet_ {};
+    std::set<std::pair<std::string, int32_t>> notifications_ {};
+    std::set<int32_t> stoppedUids_ {};
+};
+}  // namespace BackgroundTaskMgr
+}  // namespace OHOS
+#endif  // FOUNDATION_RESOURCESCHEDULE_BACKGROUND_TASK_MGR_SERVICES_CONTINUOUS_TASK_INCLUDE_CONTINUOUS_TASK_BATCH_H
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FOUNDATION_RESOURCESCHEDULE_BACKGROUND_TASK_MGR_SERVICES_CONTINUOUS_TASK_INCLUDE_CONTINUOUS_TASK_CHANGE_LOG_H
+#define FOUNDATION_RESOURCESCHEDULE_BACKGROUND_TASK_MGR_SERVICES_CONTINUOUS_TASK_INCLUDE_CONTINUOUS_TASK_CHANGE_LOG_H
+
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "continuous_task_callback_info.h"
+
+namespace OHOS {
+namespace BackgroundTaskMgr {
+enum class ContinuousTaskChangeType : uint8_t {
+    ADDED,
+    UPDATED,
+    REMOVED,
+};
+
+struct ContinuousTaskChange {
+    uint64_t generation {0};
+    ContinuousTaskChangeType type {ContinuousTaskChangeType::UPDATED};
+    // 删除时保存任务最后发布的信息
+    std::shared_ptr<const ContinuousTaskCallbackInfo> removedInfo {nullptr};
+};
+
+/**
+ * Bounded log of the task keys changed by each published snapshot generation. Appended on the task runner
+ * before the snapshot is published and read by delta queries on ipc threads. Once the oldest entries are
+ * trimmed, callers whose generation is older than the trimmed ones have to do a full resync.
+ */
+class ContinuousTaskChangeLog {
+public:
+    explicit ContinuousTaskChangeLog(size_t capacity);
+
+    /**
+     * @brief Drop all changes, callers older than the generation have to do a full resync.
+     */
+    void Reset(uint64_t generation);
+
+    void Append(uint64_t generation, const std::string &key, ContinuousTaskChangeType type,
+        const std::shared_ptr<const ContinuousTaskCallbackInfo> &removedInfo = nullptr);
+
+    /**
+     * @brief Merge the changes of the generations in (since, until] into one net change per key.
+     *
+     * @param since Generation already known by the caller.
+     * @param until Generation of the snapshot the caller reads.
+     * @param changes Net change per key, a task added and removed in the range is omitted.
+     * @return False if changes after since have been trimmed.
+     */
+    bool Collect(uint64_t since, uint64_t until, std::map<std::string, ContinuousTaskChange> &changes);
+
+    size_t size();
+
+private:
+    struct Entry {
+        std::string key {""};
+        ContinuousTaskChange change {};
+    };
+
+    size_t capacity_ {0};
+    uint64_t baseGeneration_ {0};
+    std::deque<Entry> entries_ {};
+    std::mutex mutex_;
+};
+}  // namespace BackgroundTaskMgr
+}  // namespace OHOS
+#endif  // FOUNDATION_RESOURCESCHEDULE_BACKGROUND_TASK_MGR_SERVICES_CONTINUOUS_TASK_INCLUDE_CONTINUOUS_TASK_CHANGE_LOG_H
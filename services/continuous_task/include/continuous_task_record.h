@@ -62,6 +62,7 @@ public:
     int32_t GetContinuousTaskId() const;
     std::shared_ptr<AbilityRuntime::WantAgent::WantAgent> GetWantAgent() const;
     std::string ParseToJsonStr();
+    void ParseToJson(nlohmann::json &root);
     bool ParseFromJson(const nlohmann::json &value);
     std::string ToString(std::vector<uint32_t> &bgmodes);
     bool IsSystem() const;
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FOUNDATION_RESOURCESCHEDULE_BACKGROUND_TASK_MGR_SERVICES_CONTINUOUS_TASK_INCLUDE_CONTINUOUS_TASK_TABLE_H
+#define FOUNDATION_RESOURCESCHEDULE_BACKGROUND_TASK_MGR_SERVICES_CONTINUOUS_TASK_INCLUDE_CONTINUOUS_TASK_TABLE_H
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "continuous_task_record.h"
+
+namespace OHOS {
+namespace BackgroundTaskMgr {
+/**
+ * Owns the continuous task records keyed by task key and keeps hash indexes by uid, notification label,
+ * (uid, abilityId) and continuousTaskId. The container part keeps the unordered_map interface so that
+ * existing iteration code is unchanged. Index hits are verified against the current record, so an entry
+ * written through operator[] or an indexed field changed in place is picked up once the key is reindexed.
+ */
+class ContinuousTaskTable {
+public:
+    using TaskMap = std::unordered_map<std::string, std::shared_ptr<ContinuousTaskRecord>>;
+    using iterator = TaskMap::iterator;
+    using const_iterator = TaskMap::const_iterator;
+
+    iterator begin();
+    iterator end();
+    const_iterator begin() const;
+    const_iterator end() const;
+    size_t size() const;
+    bool empty() const;
+    void clear();
+    iterator find(const std::string &key);
+    const_iterator find(const std::string &key) const;
+    const std::shared_ptr<ContinuousTaskRecord> &at(const std::string &key) const;
+    std::pair<iterator, bool> emplace(const std::string &key, const std::shared_ptr<ContinuousTaskRecord> &record);
+    iterator erase(iterator iter);
+    size_t erase(const std::string &key);
+
+    /**
+     * @brief Access a record slot, the key is reindexed before the next lookup.
+     */
+    std::shared_ptr<ContinuousTaskRecord> &operator[](const std::string &key);
+
+    /**
+     * @brief Replace all records, used when restoring persisted data.
+     */
+    void Reset(TaskMap &&records);
+
+    /**
+     * @brief Refresh the index entries of the key after an indexed field of its record changed.
+     */
+    void Reindex(const std::string &key);
+
+    const TaskMap &GetRecords() const;
+
+    /**
+     * @brief Get the structure generation, bumped on every insert, erase or slot access. Safe to read from any
+     * thread, used to tell whether a published snapshot still matches the table.
+     */
+    uint64_t GetGeneration() const;
+    std::vector<std::string> GetKeysByUid(int32_t uid);
+    std::vector<std::string> GetKeysByNotificationLabel(const std::string &label);
+    std::vector<std::string> GetKeysByAbility(int32_t uid, int32_t abilityId);
+    iterator FindByContinuousTaskId(int32_t continuousTaskId);
+
+private:
+    struct IndexedFields {
+        int32_t uid {0};
+        int32_t abilityId {0};
+        int32_t continuousTaskId {0};
+        std::string notificationLabel {""};
+    };
+    using KeySet = std::unordered_set<std::string>;
+    using RecordMatcher = std::function<bool(const std::shared_ptr<ContinuousTaskRecord> &record)>;
+
+    static uint64_t GetAbilityIndexKey(int32_t uid, int32_t abilityId);
+    void AddIndex(const std::string &key, const std::shared_ptr<ContinuousTaskRecord> &record);
+    void RemoveIndex(const std::string &key);
+    void SyncIndex();
+    std::vector<std::string> CollectKeys(const KeySet &keys, const RecordMatcher &matcher);
+
+    TaskMap records_ {};
+    std::unordered_map<std::string, IndexedFields> indexedFields_ {};
+    std::unordered_map<int32_t, KeySet> uidIndex_ {};
+    std::unordered_map<std::string, KeySet> labelIndex_ {};
+    std::unordered_map<uint64_t, KeySet> abilityIndex_ {};
+    std::unordered_map<int32_t, KeySet> taskIdIndex_ {};
+    KeySet dirtyKeys_ {};
+    std::atomic<uint64_t> generation_ {0};
+};
+}  // namespace BackgroundTaskMgr
+}  // namespace OHOS
+#endif  // FOUNDATION_RESOURCESCHEDULE_BACKGROUND_TASK_MGR_SERVICES_CONTINUOUS_TASK_INCLUDE_CONTINUOUS_TASK_TABLE_H
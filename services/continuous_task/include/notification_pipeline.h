@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FOUNDATION_RESOURCESCHEDULE_BACKGROUND_TASK_MGR_SERVICES_CONTINUOUS_TASK_INCLUDE_NOTIFICATION_PIPELINE_H
+#define FOUNDATION_RESOURCESCHEDULE_BACKGROUND_TASK_MGR_SERVICES_CONTINUOUS_TASK_INCLUDE_NOTIFICATION_PIPELINE_H
+
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include "errors.h"
+#include "event_handler.h"
+#include "singleton.h"
+
+namespace OHOS {
+namespace BackgroundTaskMgr {
+/**
+ * Delivers updates and cancels of published continuous task notifications to the notification service on its own
+ * runner. The first publish of a notification is sent inline by the caller so that a failure reaches the task start.
+ * Requests of one (label, id) are coalesced while queued: a later request replaces an earlier one.
+ */
+class NotificationPipeline {
+public:
+    using Action = std::function<ErrCode()>;
+
+    /**
+     * @brief Queue an update of a published notification.
+     *
+     * @param label Label of the notification.
+     * @param id Id of the notification.
+     * @param action Call to the notification service.
+     */
+    void Publish(const std::string &label, int32_t id, const Action &action);
+
+    /**
+     * @brief Queue a cancel of a notification.
+     */
+    void Cancel(const std::string &label, int32_t id, const Action &action);
+
+    /**
+     * @brief Wait until all queued requests are delivered, used before reading notifications back from the
+     * notification service.
+     */
+    void Flush();
+
+    size_t GetPendingCount();
+    uint64_t GetCoalescedCount();
+
+private:
+    using RequestKey = std::pair<std::string, int32_t>;
+
+    void Enqueue(const RequestKey &key, const Action &action);
+    void Drain();
+
+    std::mutex mutex_;
+    std::list<RequestKey> order_ {};
+    std::map<RequestKey, Action> pending_ {};
+    uint64_t coalescedCount_ {0};
+    std::shared_ptr<AppExecFwk::EventHandler> handler_ {nullptr};
+
+    DECLARE_DELAYED_SINGLETON(NotificationPipeline);
+};
+}  // namespace BackgroundTaskMgr
+}  // namespace OHOS
+#endif  // FOUNDATION_RESOURCESCHEDULE_BACKGROUND_TASK_MGR_SERVICES_CONTINUOUS_TASK_INCLUDE_NOTIFICATION_PIPELINE_H
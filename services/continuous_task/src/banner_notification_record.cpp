@@ -142,6 +142,12 @@ bool BannerNotificationRecord::ParseFromJson(const nlohmann::json &value)
 std::string BannerNotificationRecord::ParseToJsonStr()
 {
     nlohmann::json root;
+    ParseToJson(root);
+    return root.dump(CommonUtils::jsonFormat_);
+}
+
+void BannerNotificationRecord::ParseToJson(nlohmann::json &root)
+{
     root["bundleName"] = bundleName_;
     root["uid"] = uid_;
     root["notificationId"] = notificationId_;
@@ -150,7 +156,6 @@ std::string BannerNotificationRecord::ParseToJsonStr()
     root["authResult"] = authResult_;
     root["userId"] = userId_;
     root["appIndex"] = appIndex_;
-    return root.dump(CommonUtils::jsonFormat_);
 }
 }  // namespace BackgroundTaskMgr
 }  // namespace OHOS
\ No newline at end of file
@@ -16,6 +16,7 @@
 #include "bg_continuous_task_mgr.h"
 #include "background_task_mgr_service.h"
 
+#include <random>
 #include <sstream>
 #include <unistd.h>
 #include <fcntl.h>
@@ -53,6 +54,8 @@
 #include "continuous_task_log.h"
 #include "system_event_observer.h"
 #include "data_storage_helper.h"
+#include "foreground_app_tracker.h"
+#include "init_step_graph.h"
 #ifdef SUPPORT_GRAPHICS
 #include "locale_config.h"
 #endif // SUPPORT_GRAPHICS
@@ -129,6 +132,19 @@ static const std::map<int32_t, InnerApiReqBgRunningConfig> g_innerApiReqBgRunnin
 #endif
 };
 
+static const std::map<ContinuousTaskEventTriggerType, IBackgroundTaskSubscriberIpcCode> g_subscriberIpcCodes = {
+    {ContinuousTaskEventTriggerType::TASK_START,
+        IBackgroundTaskSubscriberIpcCode::COMMAND_ON_CONTINUOUS_TASK_START},
+    {ContinuousTaskEventTriggerType::TASK_UPDATE,
+        IBackgroundTaskSubscriberIpcCode::COMMAND_ON_CONTINUOUS_TASK_UPDATE},
+    {ContinuousTaskEventTriggerType::TASK_CANCEL,
+        IBackgroundTaskSubscriberIpcCode::COMMAND_ON_CONTINUOUS_TASK_STOP},
+    {ContinuousTaskEventTriggerType::TASK_SUSPEND,
+        IBackgroundTaskSubscriberIpcCode::COMMAND_ON_CONTINUOUS_TASK_SUSPEND},
+    {ContinuousTaskEventTriggerType::TASK_ACTIVE,
+        IBackgroundTaskSubscriberIpcCode::COMMAND_ON_CONTINUOUS_TASK_ACTIVE},
+};
+
 static const char *g_btnBannerNotification[] = {
     "btn_allow_time",
     "btn_allow_allowed",
@@ -151,14 +167,19 @@ static constexpr char BGMODE_PERMISSION_SPECIAL_SCENARIO[] = "ohos.permission.KE
 static constexpr char BG_TASK_RES_BUNDLE_NAME[] = "com.ohos.backgroundtaskmgr.resources";
 static constexpr char BG_TASK_SUB_MODE_TYPE[] = "subMode";
 static constexpr char TASK_NOTIFY_AUDIO_PLAYBACK_SEND[] = "TaskNotifyAudioPlaybackSend";
+static constexpr char TASK_COMPACT_TASK_RECORD[] = "TaskCompactTaskRecord";
+static constexpr char CONTINUOUS_SUBSCRIBER_EVENT_KEY[] = "continuous_";
 static constexpr uint32_t SYSTEM_APP_BGMODE_WIFI_INTERACTION = 64;
 static constexpr uint32_t PC_BGMODE_TASK_KEEPING = 256;
 static constexpr uint32_t BGMODE_SPECIAL_SCENARIO_PROCESSING = 4096;
 static constexpr int32_t DELAY_TIME = 2000;
 static constexpr int32_t RECLAIM_MEMORY_DELAY_TIME = 20 * 60 * 1000;
+static constexpr int32_t PRELOAD_NOTIFICATION_PROMPT_DELAY_TIME = 3 * 1000;
+static constexpr int32_t COMPACT_TASK_RECORD_DELAY_TIME = 10 * 1000;
 static constexpr int32_t MAX_DUMP_PARAM_NUMS = 3;
 static constexpr int32_t ILLEGAL_NOTIFICATION_ID = -2;
 static constexpr int32_t MAX_NOTIFICATION_TEXT_TYPE = 3;
+static constexpr size_t MAX_MERGED_NOTIFICATION_TEXT_CACHE = 64;
 static constexpr uint32_t INVALID_BGMODE = 0;
 static constexpr uint32_t BG_MODE_INDEX_HEAD = 1;
 static constexpr uint32_t BGMODE_NUMS = 10;
@@ -168,6 +189,40 @@ static constexpr uint32_t CONTINUOUS_TASK_ACTIVE = 1 << 2;
 static constexpr uint32_t NOTIFY_AUDIO_PLAYBACK_DELAY_TIME = 65 * 1000;
 static constexpr uint32_t ALL_MODES = 0xFF;
 static constexpr uint32_t ABILITY_TASK_MAX_NUM = 10;
+static constexpr uint32_t TASK_GENERATION_EPOCH_SHIFT = 32;
+const std::string INIT_STEP_NOTIFICATION = "NotificationSubscriber";
+const std::string INIT_STEP_COMMON_EVENT = "SysCommEventListener";
+const std::string INIT_STEP_DIALOG_CLICK = "DialogClickListener";
+const std::string INIT_STEP_BANNER_CLICK = "BannerClickListener";
+const std::string INIT_STEP_RESTORE = "PersistenceData";
+const std::string INIT_STEP_READY = "SetReady";
+
+// 代数高位为每次建立快照时随机生成的纪元，低位为快照序号，服务重启后调用方持有的旧代数纪元不匹配，需全量同步
+uint64_t GetInitialTaskGeneration()
+{
+    std::random_device device;
+    uint64_t epoch = 0;
+    while (epoch == 0) {
+        epoch = static_cast<uint32_t>(device());
+    }
+    return (epoch << TASK_GENERATION_EPOCH_SHIFT) | 1;
+}
+
+bool IsSameTaskGenerationEpoch(uint64_t left, uint64_t right)
+{
+    return (left >> TASK_GENERATION_EPOCH_SHIFT) == (right >> TASK_GENERATION_EPOCH_SHIFT);
+}
+
+bool IsSameAppInfo(const ContinuousTaskCallbackInfo &left, const ContinuousTaskCallbackInfo &right)
+{
+    return left.GetTypeId() == right.GetTypeId() && left.GetCreatorUid() == right.GetCreatorUid() &&
+        left.GetCreatorPid() == right.GetCreatorPid() && left.GetAbilityName() == right.GetAbilityName() &&
+        left.IsFromWebview() == right.IsFromWebview() && left.IsBatchApi() == right.IsBatchApi() &&
+        left.GetTypeIds() == right.GetTypeIds() && left.GetAbilityId() == right.GetAbilityId() &&
+        left.GetTokenId() == right.GetTokenId() && left.GetContinuousTaskId() == right.GetContinuousTaskId() &&
+        left.IsByRequestObject() == right.IsByRequestObject() &&
+        left.GetSuspendState() == right.GetSuspendState() && left.GetSuspendReason() == right.GetSuspendReason();
+}
 #ifndef HAS_OS_ACCOUNT_PART
 constexpr int32_t DEFAULT_OS_ACCOUNT_ID = 0; // 0 is the default id when there is no os_account part
 constexpr int32_t UID_TRANSFORM_DIVISOR = 200000;
@@ -208,15 +263,16 @@ bool BgContinuousTaskMgr::Init(const std::shared_ptr<AppExecFwk::EventRunner>& r
     bgTaskUid_ = IPCSkeleton::GetCallingUid();
     BGTASK_LOGI("BgContinuousTaskMgr service uid is: %{public}d", bgTaskUid_);
     IPCSkeleton::SetCallingIdentity(identity);
+    // 初始化结果通过 SetReady 上报，不阻塞服务启动
     auto registerTask = [this]() { this->InitNecessaryState(); };
-    handler_->PostSyncTask(registerTask);
+    handler_->PostTask(registerTask);
     auto self = shared_from_this();
     auto reclaimTask = [self]() {
         if (self) {
             self->ReclaimProcessMemory(getpid());
         }
     };
-    handler_->PostTask(reclaimTask, RECLAIM_MEMORY_DELAY_TIME);
+    laneScheduler_->PostTask(handler_, EventLane::MAINTENANCE, reclaimTask, "", RECLAIM_MEMORY_DELAY_TIME);
     return true;
 }
 
@@ -284,32 +340,39 @@ void BgContinuousTaskMgr::InitNecessaryState()
         handler_->PostTask(task, DELAY_TIME);
         return;
     }
-    if (!RegisterNotificationSubscriber()) {
-        return;
-    }
-    if (!RegisterSysCommEventListener()) {
-        return;
-    }
-    if (!RegisterDialogClickListener()) {
-        return;
-    }
-    if (!RegisterBannerNotificationClickListener()) {
-        return;
-    }
-    InitRequiredResourceInfo();
+    // 各监听的注册相互独立，并行执行；恢复数据访问任务表，在任务线程执行，只需等待通知订阅完成
+    InitStepGraph initGraph("BgContinuousTaskMgr");
+    initGraph.AddStep(INIT_STEP_NOTIFICATION, [this]() { return this->RegisterNotificationSubscriber(); });
+    initGraph.AddStep(INIT_STEP_COMMON_EVENT, [this]() { return this->RegisterSysCommEventListener(); });
+    initGraph.AddStep(INIT_STEP_DIALOG_CLICK, [this]() { return this->RegisterDialogClickListener(); });
+    initGraph.AddStep(INIT_STEP_BANNER_CLICK, [this]() { return this->RegisterBannerNotificationClickListener(); });
+    initGraph.AddStep(INIT_STEP_RESTORE, [this]() {
+        this->InitNotificationText();
+        this->notificationPromptDeferred_ = true;
+        this->HandlePersistenceData();
+        return true;
+    }, {INIT_STEP_NOTIFICATION}, true);
+    initGraph.AddStep(INIT_STEP_READY, [this]() {
+        this->InitRequiredResourceInfo();
+        return true;
+    }, {INIT_STEP_COMMON_EVENT, INIT_STEP_DIALOG_CLICK, INIT_STEP_BANNER_CLICK, INIT_STEP_RESTORE}, true);
+    initGraph.Run();
 }
 
 void BgContinuousTaskMgr::HandlePersistenceData()
 {
     BGTASK_LOGI("service restart, restore data");
-    DelayedSingleton<DataStorageHelper>::GetInstance()->RestoreTaskRecord(continuousTaskInfosMap_);
+    std::unordered_map<std::string, std::shared_ptr<ContinuousTaskRecord>> allRecord;
+    DelayedSingleton<DataStorageHelper>::GetInstance()->RestoreTaskRecord(allRecord);
+    continuousTaskInfosMap_.Reset(std::move(allRecord));
     std::vector<AppExecFwk::RunningProcessInfo> allAppProcessInfos;
     if (!AppMgrHelper::GetInstance()->GetAllRunningProcesses(allAppProcessInfos)) {
         BGTASK_LOGE("get all running process fail.");
         return;
     }
     CheckPersistenceData(allAppProcessInfos);
-    DelayedSingleton<DataStorageHelper>::GetInstance()->RefreshTaskRecord(continuousTaskInfosMap_);
+    PublishTaskSnapshot();
+    DelayedSingleton<DataStorageHelper>::GetInstance()->RefreshTaskRecord(continuousTaskInfosMap_.GetRecords());
     RestoreApplyRecord();
     DelayedSingleton<DataStorageHelper>::GetInstance()->RestoreAuthRecord(bannerNotificationRecord_);
     DelayedSingleton<DataStorageHelper>::GetInstance()->RefreshAuthRecord(bannerNotificationRecord_);
@@ -317,16 +380,14 @@ void BgContinuousTaskMgr::HandlePersistenceData()
 
 void BgContinuousTaskMgr::RestoreApplyRecord()
 {
-    appOnForeground_.clear();
-    std::vector<AppExecFwk::AppStateData> fgApps;
-    if (!AppMgrHelper::GetInstance()->GetForegroundApplications(fgApps)) {
-        BGTASK_LOGE("get foreground app fail.");
-        return;
-    }
-    for (const auto &appStateData : fgApps) {
-        appOnForeground_.insert(appStateData.uid);
-        BGTASK_LOGI("restore apply record, uid: %{public}d on front", appStateData.uid);
+    auto tracker = DelayedSingleton<ForegroundAppTracker>::GetInstance();
+    // 服务先于应用管理上线时尚未同步过前台状态，此处主动同步一次
+    if (!tracker->HasResynced()) {
+        tracker->Resync();
     }
+    tracker->ForEachForegroundUid([](int32_t uid) {
+        BGTASK_LOGI("restore apply record, uid: %{public}d on front", uid);
+    });
     applyTaskOnForeground_.clear();
     for (const auto &task : continuousTaskInfosMap_) {
         if (!task.second) {
@@ -435,14 +496,28 @@ bool BgContinuousTaskMgr::checkNotificationCondition(const std::set<std::string>
 
 void BgContinuousTaskMgr::InitRequiredResourceInfo()
 {
-    InitNotificationText();
-    if (!GetNotificationPrompt()) {
-        BGTASK_LOGW("init required resource info failed");
-    }
-    HandlePersistenceData();
     isSysReady_.store(true);
     DelayedSingleton<BackgroundTaskMgrService>::GetInstance()->SetReady(ServiceReadyState::CONTINUOUS_SERVICE_READY);
     BGTASK_LOGI("SetReady CONTINUOUS_SERVICE_READY");
+    // 通知文案在就绪后空闲时预加载，若此前已有任务需要发通知则在首次使用时加载
+    auto self = shared_from_this();
+    auto preloadTask = [self]() {
+        if (self) {
+            self->LoadDeferredNotificationPrompt();
+        }
+    };
+    laneScheduler_->PostTask(handler_, EventLane::MAINTENANCE, preloadTask, "", PRELOAD_NOTIFICATION_PROMPT_DELAY_TIME);
+}
+
+void BgContinuousTaskMgr::LoadDeferredNotificationPrompt()
+{
+    if (!notificationPromptDeferred_) {
+        return;
+    }
+    notificationPromptDeferred_ = false;
+    if (!GetNotificationPrompt()) {
+        BGTASK_LOGW("init required resource info failed");
+    }
 }
 
 void BgContinuousTaskMgr::InitNotificationText()
@@ -519,6 +594,7 @@ bool BgContinuousTaskMgr::GetNotificationPrompt()
     BgTaskHiTraceChain traceChain(__func__);
     continuousTaskText_.clear();
     continuousTaskSubText_.clear();
+    ClearMergedNotificationTextCache();
     AppExecFwk::BundleInfo bundleInfo;
     if (!BundleManagerHelper::GetInstance()->GetBundleInfo(BG_TASK_RES_BUNDLE_NAME,
         AppExecFwk::BundleFlag::GET_BUNDLE_WITH_ABILITIES, bundleInfo)) {
@@ -669,32 +745,34 @@ bool BgContinuousTaskMgr::SetCachedBundleInfo(int32_t uid, int32_t userId, const
         return true;
     }
     BgTaskHiTraceChain traceChain(__func__);
-    AppExecFwk::BundleInfo bundleInfo;
-    if (!BundleManagerHelper::GetInstance()->GetBundleInfo(bundleName,
-        AppExecFwk::BundleFlag::GET_BUNDLE_WITH_ABILITIES, bundleInfo, userId)) {
+    BundleMetadata metadata;
+    if (!bundleInfoCache_->GetBundleMetadata(bundleName, userId, metadata)) {
         BGTASK_LOGE("get bundle info: %{public}s failure!", bundleName.c_str());
         return false;
     }
 
     CachedBundleInfo cachedBundleInfo = CachedBundleInfo();
     cachedBundleInfo.appName_ = GetMainAbilityLabel(bundleName, userId);
-    if (AddAbilityBgModeInfos(bundleInfo, cachedBundleInfo)) {
+    if (AddAbilityBgModeInfos(metadata, cachedBundleInfo)) {
         cachedBundleInfos_.emplace(uid, cachedBundleInfo);
         return true;
     }
     return false;
 }
 
-bool BgContinuousTaskMgr::AddAbilityBgModeInfos(const AppExecFwk::BundleInfo &bundleInfo,
+void BgContinuousTaskMgr::RefillCachedBundleInfo(const std::shared_ptr<ContinuousTaskRecord> &record)
+{
+    // 缓存按最近使用淘汰，仍有任务的应用被淘汰后按任务记录重新加载
+    SetCachedBundleInfo(record->uid_, record->userId_, record->bundleName_);
+}
+
+bool BgContinuousTaskMgr::AddAbilityBgModeInfos(const BundleMetadata &metadata,
     CachedBundleInfo &cachedBundleInfo)
 {
-    for (auto abilityInfo : bundleInfo.abilityInfos) {
-        if (abilityInfo.backgroundModes != INVALID_BGMODE) {
-            cachedBundleInfo.abilityBgMode_.emplace(abilityInfo.name, abilityInfo.backgroundModes);
-            BGTASK_LOGI("abilityName: %{public}s, abilityNameHash: %{public}s, Background Mode: %{public}u.",
-                abilityInfo.name.c_str(), std::to_string(std::hash<std::string>()(abilityInfo.name)).c_str(),
-                abilityInfo.backgroundModes);
-        }
+    for (const auto &iter : metadata.abilityBgModes) {
+        cachedBundleInfo.abilityBgMode_.emplace(iter.first, iter.second);
+        BGTASK_LOGI("abilityName: %{public}s, abilityNameHash: %{public}s, Background Mode: %{public}u.",
+            iter.first.c_str(), std::to_string(std::hash<std::string>()(iter.first)).c_str(), iter.second);
     }
     if (cachedBundleInfo.abilityBgMode_.empty()) {
         return false;
@@ -789,11 +867,11 @@ ErrCode BgContinuousTaskMgr::AllowUseSpecial(const std::shared_ptr<ContinuousTas
 
 uint32_t BgContinuousTaskMgr::GetBackgroundModeInfo(int32_t uid, const std::string &abilityName)
 {
-    if (cachedBundleInfos_.find(uid) != cachedBundleInfos_.end()) {
-        auto cachedBundleInfo = cachedBundleInfos_.at(uid);
-        if (cachedBundleInfo.abilityBgMode_.find(abilityName) !=
-            cachedBundleInfo.abilityBgMode_.end()) {
-            return cachedBundleInfo.abilityBgMode_.at(abilityName);
+    auto iter = cachedBundleInfos_.find(uid);
+    if (iter != cachedBundleInfos_.end()) {
+        auto modeIter = iter->second.abilityBgMode_.find(abilityName);
+        if (modeIter != iter->second.abilityBgMode_.end()) {
+            return modeIter->second;
         }
     }
     BGTASK_LOGI("get background mode info, uid: %{public}d, abilityName: %{public}s", uid, abilityName.c_str());
@@ -892,9 +970,12 @@ ErrCode BgContinuousTaskMgr::RequestGetContinuousTasksByUidForInner(int32_t uid,
     ErrCode result = ERR_OK;
     HitraceScoped traceScoped(HITRACE_TAG_OHOS,
         "BackgroundTaskManager::ContinuousTask::Service::RequestGetContinuousTasksByUidForInner");
-    handler_->PostSyncTask([this, uid, &list, &result]() {
+    if (GetAllContinuousTasksFromSnapshot(uid, list)) {
+        return ERR_OK;
+    }
+    laneScheduler_->PostSyncTask(handler_, EventLane::IPC, [this, uid, &list, &result]() {
         result = this->GetAllContinuousTasksInner(uid, list);
-        }, AppExecFwk::EventQueue::Priority::HIGH);
+        });
     return result;
 }
 
@@ -930,9 +1011,9 @@ ErrCode BgContinuousTaskMgr::StartBackgroundRunningForInner(const sptr<Continuou
 
     HitraceScoped traceScoped(HITRACE_TAG_OHOS,
         "BackgroundTaskManager::ContinuousTask::Service::StartBackgroundRunningInner");
-    handler_->PostSyncTask([this, continuousTaskRecord, &result]() mutable {
+    laneScheduler_->PostSyncTask(handler_, EventLane::IPC, [this, continuousTaskRecord, &result]() mutable {
         result = this->StartBackgroundRunningInner(continuousTaskRecord);
-        }, AppExecFwk::EventQueue::Priority::HIGH);
+        });
 
     return result;
 }
@@ -980,9 +1061,9 @@ ErrCode BgContinuousTaskMgr::StartBackgroundRunning(const sptr<ContinuousTaskPar
     }
     HitraceScoped traceScoped(HITRACE_TAG_OHOS,
         "BackgroundTaskManager::ContinuousTask::Service::StartBackgroundRunningInner");
-    handler_->PostSyncTask([this, continuousTaskRecord, &result]() mutable {
+    laneScheduler_->PostSyncTask(handler_, EventLane::IPC, [this, continuousTaskRecord, &result]() mutable {
         result = this->StartBackgroundRunningInner(continuousTaskRecord);
-        }, AppExecFwk::EventQueue::Priority::HIGH);
+        });
     taskParam->notificationId_ = continuousTaskRecord->GetNotificationId();
     taskParam->continuousTaskId_ = continuousTaskRecord->continuousTaskId_;
     return result;
@@ -1035,21 +1116,21 @@ ErrCode BgContinuousTaskMgr::UpdateBackgroundRunning(const sptr<ContinuousTaskPa
         "BackgroundTaskManager::ContinuousTask::Service::UpdateBackgroundRunningInner");
     if (taskParam->isByRequestObject_) {
         // 根据任务id更新
-        handler_->PostSyncTask([this, callingUid, taskParam, &result]() {
+        laneScheduler_->PostSyncTask(handler_, EventLane::IPC, [this, callingUid, taskParam, &result]() {
             result = this->UpdateBackgroundRunningByTaskIdInner(callingUid, taskParam);
-            }, AppExecFwk::EventQueue::Priority::HIGH);
+            });
     } else {
         std::string taskInfoMapKey = std::to_string(callingUid) + SEPARATOR + taskParam->abilityName_ + SEPARATOR +
             std::to_string(taskParam->abilityId_);
         auto self = shared_from_this();
-        handler_->PostSyncTask([self, &taskInfoMapKey, &result, taskParam]() mutable {
+        laneScheduler_->PostSyncTask(handler_, EventLane::IPC, [self, &taskInfoMapKey, &result, taskParam]() mutable {
             if (!self) {
                 BGTASK_LOGE("self is null");
                 result = ERR_BGTASK_SERVICE_INNER_ERROR;
                 return;
             }
             result = self->UpdateBackgroundRunningInner(taskInfoMapKey, taskParam);
-            }, AppExecFwk::EventQueue::Priority::HIGH);
+            });
     }
     return result;
 }
@@ -1061,16 +1142,16 @@ ErrCode BgContinuousTaskMgr::UpdateTaskInfo(std::shared_ptr<ContinuousTaskRecord
     if (ret != ERR_OK) {
         return ret;
     }
+    std::string taskInfoMapKey = std::to_string(record->uid_) + SEPARATOR + record->abilityName_ + SEPARATOR +
+        std::to_string(record->abilityId_) + SEPARATOR + std::to_string(record->GetContinuousTaskId());
     if (record->suspendState_) {
-        std::string taskInfoMapKey = std::to_string(record->uid_) + SEPARATOR + record->abilityName_ + SEPARATOR +
-            std::to_string(record->abilityId_) + SEPARATOR + std::to_string(record->GetContinuousTaskId());
         HandleActiveContinuousTask(record->uid_, record->pid_, taskInfoMapKey);
     }
     BGTASK_LOGI("update continuous task success, taskId: %{public}d", record->GetContinuousTaskId());
     OnContinuousTaskChanged(record, ContinuousTaskEventTriggerType::TASK_UPDATE);
     taskParam->notificationId_ = record->GetNotificationId();
     taskParam->continuousTaskId_ = record->GetContinuousTaskId();
-    return RefreshTaskRecord();
+    return RefreshTaskRecord(taskInfoMapKey);
 }
 
 ErrCode BgContinuousTaskMgr::UpdateTaskNotification(std::shared_ptr<ContinuousTaskRecord> record,
@@ -1132,15 +1213,13 @@ ErrCode BgContinuousTaskMgr::UpdateBackgroundRunningByTaskIdInner(int32_t uid,
         BGTASK_LOGE("update task fail, taskId: %{public}d", taskParam->updateTaskId_);
         return ERR_BGTASK_CONTINUOUS_TASKID_INVALID;
     }
-    auto findTask = [continuousTaskId](const auto &target) {
-        return continuousTaskId == target.second->continuousTaskId_ && target.second->isByRequestObject_;
-    };
-    auto findTaskIter = find_if(continuousTaskInfosMap_.begin(), continuousTaskInfosMap_.end(), findTask);
-    if (findTaskIter == continuousTaskInfosMap_.end()) {
+    auto findTaskIter = continuousTaskInfosMap_.FindByContinuousTaskId(continuousTaskId);
+    if (findTaskIter == continuousTaskInfosMap_.end() || !findTaskIter->second->isByRequestObject_) {
         BGTASK_LOGE("uid: %{public}d not have task, taskId: %{public}d", uid, continuousTaskId);
         return ERR_BGTASK_OBJECT_NOT_EXIST;
     }
     auto record = findTaskIter->second;
+    RefillCachedBundleInfo(record);
     uint32_t configuredBgMode = GetBackgroundModeInfo(uid, record->abilityName_);
     ErrCode ret = ERR_OK;
     for (auto it = taskParam->bgModeIds_.begin(); it != taskParam->bgModeIds_.end(); it++) {
@@ -1190,6 +1269,7 @@ ErrCode BgContinuousTaskMgr::UpdateBackgroundRunningInner(const std::string &tas
         !continuousTaskRecord->bgSubModeIds_.empty()) {
         continuousTaskRecord->bgSubModeIds_.clear();
     }
+    RefillCachedBundleInfo(continuousTaskRecord);
     uint32_t configuredBgMode = GetBackgroundModeInfo(continuousTaskRecord->uid_, continuousTaskRecord->abilityName_);
     for (auto it =  taskParam->bgModeIds_.begin(); it != taskParam->bgModeIds_.end(); it++) {
         ErrCode ret = CheckBgmodeType(configuredBgMode, *it, true, continuousTaskRecord);
@@ -1218,18 +1298,15 @@ ErrCode BgContinuousTaskMgr::UpdateBackgroundRunningInner(const std::string &tas
     OnContinuousTaskChanged(continuousTaskRecord, ContinuousTaskEventTriggerType::TASK_UPDATE);
     taskParam->notificationId_ = continuousTaskRecord->GetNotificationId();
     taskParam->continuousTaskId_ = continuousTaskRecord->GetContinuousTaskId();
-    return RefreshTaskRecord();
+    return RefreshTaskRecord(taskInfoMapKey);
 }
 
 ErrCode BgContinuousTaskMgr::CheckAbilityTaskNum(const std::shared_ptr<ContinuousTaskRecord> record)
 {
     uint32_t taskNum = 0;
     int32_t abilityId = record->GetAbilityId();
-    for (const auto &task : continuousTaskInfosMap_) {
-        if (!task.second) {
-            continue;
-        }
-        if (task.second->GetAbilityId() == abilityId && task.second->isByRequestObject_) {
+    for (const auto &key : continuousTaskInfosMap_.GetKeysByAbility(record->GetUid(), abilityId)) {
+        if (continuousTaskInfosMap_.at(key)->isByRequestObject_) {
             taskNum = taskNum + 1;
         }
     }
@@ -1258,7 +1335,7 @@ ErrCode BgContinuousTaskMgr::AllowApplyContinuousTask(const std::shared_ptr<Cont
     }
     // 需要豁免的情况：inner接口或应用在前台
     int32_t uid = record->GetUid();
-    if (record->IsFromWebview() || appOnForeground_.count(uid) > 0) {
+    if (record->IsFromWebview() || DelayedSingleton<ForegroundAppTracker>::GetInstance()->IsUidForeground(uid)) {
         return ERR_OK;
     }
     // 应用退后台前已申请过的类型，外加播音类型
@@ -1270,8 +1347,7 @@ ErrCode BgContinuousTaskMgr::AllowApplyContinuousTask(const std::shared_ptr<Cont
     if (CommonUtils::CheckApplyMode(record->bgModeIds_, checkBgModeIds)) {
         return ERR_OK;
     }
-    // 查询前台应用
-    std::set<int32_t> frontAppList {};
+    // 前台状态由异步的进程事件维护，拒绝前向应用管理查询一次前台应用，避免切前台事件未到达时误拒
     std::vector<AppExecFwk::AppStateData> fgApps;
     if (AppMgrHelper::GetInstance()->GetForegroundApplications(fgApps)) {
         for (const auto &appStateData : fgApps) {
@@ -1377,7 +1453,7 @@ ErrCode BgContinuousTaskMgr::StartBackgroundRunningSubmit(std::shared_ptr<Contin
         continuousTaskRecord->continuousTaskId_, continuousTaskRecord->isByRequestObject_);
     continuousTaskInfosMap_.emplace(taskInfoMapKey, continuousTaskRecord);
     OnContinuousTaskChanged(continuousTaskRecord, ContinuousTaskEventTriggerType::TASK_START);
-    return RefreshTaskRecord();
+    return RefreshTaskRecord(taskInfoMapKey);
 }
 
 ErrCode BgContinuousTaskMgr::CheckCombinedTaskNotification(std::shared_ptr<ContinuousTaskRecord> &recordParam,
@@ -1471,13 +1547,16 @@ ErrCode BgContinuousTaskMgr::SendContinuousTaskNotification(
     std::shared_ptr<ContinuousTaskRecord> &continuousTaskRecord)
 {
     BgTaskHiTraceChain traceChain(__func__);
+    LoadDeferredNotificationPrompt();
     if (continuousTaskText_.empty()) {
         BGTASK_LOGE("get notification prompt info failed, continuousTaskText_ is empty");
         return ERR_BGTASK_NOTIFICATION_VERIFY_FAILED;
     }
     std::string appName {""};
-    if (cachedBundleInfos_.find(continuousTaskRecord->uid_) != cachedBundleInfos_.end()) {
-        appName = cachedBundleInfos_.at(continuousTaskRecord->uid_).appName_;
+    RefillCachedBundleInfo(continuousTaskRecord);
+    auto cachedIter = cachedBundleInfos_.find(continuousTaskRecord->uid_);
+    if (cachedIter != cachedBundleInfos_.end()) {
+        appName = cachedIter->second.appName_;
     }
     if (appName.empty()) {
         BGTASK_LOGE("appName is empty");
@@ -1508,8 +1587,22 @@ ErrCode BgContinuousTaskMgr::SendContinuousTaskNotification(
             return ERR_OK;
         }
     }
-    return NotificationTools::GetInstance()->PublishNotification(continuousTaskRecord,
+    ret = NotificationTools::GetInstance()->PublishNotification(continuousTaskRecord,
         appName, notificationText, bgTaskUid_);
+    ReindexTaskRecord(continuousTaskRecord);
+    return ret;
+}
+
+void BgContinuousTaskMgr::ReindexTaskRecord(const std::shared_ptr<ContinuousTaskRecord> &record)
+{
+    // 发布通知会原地改写已入表记录的通知 label，需刷新该记录的索引，uid 不会原地修改可用于定位
+    for (const auto &key : continuousTaskInfosMap_.GetKeysByUid(record->uid_)) {
+        auto iter = continuousTaskInfosMap_.find(key);
+        if (iter != continuousTaskInfosMap_.end() && iter->second == record) {
+            continuousTaskInfosMap_.Reindex(key);
+            return;
+        }
+    }
 }
 
 void BgContinuousTaskMgr::FilterNotificationMode(const std::shared_ptr<ContinuousTaskRecord> record,
@@ -1543,6 +1636,7 @@ void BgContinuousTaskMgr::FilterNotificationMode(const std::shared_ptr<Continuou
 ErrCode BgContinuousTaskMgr::CheckNotificationText(std::string &notificationText,
     const std::shared_ptr<ContinuousTaskRecord> continuousTaskRecord)
 {
+    LoadDeferredNotificationPrompt();
     if (CheckLiveViewInfo(continuousTaskRecord)) {
         BGTASK_LOGI("LiveView Notification isPublish. uid: %{public}d", continuousTaskRecord->uid_);
         return ERR_OK;
@@ -1617,6 +1711,11 @@ ErrCode BgContinuousTaskMgr::SingleModeNotificationText(std::string &notificatio
 ErrCode BgContinuousTaskMgr::MergeNotificationText(std::string &notificationText,
     const std::vector<uint32_t> &checkModes, const std::string &mergeBlueNotificationText)
 {
+    std::string mergedText {""};
+    if (GetCachedMergedNotificationText(checkModes, mergedText)) {
+        notificationText = mergeBlueNotificationText + mergedText;
+        return ERR_OK;
+    }
     std::vector<std::tuple<Global::Resource::ResourceManager::NapiValueType, std::string>> jsParams;
     for (const auto mode : checkModes) {
         if (modeForNotificationText_.count(mode) == 0) {
@@ -1633,13 +1732,45 @@ ErrCode BgContinuousTaskMgr::MergeNotificationText(std::string &notificationText
             break;
         }
     }
-    ErrCode ret = FormatNotificationText(notificationText, checkModes, mergeBlueNotificationText, jsParams);
+    // 格式化结果与车钥匙前缀无关，缓存不带前缀的文案
+    ErrCode ret = FormatNotificationText(mergedText, checkModes, "", jsParams);
     if (ret != ERR_OK) {
         return ret;
     }
+    if (mergedNotificationTexts_.size() >= MAX_MERGED_NOTIFICATION_TEXT_CACHE) {
+        mergedNotificationTexts_.clear();
+    }
+    mergedNotificationTexts_[checkModes] = mergedText;
+    notificationText = mergeBlueNotificationText + mergedText;
     return ERR_OK;
 }
 
+bool BgContinuousTaskMgr::GetCachedMergedNotificationText(const std::vector<uint32_t> &checkModes,
+    std::string &notificationText)
+{
+    std::string locale {""};
+#ifdef SUPPORT_GRAPHICS
+    locale = Global::I18n::LocaleConfig::GetSystemLanguage();
+#endif // SUPPORT_GRAPHICS
+    if (locale != mergedNotificationTextLocale_) {
+        // 系统语言变化后，之前格式化的文案全部失效
+        ClearMergedNotificationTextCache();
+        mergedNotificationTextLocale_ = locale;
+        return false;
+    }
+    auto iter = mergedNotificationTexts_.find(checkModes);
+    if (iter == mergedNotificationTexts_.end()) {
+        return false;
+    }
+    notificationText = iter->second;
+    return true;
+}
+
+void BgContinuousTaskMgr::ClearMergedNotificationTextCache()
+{
+    mergedNotificationTexts_.clear();
+}
+
 WEAK_FUNC ErrCode BgContinuousTaskMgr::FormatNotificationText(std::string &notificationText,
     const std::vector<uint32_t> &checkModes, const std::string &mergeBlueNotificationText,
     std::vector<std::tuple<Global::Resource::ResourceManager::NapiValueType, std::string>> &jsParams)
@@ -1679,6 +1810,7 @@ WEAK_FUNC ErrCode BgContinuousTaskMgr::FormatNotificationText(std::string &notif
 ErrCode BgContinuousTaskMgr::CheckSpecialNotificationText(std::string &notificationText,
     const std::shared_ptr<ContinuousTaskRecord> continuousTaskRecord, uint32_t mode)
 {
+    LoadDeferredNotificationPrompt();
     if (continuousTaskSubText_.empty()) {
         BGTASK_LOGE("get subMode notification prompt info failed, continuousTaskSubText_ is empty");
         return ERR_BGTASK_NOTIFICATION_VERIFY_FAILED;
@@ -1720,9 +1852,9 @@ ErrCode BgContinuousTaskMgr::StopBackgroundRunningForInner(const sptr<Continuous
 
     HitraceScoped traceScoped(HITRACE_TAG_OHOS,
         "BackgroundTaskManager::ContinuousTask::Service::StopBackgroundRunningInner");
-    handler_->PostSyncTask([this, uid, abilityName, abilityId, &result]() {
+    laneScheduler_->PostSyncTask(handler_, EventLane::IPC, [this, uid, abilityName, abilityId, &result]() {
         result = this->StopBackgroundRunningInner(uid, abilityName, abilityId);
-        }, AppExecFwk::EventQueue::Priority::HIGH);
+        });
 
     return result;
 }
@@ -1742,9 +1874,10 @@ ErrCode BgContinuousTaskMgr::StopBackgroundRunning(const std::string &abilityNam
     ErrCode result = ERR_OK;
     HitraceScoped traceScoped(HITRACE_TAG_OHOS,
         "BackgroundTaskManager::ContinuousTask::Service::StopBackgroundRunningInner");
-    handler_->PostSyncTask([this, callingUid, abilityName, abilityId, continuousTaskId, &result]() {
+    laneScheduler_->PostSyncTask(handler_, EventLane::IPC,
+        [this, callingUid, abilityName, abilityId, continuousTaskId, &result]() {
         result = this->StopBackgroundRunningInner(callingUid, abilityName, abilityId, continuousTaskId);
-        }, AppExecFwk::EventQueue::Priority::HIGH);
+        });
 
     return result;
 }
@@ -1755,24 +1888,18 @@ ErrCode BgContinuousTaskMgr::StopBackgroundRunningInner(int32_t uid, const std::
     BgTaskHiTraceChain traceChain(__func__);
     if (continuousTaskId != -1) {
         // 新接口取消
-        auto findTask = [continuousTaskId](const auto &target) {
-            return continuousTaskId == target.second->continuousTaskId_;
-        };
-        auto findTaskIter = find_if(continuousTaskInfosMap_.begin(), continuousTaskInfosMap_.end(),
-            findTask);
+        auto findTaskIter = continuousTaskInfosMap_.FindByContinuousTaskId(continuousTaskId);
         if (findTaskIter == continuousTaskInfosMap_.end()) {
             BGTASK_LOGE("uid: %{public}d not have task, taskId: %{public}d", uid, continuousTaskId);
             return ERR_BGTASK_OBJECT_NOT_EXIST;
         }
         return StopBackgroundRunningByTask(findTaskIter->second);
     } else {
-        auto findTask = [uid, abilityName, abilityId](const auto &target) {
-            return uid == target.second->uid_ && abilityName == target.second->abilityName_
-                && abilityId == target.second->abilityId_;
+        auto keys = continuousTaskInfosMap_.GetKeysByAbility(uid, abilityId);
+        auto findTask = [this, &abilityName](const std::string &key) {
+            return abilityName == continuousTaskInfosMap_.at(key)->abilityName_;
         };
-        auto findTaskIter = find_if(continuousTaskInfosMap_.begin(), continuousTaskInfosMap_.end(),
-            findTask);
-        if (findTaskIter == continuousTaskInfosMap_.end()) {
+        if (std::none_of(keys.begin(), keys.end(), findTask)) {
             BGTASK_LOGE("uid: %{public}d not have task", uid);
             return ERR_BGTASK_OBJECT_NOT_EXIST;
         }
@@ -1785,14 +1912,11 @@ ErrCode BgContinuousTaskMgr::StopBackgroundRunningByContext(int32_t uid, const s
     int32_t abilityId)
 {
     std::vector<std::shared_ptr<ContinuousTaskRecord>> tasklist {};
-    auto iter = continuousTaskInfosMap_.begin();
-    while (iter != continuousTaskInfosMap_.end()) {
-        if (iter->second->uid_ == uid && iter->second->abilityName_ == abilityName &&
-            iter->second->abilityId_ == abilityId) {
-            auto record = iter->second;
+    for (const auto &key : continuousTaskInfosMap_.GetKeysByAbility(uid, abilityId)) {
+        auto record = continuousTaskInfosMap_.at(key);
+        if (record->abilityName_ == abilityName) {
             tasklist.push_back(record);
         }
-        iter++;
     }
     ErrCode ret = ERR_OK;
     for (const auto &record : tasklist) {
@@ -1811,21 +1935,19 @@ ErrCode BgContinuousTaskMgr::StopBackgroundRunningByTask(const std::shared_ptr<C
         return ERR_BGTASK_CHECK_TASK_PARAM;
     }
     int32_t continuousTaskId = task->GetContinuousTaskId();
-    auto findTask = [continuousTaskId](const auto &target) {
-        return continuousTaskId == target.second->continuousTaskId_;
-    };
-    auto findTaskIter = find_if(continuousTaskInfosMap_.begin(), continuousTaskInfosMap_.end(), findTask);
+    auto findTaskIter = continuousTaskInfosMap_.FindByContinuousTaskId(continuousTaskId);
     if (findTaskIter == continuousTaskInfosMap_.end()) {
         BGTASK_LOGE("no have task, taskId: %{public}d", continuousTaskId);
         return ERR_BGTASK_OBJECT_EXISTS;
     }
     auto record = findTaskIter->second;
+    std::string key = findTaskIter->first;
     OnContinuousTaskChanged(record, ContinuousTaskEventTriggerType::TASK_CANCEL);
     BGTASK_LOGI("remove continuous task success, taskId: %{public}d", continuousTaskId);
     continuousTaskInfosMap_.erase(findTaskIter);
     auto result = CancelNotification(record);
     HandleAppContinuousTaskStop(record->uid_);
-    RefreshTaskRecord();
+    RefreshTaskRecord(key);
     return result;
 }
 
@@ -1838,9 +1960,12 @@ ErrCode BgContinuousTaskMgr::GetAllContinuousTasks(std::vector<std::shared_ptr<C
     }
     HitraceScoped traceScoped(HITRACE_TAG_OHOS,
         "BackgroundTaskManager::ContinuousTask::Service::GetAllContinuousTasks");
-    handler_->PostSyncTask([this, callingUid, &list, &result]() {
+    if (GetAllContinuousTasksFromSnapshot(callingUid, list)) {
+        return ERR_OK;
+    }
+    laneScheduler_->PostSyncTask(handler_, EventLane::IPC, [this, callingUid, &list, &result]() {
         result = this->GetAllContinuousTasksInner(callingUid, list);
-        }, AppExecFwk::EventQueue::Priority::HIGH);
+        });
     return result;
 }
 
@@ -1854,9 +1979,12 @@ ErrCode BgContinuousTaskMgr::GetAllContinuousTasks(
     }
     HitraceScoped traceScoped(HITRACE_TAG_OHOS,
         "BackgroundTaskManager::ContinuousTask::Service::GetAllContinuousTasksIncludeSuspended");
-    handler_->PostSyncTask([this, callingUid, &list, &result, includeSuspended]() {
+    if (GetAllContinuousTasksFromSnapshot(callingUid, list, includeSuspended)) {
+        return ERR_OK;
+    }
+    laneScheduler_->PostSyncTask(handler_, EventLane::IPC, [this, callingUid, &list, &result, includeSuspended]() {
         result = this->GetAllContinuousTasksInner(callingUid, list, includeSuspended);
-        }, AppExecFwk::EventQueue::Priority::HIGH);
+        });
     return result;
 }
 
@@ -1884,34 +2012,47 @@ ErrCode BgContinuousTaskMgr::GetAllContinuousTasksInner(int32_t uid,
         return ERR_OK;
     }
     BGTASK_LOGD("GetAllContinuousTasksInner, includeSuspended: %{public}d", includeSuspended);
-    for (const auto &record : continuousTaskInfosMap_) {
-        if (!record.second) {
-            continue;
+    std::vector<std::shared_ptr<ContinuousTaskRecord>> records;
+    if (exemptUid) {
+        for (const auto &task : continuousTaskInfosMap_) {
+            records.push_back(task.second);
         }
-        if (!exemptUid && record.second->uid_ != uid) {
+    } else {
+        for (const auto &key : continuousTaskInfosMap_.GetKeysByUid(uid)) {
+            records.push_back(continuousTaskInfosMap_.at(key));
+        }
+    }
+    for (const auto &record : records) {
+        if (!record) {
             continue;
         }
-        if (!includeSuspended && record.second->suspendState_) {
+        if (!includeSuspended && record->suspendState_) {
             continue;
         }
-        std::string wantAgentBundleName {"NULL"};
-        std::string wantAgentAbilityName {"NULL"};
-        if (record.second->wantAgentInfo_ != nullptr) {
-            wantAgentBundleName = record.second->wantAgentInfo_->bundleName_;
-            wantAgentAbilityName = record.second->wantAgentInfo_->abilityName_;
-        }
-        auto info = std::make_shared<ContinuousTaskInfo>(record.second->abilityName_, record.second->uid_,
-            record.second->pid_, record.second->isFromWebview_, record.second->bgModeIds_, record.second->bgSubModeIds_,
-            record.second->notificationId_, record.second->continuousTaskId_, record.second->abilityId_,
-            wantAgentBundleName, wantAgentAbilityName);
-        info->SetBundleName(record.second->bundleName_);
-        info->SetAppIndex(record.second->appIndex_);
-        info->SetByRequestObject(record.second->isByRequestObject_);
-        list.push_back(info);
+        list.push_back(CreateContinuousTaskInfo(record));
     }
     return ERR_OK;
 }
 
+std::shared_ptr<ContinuousTaskInfo> BgContinuousTaskMgr::CreateContinuousTaskInfo(
+    const std::shared_ptr<ContinuousTaskRecord> &record)
+{
+    std::string wantAgentBundleName {"NULL"};
+    std::string wantAgentAbilityName {"NULL"};
+    if (record->wantAgentInfo_ != nullptr) {
+        wantAgentBundleName = record->wantAgentInfo_->bundleName_;
+        wantAgentAbilityName = record->wantAgentInfo_->abilityName_;
+    }
+    auto info = std::make_shared<ContinuousTaskInfo>(record->abilityName_, record->uid_,
+        record->pid_, record->isFromWebview_, record->bgModeIds_, record->bgSubModeIds_,
+        record->notificationId_, record->continuousTaskId_, record->abilityId_,
+        wantAgentBundleName, wantAgentAbilityName);
+    info->SetBundleName(record->bundleName_);
+    info->SetAppIndex(record->appIndex_);
+    info->SetByRequestObject(record->isByRequestObject_);
+    return info;
+}
+
 void BgContinuousTaskMgr::StopContinuousTask(int32_t uid, int32_t pid, uint32_t taskType, const std::string &key)
 {
     if (!isSysReady_.load()) {
@@ -1927,28 +2068,72 @@ void BgContinuousTaskMgr::StopContinuousTask(int32_t uid, int32_t pid, uint32_t
     handler_->PostTask(task);
 }
 
+void BgContinuousTaskMgr::StopContinuousTasks(const std::vector<ContinuousTaskControlInfo> &taskList,
+    uint32_t taskType)
+{
+    if (!isSysReady_.load()) {
+        BGTASK_LOGW("manager is not ready");
+        return;
+    }
+    auto self = shared_from_this();
+    auto task = [self, taskList, taskType]() {
+        if (!self) {
+            return;
+        }
+        BGTASK_LOGI("StopContinuousTasks size: %{public}zu, taskType: %{public}u", taskList.size(), taskType);
+        ContinuousTaskBatch batch;
+        for (const auto &info : taskList) {
+            self->HandleStopContinuousTask(info.GetUid(), info.GetPid(), taskType, info.GetKey(), batch);
+        }
+        self->CommitTaskBatch(batch);
+    };
+    handler_->PostTask(task);
+}
+
 void BgContinuousTaskMgr::HandleStopContinuousTask(int32_t uid, int32_t pid, uint32_t taskType, const std::string &key)
+{
+    ContinuousTaskBatch batch;
+    HandleStopContinuousTask(uid, pid, taskType, key, batch);
+    CommitTaskBatch(batch);
+}
+
+void BgContinuousTaskMgr::HandleStopContinuousTask(int32_t uid, int32_t pid, uint32_t taskType,
+    const std::string &key, ContinuousTaskBatch &batch)
 {
     BGTASK_LOGI("StopContinuousTask taskType: %{public}d, key %{public}s", taskType, key.c_str());
     if (taskType == BackgroundMode::DATA_TRANSFER) {
-        RemoveContinuousTaskRecordByUidAndMode(uid, taskType);
+        RemoveContinuousTaskRecordByUidAndMode(uid, taskType, batch);
         return;
     }
     if (taskType == ALL_MODES) {
-        RemoveContinuousTaskRecordByUid(uid);
+        RemoveContinuousTaskRecordByUid(uid, batch);
         return;
     }
-    if (continuousTaskInfosMap_.find(key) == continuousTaskInfosMap_.end()) {
+    auto iter = continuousTaskInfosMap_.find(key);
+    if (iter == continuousTaskInfosMap_.end()) {
         return;
     }
-    auto record = continuousTaskInfosMap_.at(key);
+    auto record = iter->second;
     int32_t detailedCancelReason_ = ContinuousTaskCancelReason::INVALID_REASON;
     if (record->bgModeIds_.size() > 0) {
         /* 多类型时，返回第一个类型对应的检测失败原因 */
         detailedCancelReason_ = BackgroundMode::GetDetailedCancelReasonFromMode(record->bgModeIds_[0]);
     }
     SetReason(key, FREEZE_CANCEL, detailedCancelReason_);
-    StopBackgroundRunningByTask(record);
+    BGTASK_LOGI("remove continuous task success, taskId: %{public}d", record->GetContinuousTaskId());
+    continuousTaskInfosMap_.erase(iter);
+    // 与剩余任务共用的通知不取消
+    auto keys = continuousTaskInfosMap_.GetKeysByNotificationLabel(record->GetNotificationLabel());
+    bool isNotificationShared = std::any_of(keys.begin(), keys.end(), [this, &record](const std::string &taskKey) {
+        return continuousTaskInfosMap_.at(taskKey)->notificationId_ == record->GetNotificationId();
+    });
+    if (!isNotificationShared) {
+        batch.CancelNotification(record->GetNotificationLabel(), record->GetNotificationId());
+        if (record->GetSubNotificationId() != -1 && record->isByRequestObject_) {
+            batch.CancelNotification(record->GetSubNotificationLabel(), record->GetSubNotificationId());
+        }
+    }
+    batch.RemoveTask(key, record);
 }
 
 void BgContinuousTaskMgr::SuspendContinuousTask(
@@ -1963,27 +2148,58 @@ void BgContinuousTaskMgr::SuspendContinuousTask(
         if (!self) {
             return;
         }
-        bool hasCallback = self->IsExistCallback(uid, CONTINUOUS_TASK_SUSPEND);
-        if (isStandby) {
-            if (hasCallback) {
-                self->HandleSuspendContinuousTaskByStandby(uid, pid, reason, key);
-            }
+        ContinuousTaskBatch batch;
+        self->SuspendContinuousTaskInner(uid, pid, reason, key, isStandby, batch);
+        self->CommitTaskBatch(batch);
+    };
+    handler_->PostTask(task);
+}
+
+void BgContinuousTaskMgr::SuspendContinuousTasks(const std::vector<ContinuousTaskControlInfo> &taskList,
+    bool isStandby)
+{
+    if (!isSysReady_.load()) {
+        BGTASK_LOGW("manager is not ready");
+        return;
+    }
+    auto self = shared_from_this();
+    auto task = [self, taskList, isStandby]() {
+        if (!self) {
             return;
         }
-        if (hasCallback) {
-            self->HandleSuspendContinuousTask(uid, pid, reason, key);
-        } else {
-            self->HandleStopContinuousTask(uid, pid, 0, key);
+        BGTASK_LOGI("SuspendContinuousTasks size: %{public}zu, isStandby: %{public}d", taskList.size(), isStandby);
+        ContinuousTaskBatch batch;
+        for (const auto &info : taskList) {
+            self->SuspendContinuousTaskInner(info.GetUid(), info.GetPid(), info.GetReason(), info.GetKey(),
+                isStandby, batch);
         }
+        self->CommitTaskBatch(batch);
     };
     handler_->PostTask(task);
 }
 
+void BgContinuousTaskMgr::SuspendContinuousTaskInner(int32_t uid, int32_t pid, int32_t reason,
+    const std::string &key, bool isStandby, ContinuousTaskBatch &batch)
+{
+    bool hasCallback = IsExistCallback(uid, CONTINUOUS_TASK_SUSPEND);
+    if (isStandby) {
+        if (hasCallback) {
+            HandleSuspendContinuousTaskByStandby(uid, pid, reason, key, batch);
+        }
+        return;
+    }
+    if (hasCallback) {
+        HandleSuspendContinuousTask(uid, pid, reason, key, batch);
+    } else {
+        HandleStopContinuousTask(uid, pid, 0, key, batch);
+    }
+}
+
 bool BgContinuousTaskMgr::IsExistCallback(int32_t uid, uint32_t type)
 {
-    for (auto iter = bgTaskSubscribers_.begin(); iter != bgTaskSubscribers_.end(); ++iter) {
-        if ((*iter)->isHap_ && (*iter)->uid_ == uid && (((*iter)->flag_ & type) > 0)) {
-            BGTASK_LOGD("flag: %{public}u", (*iter)->flag_);
+    for (const auto &subscriberInfo : bgTaskSubscribers_.GetBucket(SUBSCRIBER_BUCKET_HAP)) {
+        if (subscriberInfo->uid_ == uid && ((subscriberInfo->flag_ & type) > 0)) {
+            BGTASK_LOGD("flag: %{public}u", subscriberInfo->flag_);
             return true;
         }
     }
@@ -1992,16 +2208,20 @@ bool BgContinuousTaskMgr::IsExistCallback(int32_t uid, uint32_t type)
 
 void BgContinuousTaskMgr::HandleSuspendContinuousTask(int32_t uid, int32_t pid, int32_t mode, const std::string &key)
 {
-    if (continuousTaskInfosMap_.find(key) == continuousTaskInfosMap_.end()) {
+    ContinuousTaskBatch batch;
+    HandleSuspendContinuousTask(uid, pid, mode, key, batch);
+    CommitTaskBatch(batch);
+}
+
+void BgContinuousTaskMgr::HandleSuspendContinuousTask(int32_t uid, int32_t pid, int32_t mode,
+    const std::string &key, ContinuousTaskBatch &batch)
+{
+    auto iter = continuousTaskInfosMap_.find(key);
+    if (iter == continuousTaskInfosMap_.end()) {
         BGTASK_LOGW("suspend TaskInfo failure, no matched task: %{public}s", key.c_str());
         return;
     }
-    auto iter = continuousTaskInfosMap_.begin();
-    while (iter != continuousTaskInfosMap_.end()) {
-        if (iter->second->GetUid() != uid || iter->first != key) {
-            ++iter;
-            continue;
-        }
+    if (iter->second != nullptr && iter->second->GetUid() == uid) {
         BGTASK_LOGW("SuspendContinuousTask mode: %{public}d, key %{public}s", mode, key.c_str());
         iter->second->suspendState_ = true;
         iter->second->isStandby_ = false;
@@ -2012,26 +2232,22 @@ void BgContinuousTaskMgr::HandleSuspendContinuousTask(int32_t uid, int32_t pid,
             iter->second->suspendReason_ = static_cast<int32_t>(reasonValue);
         }
         OnContinuousTaskChanged(iter->second, ContinuousTaskEventTriggerType::TASK_SUSPEND);
-        RefreshTaskRecord();
-        break;
+        batch.UpdateTask(key);
     }
     // 暂停状态取消长时任务通知
-    if (continuousTaskInfosMap_[key] != nullptr) {
-        auto record = continuousTaskInfosMap_[key];
-        NotificationTools::GetInstance()->CancelNotification(record->GetNotificationLabel(),
-            record->GetNotificationId());
-        int32_t subNotificationId = record->GetSubNotificationId();
-        if (subNotificationId != -1 && record->isByRequestObject_) {
-            std::string subNotificationLabel = record->GetSubNotificationLabel();
-            NotificationTools::GetInstance()->CancelNotification(subNotificationLabel, subNotificationId);
+    if (iter->second != nullptr) {
+        auto record = iter->second;
+        batch.CancelNotification(record->GetNotificationLabel(), record->GetNotificationId());
+        if (record->GetSubNotificationId() != -1 && record->isByRequestObject_) {
+            batch.CancelNotification(record->GetSubNotificationLabel(), record->GetSubNotificationId());
         }
     }
     // 对SA来说，暂停状态等同于取消
-    HandleAppContinuousTaskStop(uid);
+    batch.StopUid(uid);
 }
 
 void BgContinuousTaskMgr::HandleSuspendContinuousTaskByStandby(
-    int32_t uid, int32_t pid, int32_t mode, const std::string &key)
+    int32_t uid, int32_t pid, int32_t mode, const std::string &key, ContinuousTaskBatch &batch)
 {
     auto iter = continuousTaskInfosMap_.find(key);
     if (iter == continuousTaskInfosMap_.end()) {
@@ -2050,7 +2266,7 @@ void BgContinuousTaskMgr::HandleSuspendContinuousTaskByStandby(
     uint32_t reasonValue = ContinuousTaskSuspendReason::GetSuspendReasonValue(mode, true);
     taskInfo->suspendReason_ = (reasonValue == 0) ? -1 : static_cast<int32_t>(reasonValue);
     OnContinuousTaskChanged(taskInfo, ContinuousTaskEventTriggerType::TASK_SUSPEND);
-    RefreshTaskRecord();
+    batch.UpdateTask(key);
 }
 
 void BgContinuousTaskMgr::ActiveContinuousTask(int32_t uid, int32_t pid, const std::string &key, bool isStandby)
@@ -2064,33 +2280,67 @@ void BgContinuousTaskMgr::ActiveContinuousTask(int32_t uid, int32_t pid, const s
         if (!self) {
             return;
         }
-        if (isStandby) {
-            if (self->IsExistCallback(uid, CONTINUOUS_TASK_ACTIVE)) {
-                self->HandleActiveContinuousTaskByStandby(uid, pid, key);
-            }
+        ContinuousTaskBatch batch;
+        self->ActiveContinuousTaskInner(uid, pid, key, isStandby, batch);
+        self->CommitTaskBatch(batch);
+    };
+    handler_->PostTask(task);
+}
+
+void BgContinuousTaskMgr::ActiveContinuousTasks(const std::vector<ContinuousTaskControlInfo> &taskList,
+    bool isStandby)
+{
+    if (!isSysReady_.load()) {
+        BGTASK_LOGW("manager is not ready");
+        return;
+    }
+    auto self = shared_from_this();
+    auto task = [self, taskList, isStandby]() {
+        if (!self) {
             return;
         }
-        self->HandleActiveContinuousTask(uid, pid, key);
+        BGTASK_LOGI("ActiveContinuousTasks size: %{public}zu, isStandby: %{public}d", taskList.size(), isStandby);
+        ContinuousTaskBatch batch;
+        // 同一应用的任务按 uid 整体激活，只处理一次
+        std::set<int32_t> activatedUids;
+        for (const auto &info : taskList) {
+            if (activatedUids.insert(info.GetUid()).second) {
+                self->ActiveContinuousTaskInner(info.GetUid(), info.GetPid(), info.GetKey(), isStandby, batch);
+            }
+        }
+        self->CommitTaskBatch(batch);
     };
     handler_->PostTask(task);
 }
 
-void BgContinuousTaskMgr::HandleActiveContinuousTask(int32_t uid, int32_t pid, const std::string &key)
+void BgContinuousTaskMgr::ActiveContinuousTaskInner(int32_t uid, int32_t pid, const std::string &key,
+    bool isStandby, ContinuousTaskBatch &batch)
 {
-    auto findTask = [uid](const auto &target) {
-        return uid == target.second->uid_ && target.second->suspendState_;
-    };
-    auto findTaskIter = find_if(continuousTaskInfosMap_.begin(), continuousTaskInfosMap_.end(), findTask);
-    if (findTaskIter == continuousTaskInfosMap_.end()) {
+    if (isStandby) {
+        if (IsExistCallback(uid, CONTINUOUS_TASK_ACTIVE)) {
+            HandleActiveContinuousTaskByStandby(uid, pid, key, batch);
+        }
         return;
     }
+    HandleActiveContinuousTask(uid, pid, key, batch);
+}
+
+void BgContinuousTaskMgr::HandleActiveContinuousTask(int32_t uid, int32_t pid, const std::string &key)
+{
+    ContinuousTaskBatch batch;
+    HandleActiveContinuousTask(uid, pid, key, batch);
+    CommitTaskBatch(batch);
+}
+
+void BgContinuousTaskMgr::HandleActiveContinuousTask(int32_t uid, int32_t pid, const std::string &key,
+    ContinuousTaskBatch &batch)
+{
     std::string notificationLabel = "default";
     int32_t notificationId = ILLEGAL_NOTIFICATION_ID;
     std::vector<int32_t> notificationOldIds {};
-    auto iter = continuousTaskInfosMap_.begin();
-    while (iter != continuousTaskInfosMap_.end()) {
-        if (iter->second->GetUid() != uid || !iter->second->suspendState_) {
-            ++iter;
+    for (const auto &taskKey : continuousTaskInfosMap_.GetKeysByUid(uid)) {
+        auto iter = continuousTaskInfosMap_.find(taskKey);
+        if (!iter->second->suspendState_) {
             continue;
         }
         BGTASK_LOGI("ActiveContinuousTask uid: %{public}d, pid: %{public}d", uid, pid);
@@ -2108,22 +2358,25 @@ void BgContinuousTaskMgr::HandleActiveContinuousTask(int32_t uid, int32_t pid, c
                 iter->second->notificationLabel_ = notificationLabel;
                 iter->second->notificationId_ = notificationId;
             }
+            continuousTaskInfosMap_.Reindex(taskKey);
         }
-        RefreshTaskRecord();
+        batch.UpdateTask(taskKey);
     }
 }
 
-void BgContinuousTaskMgr::HandleActiveContinuousTaskByStandby(int32_t uid, int32_t pid, const std::string &key)
+void BgContinuousTaskMgr::HandleActiveContinuousTaskByStandby(int32_t uid, int32_t pid, const std::string &key,
+    ContinuousTaskBatch &batch)
 {
-    for (auto &iter : continuousTaskInfosMap_) {
-        if (iter.second->GetUid() != uid || !iter.second->isStandbySuspend_) {
+    for (const auto &taskKey : continuousTaskInfosMap_.GetKeysByUid(uid)) {
+        auto record = continuousTaskInfosMap_.at(taskKey);
+        if (!record->isStandbySuspend_) {
             continue;
         }
         BGTASK_LOGI("HandleActiveContinuousTaskByStandby uid: %{public}d, pid: %{public}d", uid, pid);
-        iter.second->isStandby_ = true;
-        iter.second->isStandbySuspend_ = false;
-        OnContinuousTaskChanged(iter.second, ContinuousTaskEventTriggerType::TASK_ACTIVE);
-        RefreshTaskRecord();
+        record->isStandby_ = true;
+        record->isStandbySuspend_ = false;
+        OnContinuousTaskChanged(record, ContinuousTaskEventTriggerType::TASK_ACTIVE);
+        batch.UpdateTask(taskKey);
     }
 }
 
@@ -2142,56 +2395,54 @@ void BgContinuousTaskMgr::HandleActiveNotification(std::shared_ptr<ContinuousTas
 
 void BgContinuousTaskMgr::RemoveContinuousTaskRecordByUid(int32_t uid)
 {
-    auto iter = continuousTaskInfosMap_.begin();
-    while (iter != continuousTaskInfosMap_.end()) {
-        if (iter->second->GetUid() != uid) {
-            ++iter;
-            continue;
-        }
+    ContinuousTaskBatch batch;
+    RemoveContinuousTaskRecordByUid(uid, batch);
+    CommitTaskBatch(batch);
+}
+
+void BgContinuousTaskMgr::RemoveContinuousTaskRecordByUid(int32_t uid, ContinuousTaskBatch &batch)
+{
+    for (const auto &key : continuousTaskInfosMap_.GetKeysByUid(uid)) {
+        auto iter = continuousTaskInfosMap_.find(key);
         BGTASK_LOGW("erase key %{public}s", iter->first.c_str());
         iter->second->reason_ = FREEZE_CANCEL;
         iter->second->detailedCancelReason_ = ContinuousTaskCancelReason::SYSTEM_CANCEL_USE_ILLEGALLY;
-        OnContinuousTaskChanged(iter->second, ContinuousTaskEventTriggerType::TASK_CANCEL);
-        NotificationTools::GetInstance()->CancelNotification(iter->second->GetNotificationLabel(),
-            iter->second->GetNotificationId());
-        int32_t subNotificationId = iter->second->GetSubNotificationId();
-        if (subNotificationId != -1 && iter->second->isByRequestObject_) {
-            std::string subNotificationLabel = iter->second->GetSubNotificationLabel();
-            NotificationTools::GetInstance()->CancelNotification(subNotificationLabel, subNotificationId);
+        batch.CancelNotification(iter->second->GetNotificationLabel(), iter->second->GetNotificationId());
+        if (iter->second->GetSubNotificationId() != -1 && iter->second->isByRequestObject_) {
+            batch.CancelNotification(iter->second->GetSubNotificationLabel(), iter->second->GetSubNotificationId());
         }
-        iter = continuousTaskInfosMap_.erase(iter);
-        RefreshTaskRecord();
+        batch.RemoveTask(iter->first, iter->second);
+        continuousTaskInfosMap_.erase(iter);
     }
-    HandleAppContinuousTaskStop(uid);
+    batch.StopUid(uid);
 }
 
 void BgContinuousTaskMgr::RemoveContinuousTaskRecordByUidAndMode(int32_t uid, uint32_t mode)
 {
-    auto iter = continuousTaskInfosMap_.begin();
-    while (iter != continuousTaskInfosMap_.end()) {
-        if (iter->second->GetUid() != uid) {
-            ++iter;
-            continue;
-        }
+    ContinuousTaskBatch batch;
+    RemoveContinuousTaskRecordByUidAndMode(uid, mode, batch);
+    CommitTaskBatch(batch);
+}
+
+void BgContinuousTaskMgr::RemoveContinuousTaskRecordByUidAndMode(int32_t uid, uint32_t mode,
+    ContinuousTaskBatch &batch)
+{
+    for (const auto &key : continuousTaskInfosMap_.GetKeysByUid(uid)) {
+        auto iter = continuousTaskInfosMap_.find(key);
         auto findModeIter = std::find(iter->second->bgModeIds_.begin(), iter->second->bgModeIds_.end(), mode);
         if (findModeIter == iter->second->bgModeIds_.end()) {
-            ++iter;
             continue;
         }
         iter->second->reason_ = FREEZE_CANCEL;
         iter->second->detailedCancelReason_ = BackgroundMode::GetDetailedCancelReasonFromMode(mode);
-        OnContinuousTaskChanged(iter->second, ContinuousTaskEventTriggerType::TASK_CANCEL);
-        NotificationTools::GetInstance()->CancelNotification(iter->second->GetNotificationLabel(),
-            iter->second->GetNotificationId());
-        int32_t subNotificationId = iter->second->GetSubNotificationId();
-        if (subNotificationId != -1 && iter->second->isByRequestObject_) {
-            std::string subNotificationLabel = iter->second->GetSubNotificationLabel();
-            NotificationTools::GetInstance()->CancelNotification(subNotificationLabel, subNotificationId);
+        batch.CancelNotification(iter->second->GetNotificationLabel(), iter->second->GetNotificationId());
+        if (iter->second->GetSubNotificationId() != -1 && iter->second->isByRequestObject_) {
+            batch.CancelNotification(iter->second->GetSubNotificationLabel(), iter->second->GetSubNotificationId());
         }
-        iter = continuousTaskInfosMap_.erase(iter);
-        RefreshTaskRecord();
+        batch.RemoveTask(iter->first, iter->second);
+        continuousTaskInfosMap_.erase(iter);
     }
-    HandleAppContinuousTaskStop(uid);
+    batch.StopUid(uid);
 }
 
 ErrCode BgContinuousTaskMgr::AddSubscriber(const std::shared_ptr<SubscriberInfo> subscriberInfo)
@@ -2201,24 +2452,42 @@ ErrCode BgContinuousTaskMgr::AddSubscriber(const std::shared_ptr<SubscriberInfo>
         BGTASK_LOGE("subscriber is null.");
         return ERR_BGTASK_INVALID_PARAM;
     }
-    handler_->PostSyncTask([=]() {
+    laneScheduler_->PostSyncTask(handler_, EventLane::IPC, [=]() {
         AddSubscriberInner(subscriberInfo);
     });
     return ERR_OK;
 }
 
+sptr<IRemoteObject> BgContinuousTaskMgr::GetSubscriberRemote(const std::shared_ptr<SubscriberInfo> &subscriberInfo)
+{
+    if (subscriberInfo == nullptr || subscriberInfo->subscriber_ == nullptr) {
+        return nullptr;
+    }
+    return subscriberInfo->subscriber_->AsObject();
+}
+
+uint32_t BgContinuousTaskMgr::GetSubscriberBuckets(const std::shared_ptr<SubscriberInfo> &subscriberInfo)
+{
+    if (!subscriberInfo->isHap_) {
+        return 1u << SUBSCRIBER_BUCKET_SA;
+    }
+    uint32_t buckets = 1u << SUBSCRIBER_BUCKET_HAP;
+    if ((subscriberInfo->flag_ & SUBSCRIBER_BACKGROUND_TASK_STATE) > 0) {
+        buckets |= 1u << SUBSCRIBER_BUCKET_HAP_STATE;
+    }
+    return buckets;
+}
+
 ErrCode BgContinuousTaskMgr::AddSubscriberInner(const std::shared_ptr<SubscriberInfo> subscriberInfo)
 {
     BGTASK_LOGD("BgContinuousTaskMgr enter");
     auto remoteObj = subscriberInfo->subscriber_->AsObject();
-    auto findSuscriber = [&remoteObj](const auto& target) {
-        return remoteObj == target->subscriber_->AsObject();
-    };
-    auto subscriberIter = find_if(bgTaskSubscribers_.begin(), bgTaskSubscribers_.end(), findSuscriber);
+    auto subscriberIter = bgTaskSubscribers_.find(remoteObj);
     if (subscriberIter != bgTaskSubscribers_.end()) {
         BGTASK_LOGW("target subscriber already exist");
         if ((*subscriberIter)->isHap_) {
             (*subscriberIter)->flag_ = (*subscriberIter)->flag_ |= subscriberInfo->flag_;
+            bgTaskSubscribers_.Reclassify();
             BGTASK_LOGW("update subscriber success, current flag: %{public}d", (*subscriberIter)->flag_);
         }
         return ERR_BGTASK_OBJECT_EXISTS;
@@ -2240,7 +2509,7 @@ ErrCode BgContinuousTaskMgr::RemoveSubscriber(const sptr<IBackgroundTaskSubscrib
         BGTASK_LOGE("subscriber is null.");
         return ERR_BGTASK_INVALID_PARAM;
     }
-    handler_->PostSyncTask([=]() {
+    laneScheduler_->PostSyncTask(handler_, EventLane::IPC, [=]() {
         RemoveSubscriberInner(subscriber, flag);
     });
     return ERR_OK;
@@ -2253,16 +2522,14 @@ ErrCode BgContinuousTaskMgr::RemoveSubscriberInner(const sptr<IBackgroundTaskSub
         BGTASK_LOGE("Subscriber' object is null.");
         return ERR_BGTASK_INVALID_PARAM;
     }
-    auto findSubscriber = [&remote](const auto &info) {
-        return remote == info->subscriber_->AsObject();
-    };
-    auto subscriberIter = find_if(bgTaskSubscribers_.begin(), bgTaskSubscribers_.end(), findSubscriber);
+    auto subscriberIter = bgTaskSubscribers_.find(remote);
     if (subscriberIter == bgTaskSubscribers_.end()) {
         BGTASK_LOGE("subscriber to remove is not exists.");
         return ERR_BGTASK_INVALID_PARAM;
     }
     if ((*subscriberIter)->isHap_) {
         (*subscriberIter)->flag_ = (*subscriberIter)->flag_ & ~flag;
+        bgTaskSubscribers_.Reclassify();
         BGTASK_LOGW("remove subscriber success, current flag: %{public}d", (*subscriberIter)->flag_);
         if ((*subscriberIter)->flag_ > 0) {
             BGTASK_LOGD("application uid: %{public}d have callback function.", (*subscriberIter)->uid_);
@@ -2273,6 +2540,7 @@ ErrCode BgContinuousTaskMgr::RemoveSubscriberInner(const sptr<IBackgroundTaskSub
         remote->RemoveDeathRecipient(susriberDeathRecipient_);
     }
     bgTaskSubscribers_.erase(subscriberIter);
+    subscriberDispatcher_->RemoveSubscriber(SubscriberSource::CONTINUOUS_TASK, remote);
     BGTASK_LOGI("Remove continuous task subscriber succeed");
     return ERR_OK;
 }
@@ -2286,10 +2554,13 @@ ErrCode BgContinuousTaskMgr::GetContinuousTaskApps(std::vector<std::shared_ptr<C
     }
 
     ErrCode result = ERR_OK;
+    if (GetContinuousTaskAppsFromSnapshot(list, uid)) {
+        return ERR_OK;
+    }
 
-    handler_->PostSyncTask([this, &list, uid, &result]() {
+    laneScheduler_->PostSyncTask(handler_, EventLane::IPC, [this, &list, uid, &result]() {
         result = this->GetContinuousTaskAppsInner(list, uid);
-        }, AppExecFwk::EventQueue::Priority::HIGH);
+        });
 
     return result;
 }
@@ -2308,18 +2579,198 @@ ErrCode BgContinuousTaskMgr::GetContinuousTaskAppsInner(std::vector<std::shared_
         if (record.second->suspendState_ && !includeSuspended) {
             continue;
         }
-        auto appInfo = std::make_shared<ContinuousTaskCallbackInfo>(record.second->bgModeId_, record.second->uid_,
-            record.second->pid_, record.second->abilityName_, record.second->isFromWebview_, record.second->isBatchApi_,
-            record.second->bgModeIds_, record.second->abilityId_, record.second->fullTokenId_);
-        appInfo->SetContinuousTaskId(record.second->continuousTaskId_);
-        appInfo->SetByRequestObject(record.second->isByRequestObject_);
-        appInfo->SetSuspendState(record.second->suspendState_);
-        appInfo->SetSuspendReason(record.second->suspendReason_);
-        list.push_back(appInfo);
+        list.push_back(CreateContinuousTaskAppInfo(record.second));
     }
     return ERR_OK;
 }
 
+std::shared_ptr<ContinuousTaskCallbackInfo> BgContinuousTaskMgr::CreateContinuousTaskAppInfo(
+    const std::shared_ptr<ContinuousTaskRecord> &record)
+{
+    auto appInfo = std::make_shared<ContinuousTaskCallbackInfo>(record->bgModeId_, record->uid_,
+        record->pid_, record->abilityName_, record->isFromWebview_, record->isBatchApi_,
+        record->bgModeIds_, record->abilityId_, record->fullTokenId_);
+    appInfo->SetContinuousTaskId(record->continuousTaskId_);
+    appInfo->SetByRequestObject(record->isByRequestObject_);
+    appInfo->SetSuspendState(record->suspendState_);
+    appInfo->SetSuspendReason(record->suspendReason_);
+    return appInfo;
+}
+
+void BgContinuousTaskMgr::PublishTaskSnapshot()
+{
+    auto snapshot = std::make_shared<ContinuousTaskSnapshot>();
+    auto current = GetTaskSnapshot();
+    snapshot->version_ = (current == nullptr) ? GetInitialTaskGeneration() : current->version_ + 1;
+    for (const auto &task : continuousTaskInfosMap_) {
+        if (task.second == nullptr) {
+            continue;
+        }
+        auto entry = std::make_shared<ContinuousTaskSnapshotEntry>();
+        entry->uid_ = task.second->uid_;
+        entry->suspendState_ = task.second->suspendState_;
+        entry->taskInfo_ = CreateContinuousTaskInfo(task.second);
+        entry->appInfo_ = CreateContinuousTaskAppInfo(task.second);
+        snapshot->entries_.emplace(task.first, entry);
+    }
+    snapshot->tableGeneration_ = continuousTaskInfosMap_.GetGeneration();
+    RecordTaskChanges(current, snapshot);
+    std::atomic_store(&taskSnapshot_, std::shared_ptr<const ContinuousTaskSnapshot>(snapshot));
+}
+
+void BgContinuousTaskMgr::RecordTaskChanges(const std::shared_ptr<const ContinuousTaskSnapshot> &current,
+    const std::shared_ptr<const ContinuousTaskSnapshot> &snapshot)
+{
+    if (current == nullptr) {
+        taskChangeLog_.Reset(snapshot->version_);
+        return;
+    }
+    // 全量重建时与旧快照逐条比较，只记录实际变化的任务
+    for (const auto &iter : current->entries_) {
+        if (snapshot->entries_.count(iter.first) == 0) {
+            taskChangeLog_.Append(snapshot->version_, iter.first, ContinuousTaskChangeType::REMOVED,
+                iter.second->appInfo_);
+        }
+    }
+    for (const auto &iter : snapshot->entries_) {
+        auto currentIter = current->entries_.find(iter.first);
+        if (currentIter == current->entries_.end()) {
+            taskChangeLog_.Append(snapshot->version_, iter.first, ContinuousTaskChangeType::ADDED);
+        } else if (!IsSameAppInfo(*currentIter->second->appInfo_, *iter.second->appInfo_)) {
+            taskChangeLog_.Append(snapshot->version_, iter.first, ContinuousTaskChangeType::UPDATED);
+        }
+    }
+}
+
+void BgContinuousTaskMgr::PublishTaskSnapshot(const std::vector<std::string> &changedKeys)
+{
+    auto current = GetTaskSnapshot();
+    if (current == nullptr) {
+        PublishTaskSnapshot();
+        return;
+    }
+    // 未变更的条目与旧快照共享，只重建本次变更的任务
+    auto snapshot = std::make_shared<ContinuousTaskSnapshot>(*current);
+    snapshot->version_ = current->version_ + 1;
+    for (const auto &key : changedKeys) {
+        auto iter = continuousTaskInfosMap_.find(key);
+        auto currentIter = current->entries_.find(key);
+        bool existed = currentIter != current->entries_.end();
+        if (iter == continuousTaskInfosMap_.end() || iter->second == nullptr) {
+            if (existed) {
+                taskChangeLog_.Append(snapshot->version_, key, ContinuousTaskChangeType::REMOVED,
+                    currentIter->second->appInfo_);
+            }
+            snapshot->entries_.erase(key);
+            continue;
+        }
+        auto entry = std::make_shared<ContinuousTaskSnapshotEntry>();
+        entry->uid_ = iter->second->uid_;
+        entry->suspendState_ = iter->second->suspendState_;
+        entry->taskInfo_ = CreateContinuousTaskInfo(iter->second);
+        entry->appInfo_ = CreateContinuousTaskAppInfo(iter->second);
+        taskChangeLog_.Append(snapshot->version_, key,
+            existed ? ContinuousTaskChangeType::UPDATED : ContinuousTaskChangeType::ADDED);
+        snapshot->entries_[key] = entry;
+    }
+    snapshot->tableGeneration_ = continuousTaskInfosMap_.GetGeneration();
+    std::atomic_store(&taskSnapshot_, std::shared_ptr<const ContinuousTaskSnapshot>(snapshot));
+}
+
+std::shared_ptr<const ContinuousTaskSnapshot> BgContinuousTaskMgr::GetTaskSnapshot() const
+{
+    return std::atomic_load(&taskSnapshot_);
+}
+
+std::shared_ptr<const ContinuousTaskSnapshot> BgContinuousTaskMgr::GetCommittedTaskSnapshot() const
+{
+    auto snapshot = GetTaskSnapshot();
+    // 任务表已增删但尚未发布新快照，由调用方回退到任务线程查询
+    if (snapshot == nullptr || snapshot->tableGeneration_ != continuousTaskInfosMap_.GetGeneration()) {
+        return nullptr;
+    }
+    return snapshot;
+}
+
+bool BgContinuousTaskMgr::GetAllContinuousTasksFromSnapshot(int32_t uid,
+    std::vector<std::shared_ptr<ContinuousTaskInfo>> &list, bool includeSuspended, bool exemptUid)
+{
+    auto snapshot = GetCommittedTaskSnapshot();
+    if (snapshot == nullptr) {
+        return false;
+    }
+    BGTASK_LOGD("get continuous tasks from snapshot version: %{public}" PRIu64, snapshot->version_);
+    for (const auto &iter : snapshot->entries_) {
+        const auto &entry = iter.second;
+        if ((!exemptUid && entry->uid_ != uid) || (!includeSuspended && entry->suspendState_)) {
+            continue;
+        }
+        // 快照内对象只读，返回副本
+        list.push_back(std::make_shared<ContinuousTaskInfo>(*entry->taskInfo_));
+    }
+    return true;
+}
+
+ErrCode BgContinuousTaskMgr::GetContinuousTaskAppsDelta(uint64_t sinceGeneration, ContinuousTaskAppsDelta &delta)
+{
+    if (!isSysReady_.load()) {
+        BGTASK_LOGW("manager is not ready");
+        return ERR_BGTASK_SYS_NOT_READY;
+    }
+    // 快照与变更日志都在任务线程发布，这里直接读取当前快照，晚于快照的变更在下次查询返回
+    auto snapshot = GetTaskSnapshot();
+    if (snapshot == nullptr) {
+        return ERR_BGTASK_SYS_NOT_READY;
+    }
+    delta.generation = snapshot->version_;
+    delta.isFullResync = false;
+    if (sinceGeneration == snapshot->version_) {
+        return ERR_OK;
+    }
+    std::map<std::string, ContinuousTaskChange> changes;
+    if (sinceGeneration == 0 || !IsSameTaskGenerationEpoch(sinceGeneration, snapshot->version_) ||
+        sinceGeneration > snapshot->version_ || !taskChangeLog_.Collect(sinceGeneration, snapshot->version_, changes)) {
+        BGTASK_LOGI("continuous task apps full resync, since: %{public}" PRIu64 ", generation: %{public}" PRIu64,
+            sinceGeneration, snapshot->version_);
+        delta.isFullResync = true;
+        for (const auto &iter : snapshot->entries_) {
+            delta.addedList.push_back(std::make_shared<ContinuousTaskCallbackInfo>(*iter.second->appInfo_));
+        }
+        return ERR_OK;
+    }
+    for (const auto &iter : changes) {
+        if (iter.second.type == ContinuousTaskChangeType::REMOVED) {
+            delta.removedList.push_back(std::make_shared<ContinuousTaskCallbackInfo>(*iter.second.removedInfo));
+            continue;
+        }
+        auto entryIter = snapshot->entries_.find(iter.first);
+        if (entryIter == snapshot->entries_.end()) {
+            continue;
+        }
+        auto &list = (iter.second.type == ContinuousTaskChangeType::ADDED) ? delta.addedList : delta.updatedList;
+        list.push_back(std::make_shared<ContinuousTaskCallbackInfo>(*entryIter->second->appInfo_));
+    }
+    return ERR_OK;
+}
+
+bool BgContinuousTaskMgr::GetContinuousTaskAppsFromSnapshot(
+    std::vector<std::shared_ptr<ContinuousTaskCallbackInfo>> &list, int32_t uid, bool includeSuspended)
+{
+    auto snapshot = GetCommittedTaskSnapshot();
+    if (snapshot == nullptr) {
+        return false;
+    }
+    BGTASK_LOGD("get continuous task apps from snapshot version: %{public}" PRIu64, snapshot->version_);
+    for (const auto &iter : snapshot->entries_) {
+        const auto &entry = iter.second;
+        if ((uid != -1 && entry->uid_ != uid) || (!includeSuspended && entry->suspendState_)) {
+            continue;
+        }
+        list.push_back(std::make_shared<ContinuousTaskCallbackInfo>(*entry->appInfo_));
+    }
+    return true;
+}
+
 ErrCode BgContinuousTaskMgr::AVSessionNotifyUpdateNotification(int32_t uid, int32_t pid, bool isPublish)
 {
     if (!isSysReady_.load()) {
@@ -2335,9 +2786,9 @@ ErrCode BgContinuousTaskMgr::AVSessionNotifyUpdateNotification(int32_t uid, int3
 
     ErrCode result = ERR_OK;
     if (isPublish) {
-        handler_->PostSyncTask([this, uid, pid, isPublish, &result]() {
+        laneScheduler_->PostSyncTask(handler_, EventLane::IPC, [this, uid, pid, isPublish, &result]() {
             result = this->AVSessionNotifyUpdateNotificationInner(uid, pid, isPublish);
-            }, AppExecFwk::EventQueue::Priority::HIGH);
+            });
     } else {
         auto task = [weak = weak_from_this(), uid, pid, isPublish]() {
             auto self = weak.lock();
@@ -2345,7 +2796,8 @@ ErrCode BgContinuousTaskMgr::AVSessionNotifyUpdateNotification(int32_t uid, int3
                 self->AVSessionNotifyUpdateNotificationInner(uid, pid, isPublish);
             }
         };
-        handler_->PostTask(task, TASK_NOTIFY_AUDIO_PLAYBACK_SEND, NOTIFY_AUDIO_PLAYBACK_DELAY_TIME);
+        laneScheduler_->PostTask(handler_, EventLane::MAINTENANCE, task, TASK_NOTIFY_AUDIO_PLAYBACK_SEND,
+            NOTIFY_AUDIO_PLAYBACK_DELAY_TIME);
         std::lock_guard<std::mutex> lock(delayTasksMutex_);
         delayTasks_.insert(uid);
     }
@@ -2359,14 +2811,12 @@ ErrCode BgContinuousTaskMgr::AVSessionNotifyUpdateNotificationInner(int32_t uid,
     if (isPublish) {
         RemoveAudioPlaybackDelayTask(uid);
     }
-    auto findUid = [uid](const auto &target) {
-        return uid == target.second->GetUid();
-    };
-    auto findUidIter = find_if(continuousTaskInfosMap_.begin(), continuousTaskInfosMap_.end(), findUid);
-    if (findUidIter == continuousTaskInfosMap_.end()) {
+    auto uidKeys = continuousTaskInfosMap_.GetKeysByUid(uid);
+    if (uidKeys.empty()) {
         RemoveAudioPlaybackDelayTask(uid);
         return ERR_BGTASK_OBJECT_NOT_EXIST;
     }
+    auto findUidIter = continuousTaskInfosMap_.find(uidKeys.front());
 
     ErrCode result = ERR_OK;
     auto record = findUidIter->second;
@@ -2390,7 +2840,7 @@ ErrCode BgContinuousTaskMgr::AVSessionNotifyUpdateNotificationInner(int32_t uid,
     if (!isPublish && record->bgModeIds_.size() == 1 && record->bgModeIds_[0] == BackgroundMode::AUDIO_PLAYBACK) {
         BGTASK_LOGI("avsession not exist, send continuousTask notification uid: %{public}d", uid);
         result = SendContinuousTaskNotification(record);
-        RefreshTaskRecord();
+        RefreshTaskRecord(findUidIter->first);
         RemoveAudioPlaybackDelayTask(uid);
         return result;
     }
@@ -2406,7 +2856,7 @@ ErrCode BgContinuousTaskMgr::AVSessionNotifyUpdateNotificationInner(int32_t uid,
             newPromptInfos.emplace(record->notificationLabel_, std::make_pair(mainAbilityLabel, notificationText));
             NotificationTools::GetInstance()->RefreshContinuousNotifications(newPromptInfos, bgTaskUid_);
         }
-        RefreshTaskRecord();
+        RefreshTaskRecord(findUidIter->first);
     }
     RemoveAudioPlaybackDelayTask(uid);
     return result;
@@ -2458,45 +2908,38 @@ void BgContinuousTaskMgr::SendAudioCallBackTaskState(const std::shared_ptr<Conti
     continuousTaskCallbackInfo->SetBundleName(continuousTaskInfo->bundleName_);
     continuousTaskCallbackInfo->SetUserId(continuousTaskInfo->userId_);
     continuousTaskCallbackInfo->SetAppIndex(continuousTaskInfo->appIndex_);
-    const ContinuousTaskCallbackInfo& taskCallbackInfoRef = *continuousTaskCallbackInfo;
-    for (auto iter = bgTaskSubscribers_.begin(); iter != bgTaskSubscribers_.end(); ++iter) {
-        if ((*iter)->isHap_ && (*iter)->subscriber_) {
-            if (((*iter)->flag_ & SUBSCRIBER_BACKGROUND_TASK_STATE) > 0) {
-                (*iter)->subscriber_->OnContinuousTaskStop(taskCallbackInfoRef);
-            }
-        }
+    auto parcel = std::make_shared<SubscriberEventParcel>(continuousTaskCallbackInfo);
+    for (const auto &subscriberInfo : bgTaskSubscribers_.GetBucket(SUBSCRIBER_BUCKET_HAP_STATE)) {
+        DispatchToSubscriber(subscriberInfo, ContinuousTaskEventTriggerType::TASK_CANCEL,
+            continuousTaskCallbackInfo, parcel);
     }
 }
 
 void BgContinuousTaskMgr::HandleSuspendContinuousAudioTask(int32_t uid)
 {
-    auto iter = continuousTaskInfosMap_.begin();
-    while (iter != continuousTaskInfosMap_.end()) {
-        if (iter->second->GetUid() == uid &&
-            CommonUtils::CheckExistMode(iter->second->bgModeIds_, BackgroundMode::AUDIO_PLAYBACK)) {
-            iter->second->audioDetectState_ = false;
-            NotificationTools::GetInstance()->CancelNotification(iter->second->GetNotificationLabel(),
-                iter->second->GetNotificationId());
-            if (!IsExistCallback(uid, CONTINUOUS_TASK_SUSPEND)) {
-                SendAudioCallBackTaskState(iter->second);
-                iter++;
-                continue;
-            }
-            if (iter->second->GetSuspendAudioTaskTimes() == 0) {
-                iter->second->suspendState_ = true;
-                iter->second->suspendAudioTaskTimes_ = 1;
-                iter->second->suspendReason_ =
-                    static_cast<int32_t>(ContinuousTaskSuspendReason::SYSTEM_SUSPEND_AUDIO_PLAYBACK_NOT_RUNNING);
-                OnContinuousTaskChanged(iter->second, ContinuousTaskEventTriggerType::TASK_SUSPEND);
-                RefreshTaskRecord();
-                iter++;
-            } else {
-                OnContinuousTaskChanged(iter->second, ContinuousTaskEventTriggerType::TASK_CANCEL);
-                iter = continuousTaskInfosMap_.erase(iter);
-                RefreshTaskRecord();
-            }
+    for (const auto &key : continuousTaskInfosMap_.GetKeysByUid(uid)) {
+        auto iter = continuousTaskInfosMap_.find(key);
+        if (!CommonUtils::CheckExistMode(iter->second->bgModeIds_, BackgroundMode::AUDIO_PLAYBACK)) {
+            continue;
+        }
+        iter->second->audioDetectState_ = false;
+        NotificationTools::GetInstance()->CancelNotification(iter->second->GetNotificationLabel(),
+            iter->second->GetNotificationId());
+        if (!IsExistCallback(uid, CONTINUOUS_TASK_SUSPEND)) {
+            SendAudioCallBackTaskState(iter->second);
+            continue;
+        }
+        if (iter->second->GetSuspendAudioTaskTimes() == 0) {
+            iter->second->suspendState_ = true;
+            iter->second->suspendAudioTaskTimes_ = 1;
+            iter->second->suspendReason_ =
+                static_cast<int32_t>(ContinuousTaskSuspendReason::SYSTEM_SUSPEND_AUDIO_PLAYBACK_NOT_RUNNING);
+            OnContinuousTaskChanged(iter->second, ContinuousTaskEventTriggerType::TASK_SUSPEND);
+            RefreshTaskRecord(key);
         } else {
-            iter++;
+            OnContinuousTaskChanged(iter->second, ContinuousTaskEventTriggerType::TASK_CANCEL);
+            continuousTaskInfosMap_.erase(iter);
+            RefreshTaskRecord(key);
         }
     }
     HandleAppContinuousTaskStop(uid);
@@ -2594,18 +3037,13 @@ void BgContinuousTaskMgr::DumpAllTaskInfo(std::vector<std::string> &dumpInfo)
 void BgContinuousTaskMgr::DumpCancelTask(const std::vector<std::string> &dumpOption, bool cleanAll)
 {
     if (cleanAll) {
-        std::set<int32_t> uids;
-        for (auto item : continuousTaskInfosMap_) {
-            NotificationTools::GetInstance()->CancelNotification(item.second->GetNotificationLabel(),
-                item.second->GetNotificationId());
-            OnContinuousTaskChanged(item.second, ContinuousTaskEventTriggerType::TASK_CANCEL);
-            uids.insert(item.second->uid_);
+        ContinuousTaskBatch batch;
+        for (const auto &item : continuousTaskInfosMap_) {
+            batch.CancelNotification(item.second->GetNotificationLabel(), item.second->GetNotificationId());
+            batch.RemoveTask(item.first, item.second);
         }
         continuousTaskInfosMap_.clear();
-        RefreshTaskRecord();
-        for (int32_t uid : uids) {
-            HandleAppContinuousTaskStop(uid);
-        }
+        CommitTaskBatch(batch);
     } else {
         if (dumpOption.size() < MAX_DUMP_PARAM_NUMS) {
             return;
@@ -2666,11 +3104,9 @@ bool BgContinuousTaskMgr::StopContinuousTaskByUserInner(const std::string &key,
     int32_t notificationId = removeTask->second->GetNotificationId();
     if (notificationId != -1) {
         std::string notificationLabel = removeTask->second->GetNotificationLabel();
-        auto iter = continuousTaskInfosMap_.begin();
-        while (iter != continuousTaskInfosMap_.end()) {
-            if (iter->second->notificationId_ != notificationId ||
-                iter->second->notificationLabel_ != notificationLabel) {
-                ++iter;
+        for (const auto &taskKey : continuousTaskInfosMap_.GetKeysByNotificationLabel(notificationLabel)) {
+            auto iter = continuousTaskInfosMap_.find(taskKey);
+            if (iter->second->notificationId_ != notificationId) {
                 continue;
             }
             auto record = iter->second;
@@ -2684,9 +3120,9 @@ bool BgContinuousTaskMgr::StopContinuousTaskByUserInner(const std::string &key,
                 NotificationTools::GetInstance()->CancelNotification(
                     record->subNotificationLabel_, record->subNotificationId_);
             }
-            iter = continuousTaskInfosMap_.erase(iter);
+            continuousTaskInfosMap_.erase(iter);
             HandleAppContinuousTaskStop(record->uid_);
-            RefreshTaskRecord();
+            RefreshTaskRecord(taskKey);
         }
     }
     return true;
@@ -2742,15 +3178,10 @@ void BgContinuousTaskMgr::OnRemoteSubscriberDiedInner(const wptr<IRemoteObject>
         BGTASK_LOGE("get remote object failed");
         return;
     }
-    auto iter = bgTaskSubscribers_.begin();
-    while (iter != bgTaskSubscribers_.end()) {
-        if ((*iter)->subscriber_->AsObject() == objectProxy) {
-            BGTASK_LOGI("OnRemoteSubscriberDiedInner erase it");
-            iter = bgTaskSubscribers_.erase(iter);
-        } else {
-            iter++;
-        }
+    if (bgTaskSubscribers_.erase(objectProxy) > 0) {
+        BGTASK_LOGI("OnRemoteSubscriberDiedInner erase it");
     }
+    subscriberDispatcher_->RemoveSubscriber(SubscriberSource::CONTINUOUS_TASK, objectProxy);
     BGTASK_LOGI("continuous subscriber die, list size is %{public}d", static_cast<int>(bgTaskSubscribers_.size()));
 }
 
@@ -2773,30 +3204,22 @@ void BgContinuousTaskMgr::OnAppStopped(int32_t uid)
         BGTASK_LOGW("manager is not ready");
         return;
     }
-    auto iter = continuousTaskInfosMap_.begin();
-    while (iter != continuousTaskInfosMap_.end()) {
-        if (iter->second->uid_ == uid) {
-            auto record = iter->second;
-            BGTASK_LOGI("OnAppStopped uid: %{public}d, bundleName: %{public}s abilityName: %{public}s"
-                "bgModeId: %{public}d, abilityId: %{public}d", uid, record->bundleName_.c_str(),
-                record->abilityName_.c_str(), record->bgModeId_, record->abilityId_);
-            record->reason_ = SYSTEM_CANCEL;
-            OnContinuousTaskChanged(record, ContinuousTaskEventTriggerType::TASK_CANCEL);
-            if (record->GetNotificationId() != -1) {
-                NotificationTools::GetInstance()->CancelNotification(
-                    record->GetNotificationLabel(), record->GetNotificationId());
-            }
-            if (record->subNotificationId_ != -1 && record->isByRequestObject_) {
-                NotificationTools::GetInstance()->CancelNotification(
-                    record->subNotificationLabel_, record->subNotificationId_);
-            }
-            iter = continuousTaskInfosMap_.erase(iter);
-            HandleAppContinuousTaskStop(record->uid_);
-            RefreshTaskRecord();
-        } else {
-            iter++;
-        }
-    }
+    ContinuousTaskBatch batch;
+    for (const auto &key : continuousTaskInfosMap_.GetKeysByUid(uid)) {
+        auto iter = continuousTaskInfosMap_.find(key);
+        auto record = iter->second;
+        BGTASK_LOGI("OnAppStopped uid: %{public}d, bundleName: %{public}s abilityName: %{public}s"
+            "bgModeId: %{public}d, abilityId: %{public}d", uid, record->bundleName_.c_str(),
+            record->abilityName_.c_str(), record->bgModeId_, record->abilityId_);
+        record->reason_ = SYSTEM_CANCEL;
+        batch.CancelNotification(record->GetNotificationLabel(), record->GetNotificationId());
+        if (record->subNotificationId_ != -1 && record->isByRequestObject_) {
+            batch.CancelNotification(record->subNotificationLabel_, record->subNotificationId_);
+        }
+        batch.RemoveTask(key, record);
+        continuousTaskInfosMap_.erase(iter);
+    }
+    CommitTaskBatch(batch);
     std::string stopBundleName;
     int32_t stopAppIndex;
     if (!BundleManagerHelper::GetInstance()->GetAppIndexAndBundleNameByUid(uid, stopAppIndex, stopBundleName)) {
@@ -2824,7 +3247,6 @@ void BgContinuousTaskMgr::OnAppStateChanged(int32_t uid, int32_t state, int32_t
         return;
     }
     if (state == static_cast<int32_t>(AppExecFwk::ApplicationState::APP_STATE_FOREGROUND)) {
-        appOnForeground_.insert(uid);
 #ifdef GAME_PRE_LAUNCH_ENABLE
         // preloadMode != GAME_PRELAUNCH, 游戏预启动结束
         if (preloadMode != static_cast<int32_t>(AppExecFwk::PreloadMode::GAME_PRELAUNCH) &&
@@ -2836,7 +3258,6 @@ void BgContinuousTaskMgr::OnAppStateChanged(int32_t uid, int32_t state, int32_t
         return;
     }
 
-    appOnForeground_.erase(uid);
     applyTaskOnForeground_.erase(uid);
     if (continuousTaskInfosMap_.empty()) {
         BGTASK_LOGD("continuousTaskInfosMap is empty");
@@ -2879,6 +3300,54 @@ bool BgContinuousTaskMgr::CanNotifyHap(const std::shared_ptr<SubscriberInfo> sub
     return false;
 }
 
+void BgContinuousTaskMgr::DispatchToSubscriber(const std::shared_ptr<SubscriberInfo> &subscriberInfo,
+    ContinuousTaskEventTriggerType type, const std::shared_ptr<ContinuousTaskCallbackInfo> &callbackInfo,
+    const std::shared_ptr<SubscriberEventParcel> &parcel)
+{
+    auto subscriber = subscriberInfo->subscriber_;
+    SubscriberEvent event;
+    event.eventType = static_cast<uint32_t>(type);
+    event.coalesceKey = CONTINUOUS_SUBSCRIBER_EVENT_KEY + std::to_string(callbackInfo->GetContinuousTaskId());
+    if (type == ContinuousTaskEventTriggerType::TASK_UPDATE) {
+        // 尚未投递的开始或更新事件直接携带最新的任务信息
+        event.foldInto = {static_cast<uint32_t>(ContinuousTaskEventTriggerType::TASK_START),
+            static_cast<uint32_t>(ContinuousTaskEventTriggerType::TASK_UPDATE)};
+        event.droppable = true;
+    } else if (type == ContinuousTaskEventTriggerType::TASK_CANCEL) {
+        // 尚未投递的开始事件与取消事件相互抵消
+        event.cancelOut = {static_cast<uint32_t>(ContinuousTaskEventTriggerType::TASK_START)};
+    }
+    event.resync = [subscriber]() { subscriber->OnConnected(); };
+    event.delivery = [subscriber, callbackInfo, parcel](uint32_t eventType) {
+        // 远端订阅者复用同一份序列化数据，进程内订阅者直接调用接口
+        auto type = static_cast<ContinuousTaskEventTriggerType>(eventType);
+        auto codeIter = g_subscriberIpcCodes.find(type);
+        if (codeIter != g_subscriberIpcCodes.end() && parcel->SendRequest(subscriber->AsObject(), codeIter->second)) {
+            return;
+        }
+        switch (type) {
+            case ContinuousTaskEventTriggerType::TASK_START:
+                subscriber->OnContinuousTaskStart(*callbackInfo);
+                break;
+            case ContinuousTaskEventTriggerType::TASK_UPDATE:
+                subscriber->OnContinuousTaskUpdate(*callbackInfo);
+                break;
+            case ContinuousTaskEventTriggerType::TASK_CANCEL:
+                subscriber->OnContinuousTaskStop(*callbackInfo);
+                break;
+            case ContinuousTaskEventTriggerType::TASK_SUSPEND:
+                subscriber->OnContinuousTaskSuspend(*callbackInfo);
+                break;
+            case ContinuousTaskEventTriggerType::TASK_ACTIVE:
+                subscriber->OnContinuousTaskActive(*callbackInfo);
+                break;
+            default:
+                break;
+        }
+    };
+    subscriberDispatcher_->Dispatch(SubscriberSource::CONTINUOUS_TASK, subscriber->AsObject(), std::move(event));
+}
+
 void BgContinuousTaskMgr::NotifySubscribers(ContinuousTaskEventTriggerType changeEventType,
     const std::shared_ptr<ContinuousTaskCallbackInfo> &continuousTaskCallbackInfo)
 {
@@ -2912,16 +3381,15 @@ void BgContinuousTaskMgr::NotifySubscribersTaskStart(
     const std::shared_ptr<ContinuousTaskCallbackInfo> &continuousTaskCallbackInfo)
 {
     BackgroundTaskObserver::GetInstance().OnContinuousTaskStart(continuousTaskCallbackInfo);
-    const ContinuousTaskCallbackInfo& taskCallbackInfoRef = *continuousTaskCallbackInfo;
-    for (auto iter = bgTaskSubscribers_.begin(); iter != bgTaskSubscribers_.end(); ++iter) {
-        BGTASK_LOGD("continuous task start callback trigger");
-        if (!(*iter)->isHap_ && (*iter)->subscriber_) {
-            (*iter)->subscriber_->OnContinuousTaskStart(taskCallbackInfoRef);
-        } else if ((*iter)->isHap_ && (*iter)->subscriber_) {
-            if (((*iter)->flag_ & SUBSCRIBER_BACKGROUND_TASK_STATE) > 0) {
-                (*iter)->subscriber_->OnContinuousTaskStart(taskCallbackInfoRef);
-            }
-        }
+    auto parcel = std::make_shared<SubscriberEventParcel>(continuousTaskCallbackInfo);
+    BGTASK_LOGD("continuous task start callback trigger");
+    for (const auto &subscriberInfo : bgTaskSubscribers_.GetBucket(SUBSCRIBER_BUCKET_SA)) {
+        DispatchToSubscriber(subscriberInfo, ContinuousTaskEventTriggerType::TASK_START,
+            continuousTaskCallbackInfo, parcel);
+    }
+    for (const auto &subscriberInfo : bgTaskSubscribers_.GetBucket(SUBSCRIBER_BUCKET_HAP_STATE)) {
+        DispatchToSubscriber(subscriberInfo, ContinuousTaskEventTriggerType::TASK_START,
+            continuousTaskCallbackInfo, parcel);
     }
 }
 
@@ -2929,16 +3397,15 @@ void BgContinuousTaskMgr::NotifySubscribersTaskUpdate(
     const std::shared_ptr<ContinuousTaskCallbackInfo> &continuousTaskCallbackInfo)
 {
     BackgroundTaskObserver::GetInstance().OnContinuousTaskUpdate(continuousTaskCallbackInfo);
-    const ContinuousTaskCallbackInfo& taskCallbackInfoRef = *continuousTaskCallbackInfo;
-    for (auto iter = bgTaskSubscribers_.begin(); iter != bgTaskSubscribers_.end(); ++iter) {
-        BGTASK_LOGD("continuous task update callback trigger");
-        if (!(*iter)->isHap_ && (*iter)->subscriber_) {
-            (*iter)->subscriber_->OnContinuousTaskUpdate(taskCallbackInfoRef);
-        } else if ((*iter)->isHap_ && (*iter)->subscriber_) {
-            if (((*iter)->flag_ & SUBSCRIBER_BACKGROUND_TASK_STATE) > 0) {
-                (*iter)->subscriber_->OnContinuousTaskUpdate(taskCallbackInfoRef);
-            }
-        }
+    auto parcel = std::make_shared<SubscriberEventParcel>(continuousTaskCallbackInfo);
+    BGTASK_LOGD("continuous task update callback trigger");
+    for (const auto &subscriberInfo : bgTaskSubscribers_.GetBucket(SUBSCRIBER_BUCKET_SA)) {
+        DispatchToSubscriber(subscriberInfo, ContinuousTaskEventTriggerType::TASK_UPDATE,
+            continuousTaskCallbackInfo, parcel);
+    }
+    for (const auto &subscriberInfo : bgTaskSubscribers_.GetBucket(SUBSCRIBER_BUCKET_HAP_STATE)) {
+        DispatchToSubscriber(subscriberInfo, ContinuousTaskEventTriggerType::TASK_UPDATE,
+            continuousTaskCallbackInfo, parcel);
     }
 }
 
@@ -2946,17 +3413,18 @@ void BgContinuousTaskMgr::NotifySubscribersTaskCancel(
     const std::shared_ptr<ContinuousTaskCallbackInfo> &continuousTaskCallbackInfo)
 {
     BackgroundTaskObserver::GetInstance().OnContinuousTaskStop(continuousTaskCallbackInfo);
-    ContinuousTaskCallbackInfo& taskCallbackInfoRef = *continuousTaskCallbackInfo;
-    for (auto iter = bgTaskSubscribers_.begin(); iter != bgTaskSubscribers_.end(); ++iter) {
-        BGTASK_LOGD("continuous task stop callback trigger");
-        if (!(*iter)->isHap_ && (*iter)->subscriber_) {
-            // notify all sa
-            (*iter)->subscriber_->OnContinuousTaskStop(taskCallbackInfoRef);
-        } else if ((*iter)->isHap_ && (*iter)->subscriber_) {
-            if (CanNotifyHap(*iter, continuousTaskCallbackInfo) ||
-                (((*iter)->flag_ & SUBSCRIBER_BACKGROUND_TASK_STATE) > 0)) {
-                (*iter)->subscriber_->OnContinuousTaskStop(taskCallbackInfoRef);
-            }
+    auto parcel = std::make_shared<SubscriberEventParcel>(continuousTaskCallbackInfo);
+    BGTASK_LOGD("continuous task stop callback trigger");
+    // notify all sa
+    for (const auto &subscriberInfo : bgTaskSubscribers_.GetBucket(SUBSCRIBER_BUCKET_SA)) {
+        DispatchToSubscriber(subscriberInfo, ContinuousTaskEventTriggerType::TASK_CANCEL,
+            continuousTaskCallbackInfo, parcel);
+    }
+    for (const auto &subscriberInfo : bgTaskSubscribers_.GetBucket(SUBSCRIBER_BUCKET_HAP)) {
+        if (CanNotifyHap(subscriberInfo, continuousTaskCallbackInfo) ||
+            ((subscriberInfo->flag_ & SUBSCRIBER_BACKGROUND_TASK_STATE) > 0)) {
+            DispatchToSubscriber(subscriberInfo, ContinuousTaskEventTriggerType::TASK_CANCEL,
+                continuousTaskCallbackInfo, parcel);
         }
     }
 }
@@ -2968,24 +3436,28 @@ void BgContinuousTaskMgr::NotifySubscribersTaskSuspend(
     if (isNotStandby) {
         BackgroundTaskObserver::GetInstance().OnContinuousTaskStop(continuousTaskCallbackInfo);
     }
-    const ContinuousTaskCallbackInfo& taskCallbackInfoRef = *continuousTaskCallbackInfo;
-    for (auto iter = bgTaskSubscribers_.begin(); iter != bgTaskSubscribers_.end(); ++iter) {
-        if (!(*iter)->isHap_ && (*iter)->subscriber_ && isNotStandby) {
-            // 对SA来说，长时任务暂停状态等同于取消长时任务，保持原有逻辑；功耗检测失败不回调SA
-            BGTASK_LOGD("continuous task suspend callback trigger");
-            (*iter)->subscriber_->OnContinuousTaskStop(taskCallbackInfoRef);
-        } else if ((*iter)->isHap_ && (*iter)->subscriber_) {
-            // 回调所有注册的subscriber
-            if ((((*iter)->flag_ & SUBSCRIBER_BACKGROUND_TASK_STATE) > 0) && isNotStandby) {
-                (*iter)->subscriber_->OnContinuousTaskStop(taskCallbackInfoRef);
-            }
-            if ((*iter)->uid_ == continuousTaskCallbackInfo->GetCreatorUid()) {
-                // 回调通知应用长时任务暂停
-                BGTASK_LOGI("uid %{public}d is hap and uid is same, need notify suspend, suspendReason: %{public}d"
-                    "suspendState: %{public}d", (*iter)->uid_, taskCallbackInfoRef.GetSuspendReason(),
-                    taskCallbackInfoRef.GetSuspendState());
-                (*iter)->subscriber_->OnContinuousTaskSuspend(taskCallbackInfoRef);
-            }
+    auto parcel = std::make_shared<SubscriberEventParcel>(continuousTaskCallbackInfo);
+    if (isNotStandby) {
+        // 对SA来说，长时任务暂停状态等同于取消长时任务，保持原有逻辑；功耗检测失败不回调SA
+        BGTASK_LOGD("continuous task suspend callback trigger");
+        for (const auto &subscriberInfo : bgTaskSubscribers_.GetBucket(SUBSCRIBER_BUCKET_SA)) {
+            DispatchToSubscriber(subscriberInfo, ContinuousTaskEventTriggerType::TASK_CANCEL,
+                continuousTaskCallbackInfo, parcel);
+        }
+    }
+    for (const auto &subscriberInfo : bgTaskSubscribers_.GetBucket(SUBSCRIBER_BUCKET_HAP)) {
+        // 回调所有注册的subscriber
+        if (((subscriberInfo->flag_ & SUBSCRIBER_BACKGROUND_TASK_STATE) > 0) && isNotStandby) {
+            DispatchToSubscriber(subscriberInfo, ContinuousTaskEventTriggerType::TASK_CANCEL,
+                continuousTaskCallbackInfo, parcel);
+        }
+        if (subscriberInfo->uid_ == continuousTaskCallbackInfo->GetCreatorUid()) {
+            // 回调通知应用长时任务暂停
+            BGTASK_LOGI("uid %{public}d is hap and uid is same, need notify suspend, suspendReason: %{public}d"
+                "suspendState: %{public}d", subscriberInfo->uid_, continuousTaskCallbackInfo->GetSuspendReason(),
+                continuousTaskCallbackInfo->GetSuspendState());
+            DispatchToSubscriber(subscriberInfo, ContinuousTaskEventTriggerType::TASK_SUSPEND,
+                continuousTaskCallbackInfo, parcel);
         }
     }
 }
@@ -2997,22 +3469,26 @@ void BgContinuousTaskMgr::NotifySubscribersTaskActive(
     if (isNotStandby) {
         BackgroundTaskObserver::GetInstance().OnContinuousTaskStart(continuousTaskCallbackInfo);
     }
-    const ContinuousTaskCallbackInfo& taskCallbackInfoRef = *continuousTaskCallbackInfo;
-    for (auto iter = bgTaskSubscribers_.begin(); iter != bgTaskSubscribers_.end(); ++iter) {
-        BGTASK_LOGD("continuous task active callback trigger");
-        if (!(*iter)->isHap_ && (*iter)->subscriber_ && isNotStandby) {
-            // 对SA来说，长时任务激活状态等同于注册长时任务，保持原有逻辑；功耗激活不回调SA
-            (*iter)->subscriber_->OnContinuousTaskStart(taskCallbackInfoRef);
-        } else if ((*iter)->isHap_ && (*iter)->subscriber_) {
-            // 回调所有注册的subscriber
-            if ((((*iter)->flag_ & SUBSCRIBER_BACKGROUND_TASK_STATE) > 0) && isNotStandby) {
-                (*iter)->subscriber_->OnContinuousTaskStart(taskCallbackInfoRef);
-            }
-            if ((*iter)->uid_ == continuousTaskCallbackInfo->GetCreatorUid()) {
-                // 回调通知应用长时任务激活
-                BGTASK_LOGI("uid %{public}d is hap and uid is same, need notify active", (*iter)->uid_);
-                (*iter)->subscriber_->OnContinuousTaskActive(taskCallbackInfoRef);
-            }
+    auto parcel = std::make_shared<SubscriberEventParcel>(continuousTaskCallbackInfo);
+    BGTASK_LOGD("continuous task active callback trigger");
+    if (isNotStandby) {
+        // 对SA来说，长时任务激活状态等同于注册长时任务，保持原有逻辑；功耗激活不回调SA
+        for (const auto &subscriberInfo : bgTaskSubscribers_.GetBucket(SUBSCRIBER_BUCKET_SA)) {
+            DispatchToSubscriber(subscriberInfo, ContinuousTaskEventTriggerType::TASK_START,
+                continuousTaskCallbackInfo, parcel);
+        }
+    }
+    for (const auto &subscriberInfo : bgTaskSubscribers_.GetBucket(SUBSCRIBER_BUCKET_HAP)) {
+        // 回调所有注册的subscriber
+        if (((subscriberInfo->flag_ & SUBSCRIBER_BACKGROUND_TASK_STATE) > 0) && isNotStandby) {
+            DispatchToSubscriber(subscriberInfo, ContinuousTaskEventTriggerType::TASK_START,
+                continuousTaskCallbackInfo, parcel);
+        }
+        if (subscriberInfo->uid_ == continuousTaskCallbackInfo->GetCreatorUid()) {
+            // 回调通知应用长时任务激活
+            BGTASK_LOGI("uid %{public}d is hap and uid is same, need notify active", subscriberInfo->uid_);
+            DispatchToSubscriber(subscriberInfo, ContinuousTaskEventTriggerType::TASK_ACTIVE,
+                continuousTaskCallbackInfo, parcel);
         }
     }
 }
@@ -3111,9 +3587,10 @@ void BgContinuousTaskMgr::OnBundleInfoChanged(const std::string &action, const s
                 OnContinuousTaskChanged(record, ContinuousTaskEventTriggerType::TASK_CANCEL);
                 NotificationTools::GetInstance()->CancelNotification(
                     record->GetNotificationLabel(), record->GetNotificationId());
+                std::string key = iter->first;
                 iter = continuousTaskInfosMap_.erase(iter);
                 HandleAppContinuousTaskStop(uid);
-                RefreshTaskRecord();
+                RefreshTaskRecord(key);
             } else {
                 iter++;
             }
@@ -3144,22 +3621,21 @@ void BgContinuousTaskMgr::ClearBgOsAccountTask(const std::vector<int32_t> &activ
 #ifdef HAS_OS_ACCOUNT_CAR
     ClearBgOsAccountTaskInCar();
 #else // HAS_OS_ACCOUNT_CAR
+    ContinuousTaskBatch batch;
     auto iter = continuousTaskInfosMap_.begin();
     while (iter != continuousTaskInfosMap_.end()) {
         auto idIter = find(activatedOsAccountIds.begin(), activatedOsAccountIds.end(), iter->second->GetUserId());
         if (idIter == activatedOsAccountIds.end()) {
             auto record = iter->second;
             record->reason_ = SYSTEM_CANCEL;
-            OnContinuousTaskChanged(record, ContinuousTaskEventTriggerType::TASK_CANCEL);
-            NotificationTools::GetInstance()->CancelNotification(
-                record->GetNotificationLabel(), record->GetNotificationId());
+            batch.CancelNotification(record->GetNotificationLabel(), record->GetNotificationId());
+            batch.RemoveTask(iter->first, record);
             iter = continuousTaskInfosMap_.erase(iter);
-            HandleAppContinuousTaskStop(record->uid_);
-            RefreshTaskRecord();
         } else {
             iter++;
         }
     }
+    CommitTaskBatch(batch);
 #endif // HAS_OS_ACCOUNT_CAR
 }
 
@@ -3174,6 +3650,7 @@ void BgContinuousTaskMgr::ClearBgOsAccountTaskInCar()
         return;
     }
     BGTASK_LOGI("ForegroundOsAccounts size:%{public}lu", accounts.size());
+    ContinuousTaskBatch batch;
     auto iter = continuousTaskInfosMap_.begin();
     while (iter != continuousTaskInfosMap_.end()) {
         int32_t userId = iter->second->GetUserId();
@@ -3184,40 +3661,38 @@ void BgContinuousTaskMgr::ClearBgOsAccountTaskInCar()
         if (idIter == accounts.end()) {
             auto record = iter->second;
             record->reason_ = SYSTEM_CANCEL;
-            OnContinuousTaskChanged(record, ContinuousTaskEventTriggerType::TASK_CANCEL);
-            NotificationTools::GetInstance()->CancelNotification(
-                record->GetNotificationLabel(), record->GetNotificationId());
+            batch.CancelNotification(record->GetNotificationLabel(), record->GetNotificationId());
+            batch.RemoveTask(iter->first, record);
             iter = continuousTaskInfosMap_.erase(iter);
-            HandleAppContinuousTaskStop(record->uid_);
-            RefreshTaskRecord();
             BGTASK_LOGI("uid:%{public}d not in foreground OsAccounts, clear", record->uid_);
         } else {
             iter++;
         }
     }
+    CommitTaskBatch(batch);
 }
 #endif // HAS_OS_ACCOUNT_CAR
 
 void BgContinuousTaskMgr::HandleAppContinuousTaskStop(int32_t uid)
 {
-    auto findUid = [uid](const auto &target) {
-        return uid == target.second->GetUid();
-    };
-    auto findUidIter = find_if(continuousTaskInfosMap_.begin(), continuousTaskInfosMap_.end(), findUid);
-    if (findUidIter != continuousTaskInfosMap_.end()) {
+    if (!continuousTaskInfosMap_.GetKeysByUid(uid).empty()) {
         return;
     }
     BGTASK_LOGI("All continuous task has stopped of uid: %{public}d, so notify related subsystem", uid);
-    for (auto iter = bgTaskSubscribers_.begin(); iter != bgTaskSubscribers_.end(); iter++) {
-        if (!(*iter)->isHap_ && (*iter)->subscriber_) {
-            (*iter)->subscriber_->OnAppContinuousTaskStop(uid);
-        }
+    for (const auto &subscriberInfo : bgTaskSubscribers_.GetBucket(SUBSCRIBER_BUCKET_SA)) {
+        auto subscriber = subscriberInfo->subscriber_;
+        SubscriberEvent event;
+        event.delivery = [subscriber, uid](uint32_t) { subscriber->OnAppContinuousTaskStop(uid); };
+        event.resync = [subscriber]() { subscriber->OnConnected(); };
+        subscriberDispatcher_->Dispatch(SubscriberSource::CONTINUOUS_TASK, subscriber->AsObject(), std::move(event));
     }
 }
 
 int32_t BgContinuousTaskMgr::RefreshTaskRecord()
 {
-    int32_t ret = DelayedSingleton<DataStorageHelper>::GetInstance()->RefreshTaskRecord(continuousTaskInfosMap_);
+    PublishTaskSnapshot();
+    int32_t ret = DelayedSingleton<DataStorageHelper>::GetInstance()->RefreshTaskRecord(
+        continuousTaskInfosMap_.GetRecords());
     if (ret != ERR_OK) {
         BGTASK_LOGE("refresh data failed");
         return ret;
@@ -3225,20 +3700,82 @@ int32_t BgContinuousTaskMgr::RefreshTaskRecord()
     return ERR_OK;
 }
 
-std::string BgContinuousTaskMgr::GetMainAbilityLabel(const std::string &bundleName, int32_t userId)
+int32_t BgContinuousTaskMgr::RefreshTaskRecord(const std::string &key)
 {
-    BgTaskHiTraceChain traceChain(__func__);
-    std::string mainAbilityLabel {""};
-    AppExecFwk::BundleResourceInfo bundleResourceInfo;
-    if (BundleManagerHelper::GetInstance()->GetBundleResourceInfo(bundleName,
-        AppExecFwk::ResourceFlag::GET_RESOURCE_INFO_ALL, bundleResourceInfo)) {
-        mainAbilityLabel = bundleResourceInfo.label;
+    return RefreshTaskRecord(std::vector<std::string> {key});
+}
+
+int32_t BgContinuousTaskMgr::RefreshTaskRecord(const std::vector<std::string> &keys)
+{
+    PublishTaskSnapshot(keys);
+    // 只追加本次变更的记录，记录已删除时追加删除日志
+    std::vector<std::pair<std::string, std::shared_ptr<ContinuousTaskRecord>>> records;
+    records.reserve(keys.size());
+    for (const auto &key : keys) {
+        auto iter = continuousTaskInfosMap_.find(key);
+        records.emplace_back(key, iter != continuousTaskInfosMap_.end() ? iter->second : nullptr);
+    }
+    auto dataStorageHelper = DelayedSingleton<DataStorageHelper>::GetInstance();
+    if (dataStorageHelper->AppendTaskRecords(records) != ERR_OK) {
+        BGTASK_LOGE("append task record failed, size: %{public}zu, refresh all data", keys.size());
+        return RefreshTaskRecord();
+    }
+    if (dataStorageHelper->NeedCompactTaskRecord()) {
+        CompactTaskRecordDelayed();
+    }
+    return ERR_OK;
+}
+
+void BgContinuousTaskMgr::CommitTaskBatch(ContinuousTaskBatch &batch)
+{
+    if (batch.IsEmpty()) {
+        return;
+    }
+    for (const auto &record : batch.GetRemovedTasks()) {
+        OnContinuousTaskChanged(record, ContinuousTaskEventTriggerType::TASK_CANCEL);
+    }
+    // 多个任务共用同一通知时只取消一次
+    for (const auto &notification : batch.GetNotifications()) {
+        NotificationTools::GetInstance()->CancelNotification(notification.first, notification.second);
+    }
+    // 变更条目不少于剩余任务时直接写全量快照，比逐条追加日志更小
+    const auto &changedKeys = batch.GetChangedKeys();
+    if (!changedKeys.empty() && changedKeys.size() >= continuousTaskInfosMap_.size()) {
+        RefreshTaskRecord();
+    } else if (!changedKeys.empty()) {
+        RefreshTaskRecord(changedKeys);
+    }
+    for (int32_t uid : batch.GetStoppedUids()) {
+        HandleAppContinuousTaskStop(uid);
+    }
+}
+
+void BgContinuousTaskMgr::CompactTaskRecordDelayed()
+{
+    if (handler_ == nullptr || isTaskRecordCompactPending_) {
+        return;
     }
-    return mainAbilityLabel;
+    isTaskRecordCompactPending_ = true;
+    auto task = [weak = weak_from_this()]() {
+        auto self = weak.lock();
+        if (!self) {
+            return;
+        }
+        self->isTaskRecordCompactPending_ = false;
+        self->RefreshTaskRecord();
+    };
+    laneScheduler_->PostTask(handler_, EventLane::MAINTENANCE, task, TASK_COMPACT_TASK_RECORD,
+        COMPACT_TASK_RECORD_DELAY_TIME);
+}
+
+std::string BgContinuousTaskMgr::GetMainAbilityLabel(const std::string &bundleName, int32_t userId)
+{
+    return bundleInfoCache_->GetAppLabel(bundleName);
 }
 
 std::string BgContinuousTaskMgr::GetNotificationText(const std::shared_ptr<ContinuousTaskRecord> record)
 {
+    LoadDeferredNotificationPrompt();
     auto iter = avSessionNotification_.find(record->uid_);
     bool isPublish = (iter != avSessionNotification_.end()) ? iter->second : false;
     BGTASK_LOGD("AVSession Notification isPublish: %{public}d", isPublish);
@@ -3249,6 +3786,8 @@ std::string BgContinuousTaskMgr::GetNotificationText(const std::shared_ptr<Conti
 
 void BgContinuousTaskMgr::HandleRemoveTaskByMode(uint32_t mode)
 {
+    ContinuousTaskBatch batch;
+    std::vector<std::shared_ptr<ContinuousTaskRecord>> removedRecords;
     auto iter = continuousTaskInfosMap_.begin();
     while (iter != continuousTaskInfosMap_.end()) {
         auto record = iter->second;
@@ -3257,16 +3796,19 @@ void BgContinuousTaskMgr::HandleRemoveTaskByMode(uint32_t mode)
                 " bgModeId: %{public}d, abilityId: %{public}d", record->uid_, record->bundleName_.c_str(),
                 record->abilityName_.c_str(), mode, record->abilityId_);
             record->reason_ = SYSTEM_CANCEL;
-            OnContinuousTaskChanged(record, ContinuousTaskEventTriggerType::TASK_CANCEL);
+            batch.RemoveTask(iter->first, record);
+            removedRecords.emplace_back(record);
             iter = continuousTaskInfosMap_.erase(iter);
-            HandleAppContinuousTaskStop(record->uid_);
-            RefreshTaskRecord();
-            auto result = CancelNotification(record);
-            BGTASK_LOGI("Cancel notification, uid: %{public}d, result: %{public}d", record->uid_, result);
         } else {
             iter++;
         }
     }
+    CommitTaskBatch(batch);
+    // 合并通知需在全部任务移除后判断是否仍被其他任务使用
+    for (const auto &record : removedRecords) {
+        auto result = CancelNotification(record);
+        BGTASK_LOGI("Cancel notification, uid: %{public}d, result: %{public}d", record->uid_, result);
+    }
 }
 
 ErrCode BgContinuousTaskMgr::CheckModeSupportedPermission(const sptr<ContinuousTaskParam> &taskParam)
@@ -3319,9 +3861,10 @@ ErrCode BgContinuousTaskMgr::IsModeSupported(const sptr<ContinuousTaskParam> &ta
     uint64_t callingTokenId = IPCSkeleton::GetCallingTokenID();
     int32_t callingUid = IPCSkeleton::GetCallingUid();
     std::string bundleName = BundleManagerHelper::GetInstance()->GetClientBundleName(callingUid);
-    handler_->PostSyncTask([this, callingTokenId, taskParam, bundleName, fullTokenId, &result]() {
+    laneScheduler_->PostSyncTask(handler_, EventLane::IPC,
+        [this, callingTokenId, taskParam, bundleName, fullTokenId, &result]() {
         result = this->CheckTaskkeepingPermission(taskParam, callingTokenId, bundleName, fullTokenId);
-        }, AppExecFwk::EventQueue::Priority::HIGH);
+        });
     return result;
 }
 
@@ -3420,13 +3963,16 @@ ErrCode BgContinuousTaskMgr::SendNotification(const std::shared_ptr<ContinuousTa
 
 ErrCode BgContinuousTaskMgr::SendLiveViewAndOtherNotification(std::shared_ptr<ContinuousTaskRecord> record)
 {
+    LoadDeferredNotificationPrompt();
     if (continuousTaskText_.empty()) {
         BGTASK_LOGE("get notification prompt info failed, continuousTaskText_ is empty");
         return ERR_BGTASK_NOTIFICATION_VERIFY_FAILED;
     }
     std::string appName {""};
-    if (cachedBundleInfos_.find(record->uid_) != cachedBundleInfos_.end()) {
-        appName = cachedBundleInfos_.at(record->uid_).appName_;
+    RefillCachedBundleInfo(record);
+    auto cachedIter = cachedBundleInfos_.find(record->uid_);
+    if (cachedIter != cachedBundleInfos_.end()) {
+        appName = cachedIter->second.appName_;
     }
     if (appName.empty()) {
         BGTASK_LOGE("appName is empty");
@@ -3443,6 +3989,7 @@ ErrCode BgContinuousTaskMgr::SendLiveViewAndOtherNotification(std::shared_ptr<Co
     subRecord->bgModeId_ = BackgroundMode::DATA_TRANSFER;
     subRecord->bgModeIds_.push_back(BackgroundMode::DATA_TRANSFER);
     ErrCode ret = SendNotification(subRecord, record, appName, false);
+    ReindexTaskRecord(record);
     if (ret != ERR_OK) {
         return ret;
     }
@@ -3547,9 +4094,10 @@ ErrCode BgContinuousTaskMgr::RequestAuthFromUser(const sptr<ContinuousTaskParam>
     return ERR_BGTASK_SPECIAL_SCENARIO_PROCESSING_NOTSUPPORT_DEVICE;
 #endif
     int32_t apiVersion = taskParam->requestAuthApiVersion_;
-    handler_->PostSyncTask([this, continuousTaskRecord, callback, &notificationId, &ret, apiVersion]() {
+    laneScheduler_->PostSyncTask(handler_, EventLane::IPC,
+        [this, continuousTaskRecord, callback, &notificationId, &ret, apiVersion]() {
         ret = this->RequestAuthFromUserInner(continuousTaskRecord, callback, notificationId, apiVersion);
-        }, AppExecFwk::EventQueue::Priority::HIGH);
+        });
     return ret;
 }
 
@@ -3600,6 +4148,7 @@ ErrCode BgContinuousTaskMgr::CheckAuthParam(std::shared_ptr<ContinuousTaskRecord
 ErrCode BgContinuousTaskMgr::RequestAuthFromUserInner(std::shared_ptr<ContinuousTaskRecord> record,
     const sptr<IExpiredCallback>& callback, int32_t &notificationId, int32_t apiVersion)
 {
+    LoadDeferredNotificationPrompt();
     ErrCode ret = CheckAuthParam(record, callback, apiVersion);
     if (ret != ERR_OK) {
         return ret;
@@ -3704,9 +4253,10 @@ ErrCode BgContinuousTaskMgr::CheckSpecialScenarioAuth(int32_t appIndex, uint32_t
     return ERR_BGTASK_SPECIAL_SCENARIO_PROCESSING_NOTSUPPORT_DEVICE;
 #endif
     ErrCode ret = ERR_OK;
-    handler_->PostSyncTask([this, &authResult, bundleName, userId, appIndex, apiVersion, &ret]() {
+    laneScheduler_->PostSyncTask(handler_, EventLane::IPC,
+        [this, &authResult, bundleName, userId, appIndex, apiVersion, &ret]() {
         ret = this->CheckSpecialScenarioAuthInner(authResult, bundleName, userId, appIndex, apiVersion);
-        }, AppExecFwk::EventQueue::Priority::HIGH);
+        });
     return ret;
 }
 
@@ -3717,9 +4267,9 @@ ErrCode BgContinuousTaskMgr::CheckTaskAuthResult(const std::string &bundleName,
         return ERR_BGTASK_SYS_NOT_READY;
     }
     ErrCode ret = ERR_OK;
-    handler_->PostSyncTask([this, &ret, bundleName, userId, appIndex]() {
+    laneScheduler_->PostSyncTask(handler_, EventLane::IPC, [this, &ret, bundleName, userId, appIndex]() {
         ret = this->CheckTaskAuthResultInner(bundleName, userId, appIndex);
-        }, AppExecFwk::EventQueue::Priority::HIGH);
+        });
     return ret;
 }
 
@@ -3814,9 +4364,9 @@ void BgContinuousTaskMgr::HandleAuthExpiredCallbackDeath(const wptr<IRemoteObjec
         BGTASK_LOGE("expiredCallback death, remote in callback is null.");
         return;
     }
-    handler_->PostSyncTask([this, remote]() {
+    laneScheduler_->PostSyncTask(handler_, EventLane::IPC, [this, remote]() {
         this->HandleAuthExpiredCallbackDeathInner(remote);
-        }, AppExecFwk::EventQueue::Priority::HIGH);
+        });
 }
 
 void BgContinuousTaskMgr::HandleAuthExpiredCallbackDeathInner(const wptr<IRemoteObject> &remote)
@@ -3871,9 +4421,9 @@ ErrCode BgContinuousTaskMgr::SetBackgroundTaskState(std::shared_ptr<BackgroundTa
         return ERR_BGTASK_CONTINUOUS_BACKGROUND_TASK_PARAM_INVALID;
     }
     ErrCode result = ERR_OK;
-    handler_->PostSyncTask([this, taskParam, &result]() {
+    laneScheduler_->PostSyncTask(handler_, EventLane::IPC, [this, taskParam, &result]() {
         result = this->SetBackgroundTaskStateInner(taskParam);
-        }, AppExecFwk::EventQueue::Priority::HIGH);
+        });
     return result;
 }
 
@@ -3925,43 +4475,39 @@ ErrCode BgContinuousTaskMgr::GetBackgroundTaskState(std::shared_ptr<BackgroundTa
         return ERR_BGTASK_CONTINUOUS_BACKGROUND_TASK_PARAM_INVALID;
     }
     ErrCode result = ERR_OK;
-    handler_->PostSyncTask([this, taskParam, &result, &authResult]() {
+    laneScheduler_->PostSyncTask(handler_, EventLane::IPC, [this, taskParam, &result, &authResult]() {
         result = this->GetBackgroundTaskStateInner(taskParam, authResult);
-        }, AppExecFwk::EventQueue::Priority::HIGH);
+        });
     return result;
 }
 
 bool BgContinuousTaskMgr::CheckApplySpecial(const std::string &bundleName, int32_t &userId, bool checkPermission)
 {
-    AppExecFwk::BundleInfo bundleInfo;
-    int32_t flag = static_cast<int32_t>(AppExecFwk::BundleFlag::GET_BUNDLE_WITH_ABILITIES) |
-        static_cast<int32_t>(AppExecFwk::BundleFlag::GET_BUNDLE_WITH_REQUESTED_PERMISSION);
-    if (!BundleManagerHelper::GetInstance()->GetBundleInfoByFlags(bundleName, flag, bundleInfo, userId)) {
+    BundleMetadata metadata;
+    if (!bundleInfoCache_->GetBundleMetadata(bundleName, userId, metadata)) {
         BGTASK_LOGW("get bundleName bundleInfo: %{public}s bundle info failed", bundleName.c_str());
         return false;
     }
     if (!DelayedSingleton<BgtaskConfig>::GetInstance()->IsSpecialExemptedQuatoApp(bundleName) && checkPermission) {
         // 不支持1：没权限、是系统应用
-        int32_t oldPermissionSize = std::count(bundleInfo.reqPermissions.begin(), bundleInfo.reqPermissions.end(),
+        int32_t oldPermissionSize = std::count(metadata.reqPermissions.begin(), metadata.reqPermissions.end(),
             BGMODE_PERMISSION_SYSTEM);
-        int32_t newPermissionSize = std::count(bundleInfo.reqPermissions.begin(), bundleInfo.reqPermissions.end(),
+        int32_t newPermissionSize = std::count(metadata.reqPermissions.begin(), metadata.reqPermissions.end(),
             BGMODE_PERMISSION_SPECIAL_SCENARIO);
         if (oldPermissionSize == 0 && newPermissionSize == 0) {
             BGTASK_LOGW("bundleName: %{public}s not exempted, not have acl.", bundleName.c_str());
             return false;
         }
-        if (bundleInfo.applicationInfo.isSystemApp) {
+        if (metadata.isSystemApp) {
             BGTASK_LOGW("bundleName: %{public}s is system app not exempted.", bundleName.c_str());
             return false;
         }
     }
     // 不支持2：没有配置module
     uint32_t modeType = BG_MODE_INDEX_HEAD << (static_cast<uint32_t>(BackgroundMode::SPECIAL_SCENARIO_PROCESSING) - 1);
-    for (auto abilityInfo : bundleInfo.abilityInfos) {
-        if (abilityInfo.backgroundModes != INVALID_BGMODE) {
-            if ((abilityInfo.backgroundModes & modeType) > 0) {
-                return true;
-            }
+    for (const auto &iter : metadata.abilityBgModes) {
+        if ((iter.second & modeType) > 0) {
+            return true;
         }
     }
     BGTASK_LOGW("bundleName: %{public}s not exempted, not config special mode type.", bundleName.c_str());
@@ -4045,7 +4591,7 @@ void BgContinuousTaskMgr::CancelBgTaskNotificationInner(int32_t uid)
             NotificationTools::GetInstance()->CancelNotification(
                 task.second->GetNotificationLabel(), task.second->GetNotificationId());
             task.second->notificationId_ = -1;
-            RefreshTaskRecord();
+            RefreshTaskRecord(task.first);
             BGTASK_LOGI("uid: %{public}d has live view notification , cancel continuous notification", uid);
             continue;
         }
@@ -4059,9 +4605,9 @@ void BgContinuousTaskMgr::CancelBgTaskNotification(int32_t uid)
         return;
     }
 
-    handler_->PostSyncTask([this, uid]() {
+    laneScheduler_->PostSyncTask(handler_, EventLane::IPC, [this, uid]() {
         this->CancelBgTaskNotificationInner(uid);
-        }, AppExecFwk::EventQueue::Priority::HIGH);
+        });
 }
 
 void BgContinuousTaskMgr::SendNotificationByLiveViewCancelInner(int32_t uid)
@@ -4073,7 +4619,7 @@ void BgContinuousTaskMgr::SendNotificationByLiveViewCancelInner(int32_t uid)
         if (task.second->GetNotificationId() == -1) {
             auto record = task.second;
             SendContinuousTaskNotification(record);
-            RefreshTaskRecord();
+            RefreshTaskRecord(task.first);
         }
     }
 }
@@ -4085,9 +4631,9 @@ void BgContinuousTaskMgr::SendNotificationByLiveViewCancel(int32_t uid)
         return;
     }
 
-    handler_->PostSyncTask([this, uid]() {
+    laneScheduler_->PostSyncTask(handler_, EventLane::IPC, [this, uid]() {
         this->SendNotificationByLiveViewCancelInner(uid);
-        }, AppExecFwk::EventQueue::Priority::HIGH);
+        });
 }
 
 ErrCode BgContinuousTaskMgr::OnBackup(MessageParcel& data, MessageParcel& reply)
@@ -4111,10 +4657,10 @@ ErrCode BgContinuousTaskMgr::OnRestore(MessageParcel& data, MessageParcel& reply
         return ERR_BGTASK_SYS_NOT_READY;
     }
     ErrCode ret;
-    handler_->PostSyncTask([this, &data, &reply, &ret]() {
+    laneScheduler_->PostSyncTask(handler_, EventLane::IPC, [this, &data, &reply, &ret]() {
         ret = DelayedSingleton<DataStorageHelper>::GetInstance()->OnRestore(
             data, reply, this->bannerNotificationRecord_);
-        }, AppExecFwk::EventQueue::Priority::HIGH);
+        });
     DumpAuthRecordInfo(bannerNotificationRecord_);
     return ret;
 }
@@ -4147,10 +4693,13 @@ ErrCode BgContinuousTaskMgr::GetAllContinuousTasksBySystem(std::vector<std::shar
         BGTASK_LOGW("manager is not ready");
         return ERR_BGTASK_SYS_NOT_READY;
     }
+    if (GetAllContinuousTasksFromSnapshot(-1, list, false, true)) {
+        return ERR_OK;
+    }
     ErrCode ret = ERR_OK;
-    handler_->PostSyncTask([this, &list, &ret]() {
+    laneScheduler_->PostSyncTask(handler_, EventLane::IPC, [this, &list, &ret]() {
         ret = this->GetAllContinuousTasksInner(-1, list, false, true);
-        }, AppExecFwk::EventQueue::Priority::HIGH);
+        });
     return ret;
 }
 
@@ -4159,9 +4708,9 @@ void BgContinuousTaskMgr::OnBundleResourcesChanged()
     if (!isSysReady_.load()) {
         BGTASK_LOGW("manager is not ready");
     }
-    handler_->PostSyncTask([this]() {
+    laneScheduler_->PostSyncTask(handler_, EventLane::IPC, [this]() {
         this->OnBundleResourcesChangedInner();
-        }, AppExecFwk::EventQueue::Priority::HIGH);
+        });
 }
 
 bool BgContinuousTaskMgr::InitSubNotificationRecord(const std::shared_ptr<ContinuousTaskRecord> record,
@@ -4190,6 +4739,7 @@ bool BgContinuousTaskMgr::InitSubNotificationRecord(const std::shared_ptr<Contin
 
 void BgContinuousTaskMgr::OnBundleResourcesChangedInner()
 {
+    notificationPromptDeferred_ = false;
     GetNotificationPrompt();
     cachedBundleInfos_.clear();
     std::map<std::string, std::pair<std::string, std::string>> newPromptInfos;
@@ -4244,10 +4794,13 @@ ErrCode BgContinuousTaskMgr::GetAllContinuousTaskApps(std::vector<std::shared_pt
         BGTASK_LOGW("manager is not ready");
         return ERR_BGTASK_SYS_NOT_READY;
     }
+    if (GetContinuousTaskAppsFromSnapshot(list, -1, true)) {
+        return ERR_OK;
+    }
     ErrCode result = ERR_OK;
-    handler_->PostSyncTask([this, &list, &result]() {
+    laneScheduler_->PostSyncTask(handler_, EventLane::IPC, [this, &list, &result]() {
         result = this->GetContinuousTaskAppsInner(list, -1, true);
-        }, AppExecFwk::EventQueue::Priority::HIGH);
+        });
 
     return result;
 }
@@ -4259,9 +4812,9 @@ ErrCode BgContinuousTaskMgr::SendNotificationByDeteTask(const std::set<std::stri
         return ERR_BGTASK_SYS_NOT_READY;
     }
     ErrCode result = ERR_OK;
-    handler_->PostSyncTask([this, &taskKeys, &result]() {
+    laneScheduler_->PostSyncTask(handler_, EventLane::IPC, [this, &taskKeys, &result]() {
         result = this->SendNotificationByDeteTaskInner(taskKeys);
-        }, AppExecFwk::EventQueue::Priority::HIGH);
+        });
     return result;
 }
 
@@ -4343,9 +4896,9 @@ ErrCode BgContinuousTaskMgr::RemoveAuthRecord(const sptr<ContinuousTaskParam> &t
         "", callingUid, callingPid, taskParam->bgModeId_, true, taskParam->bgModeIds_);
     InitRecordParam(record, taskParam, userId);
     ErrCode ret = ERR_OK;
-    handler_->PostSyncTask([this, record, &ret]() {
+    laneScheduler_->PostSyncTask(handler_, EventLane::IPC, [this, record, &ret]() {
         ret = this->RemoveAuthRecordInner(record);
-        }, AppExecFwk::EventQueue::Priority::HIGH);
+        });
     return ret;
 }
 
@@ -4389,24 +4942,27 @@ ErrCode BgContinuousTaskMgr::NotifyAudioStart(const int32_t uid)
 
 void BgContinuousTaskMgr::NotifyAudioStartInner(const int32_t uid)
 {
-    auto findTask = [uid](const auto &target) {
-        return uid == target.second->uid_ && !target.second->audioPlayState_ && target.second->notificationId_ > 0;
+    LoadDeferredNotificationPrompt();
+    auto findTask = [this](const std::string &key) {
+        auto record = continuousTaskInfosMap_.at(key);
+        return !record->audioPlayState_ && record->notificationId_ > 0;
     };
-    auto findTaskIter = find_if(continuousTaskInfosMap_.begin(), continuousTaskInfosMap_.end(), findTask);
-    if (findTaskIter == continuousTaskInfosMap_.end()) {
+    auto keys = continuousTaskInfosMap_.GetKeysByUid(uid);
+    auto findKeyIter = std::find_if(keys.begin(), keys.end(), findTask);
+    if (findKeyIter == keys.end()) {
         return;
     }
+    auto findTaskIter = continuousTaskInfosMap_.find(*findKeyIter);
     string appName = GetMainAbilityLabel(findTaskIter->second->bundleName_, findTaskIter->second->userId_);
     if (appName == "") {
         BGTASK_LOGE("bundleName: %{public}s get app name fail.", findTaskIter->second->bundleName_.c_str());
         return;
     }
     std::map<std::string, std::pair<std::string, std::string>> newPromptInfos;
-    for (const auto &task : continuousTaskInfosMap_) {
-        if (!task.second) {
-            continue;
-        }
-        if (task.second->audioPlayState_ || task.second->notificationId_ == -1 || task.second->uid_ != uid) {
+    std::vector<std::string> changedKeys;
+    for (const auto &key : keys) {
+        auto task = *continuousTaskInfosMap_.find(key);
+        if (task.second->audioPlayState_ || task.second->notificationId_ == -1) {
             continue;
         }
         uint32_t index = GetBgModeNameIndex(BackgroundMode::AUDIO_PLAYBACK, task.second->isNewApi_);
@@ -4421,10 +4977,11 @@ void BgContinuousTaskMgr::NotifyAudioStartInner(const int32_t uid)
         }
         task.second->audioPlayState_ = true;
         newPromptInfos.emplace(task.second->notificationLabel_, std::make_pair(appName, notificationText));
+        changedKeys.emplace_back(task.first);
     }
     if (!newPromptInfos.empty()) {
         NotificationTools::GetInstance()->RefreshContinuousNotifications(newPromptInfos, bgTaskUid_);
-        RefreshTaskRecord();
+        RefreshTaskRecord(changedKeys);
     }
 }
 
@@ -4435,9 +4992,9 @@ void BgContinuousTaskMgr::OnBannerNotificationActionButtonClick(const int32_t bu
         BGTASK_LOGW("manager is not ready");
         return;
     }
-    handler_->PostSyncTask([this, buttonType, uid, label]() {
+    laneScheduler_->PostSyncTask(handler_, EventLane::IPC, [this, buttonType, uid, label]() {
         this->OnBannerNotificationActionButtonClickInner(buttonType, uid, label);
-        }, AppExecFwk::EventQueue::Priority::HIGH);
+        });
 }
 
 void BgContinuousTaskMgr::OnBannerNotificationActionButtonClickInner(const int32_t buttonType,
@@ -4505,13 +5062,11 @@ ErrCode BgContinuousTaskMgr::CancelNotification(const std::shared_ptr<Continuous
     int32_t notificationId = continuousTaskInfo->GetNotificationId();
     if (notificationId != -1) {
         std::string notificationLabel = continuousTaskInfo->GetNotificationLabel();
-        auto findNotification = [notificationId, notificationLabel](const auto &target) {
-            return notificationId == target.second->notificationId_ &&
-                notificationLabel == target.second->notificationLabel_;
+        auto findNotification = [this, notificationId](const std::string &key) {
+            return notificationId == continuousTaskInfosMap_.at(key)->notificationId_;
         };
-        auto findNotificationIter = find_if(continuousTaskInfosMap_.begin(), continuousTaskInfosMap_.end(),
-            findNotification);
-        if (findNotificationIter == continuousTaskInfosMap_.end()) {
+        auto keys = continuousTaskInfosMap_.GetKeysByNotificationLabel(notificationLabel);
+        if (std::none_of(keys.begin(), keys.end(), findNotification)) {
             result = NotificationTools::GetInstance()->CancelNotification(notificationLabel, notificationId);
             int32_t subNotificationId = continuousTaskInfo->GetSubNotificationId();
             if (subNotificationId != -1 && continuousTaskInfo->isByRequestObject_) {
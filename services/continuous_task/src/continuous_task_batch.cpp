@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "continuous_task_batch.h"
+
+namespace OHOS {
+namespace BackgroundTaskMgr {
+void ContinuousTaskBatch::RemoveTask(const std::string &key, const std::shared_ptr<ContinuousTaskRecord> &record)
+{
+    if (record != nullptr) {
+        removedTasks_.emplace_back(record);
+        stoppedUids_.insert(record->GetUid());
+    }
+    UpdateTask(key);
+}
+
+void ContinuousTaskBatch::UpdateTask(const std::string &key)
+{
+    if (changedKeySet_.insert(key).second) {
+        changedKeys_.emplace_back(key);
+    }
+}
+
+void ContinuousTaskBatch::CancelNotification(const std::string &label, int32_t notificationId)
+{
+    if (notificationId == -1) {
+        return;
+    }
+    notifications_.emplace(label, notificationId);
+}
+
+void ContinuousTaskBatch::StopUid(int32_t uid)
+{
+    stoppedUids_.insert(uid);
+}
+
+bool ContinuousTaskBatch::IsEmpty() const
+{
+    return removedTasks_.empty() && changedKeys_.empty() && notifications_.empty() && stoppedUids_.empty();
+}
+
+const std::vector<std::shared_ptr<ContinuousTaskRecord>> &ContinuousTaskBatch::GetRemovedTasks() const
+{
+    return removedTasks_;
+}
+
+const std::vector<std::string> &ContinuousTaskBatch::GetChangedKeys() const
+{
+    return changedKeys_;
+}
+
+const std::set<std::pair<std::string, int32_t>> &ContinuousTaskBatch::GetNotifications() const
+{
+    return notifications_;
+}
+
+const std::set<int32_t> &ContinuousTaskBatch::GetStoppedUids() const
+{
+    return stoppedUids_;
+}
+}  // namespace BackgroundTaskMgr
+}  // namespace OHOS
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "continuous_task_change_log.h"
+
+namespace OHOS {
+namespace BackgroundTaskMgr {
+ContinuousTaskChangeLog::ContinuousTaskChangeLog(size_t capacity) : capacity_(capacity) {}
+
+void ContinuousTaskChangeLog::Reset(uint64_t generation)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+    baseGeneration_ = generation;
+}
+
+void ContinuousTaskChangeLog::Append(uint64_t generation, const std::string &key, ContinuousTaskChangeType type,
+    const std::shared_ptr<const ContinuousTaskCallbackInfo> &removedInfo)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    Entry entry;
+    entry.key = key;
+    entry.change.generation = generation;
+    entry.change.type = type;
+    entry.change.removedInfo = removedInfo;
+    entries_.emplace_back(std::move(entry));
+    while (entries_.size() > capacity_) {
+        // 被裁剪代的变更不再完整，早于该代的调用方需要全量同步
+        baseGeneration_ = entries_.front().change.generation;
+        entries_.pop_front();
+    }
+}
+
+bool ContinuousTaskChangeLog::Collect(uint64_t since, uint64_t until,
+    std::map<std::string, ContinuousTaskChange> &changes)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (since < baseGeneration_) {
+        return false;
+    }
+    // 每个任务记录区间内第一次和最后一次变更，据此得到净变化
+    std::map<std::string, std::pair<ContinuousTaskChangeType, ContinuousTaskChange>> merged;
+    for (const auto &entry : entries_) {
+        if (entry.change.generation <= since || entry.change.generation > until) {
+            continue;
+        }
+        auto iter = merged.find(entry.key);
+        if (iter == merged.end()) {
+            merged.emplace(entry.key, std::make_pair(entry.change.type, entry.change));
+        } else {
+            iter->second.second = entry.change;
+        }
+    }
+    for (const auto &iter : merged) {
+        bool existedBefore = iter.second.first != ContinuousTaskChangeType::ADDED;
+        ContinuousTaskChange change = iter.second.second;
+        bool existsNow = change.type != ContinuousTaskChangeType::REMOVED;
+        if (!existedBefore && !existsNow) {
+            continue;
+        }
+        if (existedBefore && existsNow) {
+            change.type = ContinuousTaskChangeType::UPDATED;
+        } else if (existsNow) {
+            change.type = ContinuousTaskChangeType::ADDED;
+        }
+        changes.emplace(iter.first, change);
+    }
+    return true;
+}
+
+size_t ContinuousTaskChangeLog::size()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+}
+}  // namespace BackgroundTaskMgr
+}  // namespace OHOS
@@ -174,6 +174,12 @@ int32_t ContinuousTaskRecord::GetAppIndex() const
 std::string ContinuousTaskRecord::ParseToJsonStr()
 {
     nlohmann::json root;
+    ParseToJson(root);
+    return root.dump(CommonUtils::jsonFormat_);
+}
+
+void ContinuousTaskRecord::ParseToJson(nlohmann::json &root)
+{
     root["bundleName"] = bundleName_;
     root["abilityName"] = abilityName_;
     root["userId"] = userId_;
@@ -209,7 +215,6 @@ std::string ContinuousTaskRecord::ParseToJsonStr()
     root["isStandby"] = isStandby_;
     root["audioPlayState"] = audioPlayState_;
     root["isStandbySuspend"] = isStandbySuspend_;
-    return root.dump(CommonUtils::jsonFormat_);
 }
 
 bool CheckContinuousRecod(const nlohmann::json &value)
@@ -0,0 +1,277 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "continuous_task_table.h"
+
+namespace OHOS {
+namespace BackgroundTaskMgr {
+namespace {
+constexpr uint32_t ABILITY_INDEX_UID_SHIFT = 32;
+
+template<typename Index, typename Key>
+void EraseIndexKey(Index &index, const Key &indexKey, const std::string &key)
+{
+    auto iter = index.find(indexKey);
+    if (iter == index.end()) {
+        return;
+    }
+    iter->second.erase(key);
+    if (iter->second.empty()) {
+        index.erase(iter);
+    }
+}
+}
+
+ContinuousTaskTable::iterator ContinuousTaskTable::begin()
+{
+    return records_.begin();
+}
+
+ContinuousTaskTable::iterator ContinuousTaskTable::end()
+{
+    return records_.end();
+}
+
+ContinuousTaskTable::const_iterator ContinuousTaskTable::begin() const
+{
+    return records_.begin();
+}
+
+ContinuousTaskTable::const_iterator ContinuousTaskTable::end() const
+{
+    return records_.end();
+}
+
+size_t ContinuousTaskTable::size() const
+{
+    return records_.size();
+}
+
+bool ContinuousTaskTable::empty() const
+{
+    return records_.empty();
+}
+
+void ContinuousTaskTable::clear()
+{
+    records_.clear();
+    indexedFields_.clear();
+    uidIndex_.clear();
+    labelIndex_.clear();
+    abilityIndex_.clear();
+    taskIdIndex_.clear();
+    dirtyKeys_.clear();
+    generation_++;
+}
+
+ContinuousTaskTable::iterator ContinuousTaskTable::find(const std::string &key)
+{
+    return records_.find(key);
+}
+
+ContinuousTaskTable::const_iterator ContinuousTaskTable::find(const std::string &key) const
+{
+    return records_.find(key);
+}
+
+const std::shared_ptr<ContinuousTaskRecord> &ContinuousTaskTable::at(const std::string &key) const
+{
+    return records_.at(key);
+}
+
+std::pair<ContinuousTaskTable::iterator, bool> ContinuousTaskTable::emplace(const std::string &key,
+    const std::shared_ptr<ContinuousTaskRecord> &record)
+{
+    auto result = records_.emplace(key, record);
+    if (result.second) {
+        AddIndex(key, record);
+        generation_++;
+    }
+    return result;
+}
+
+ContinuousTaskTable::iterator ContinuousTaskTable::erase(iterator iter)
+{
+    RemoveIndex(iter->first);
+    dirtyKeys_.erase(iter->first);
+    generation_++;
+    return records_.erase(iter);
+}
+
+size_t ContinuousTaskTable::erase(const std::string &key)
+{
+    auto iter = records_.find(key);
+    if (iter == records_.end()) {
+        return 0;
+    }
+    erase(iter);
+    return 1;
+}
+
+std::shared_ptr<ContinuousTaskRecord> &ContinuousTaskTable::operator[](const std::string &key)
+{
+    // 通过引用可能替换记录，延迟到下次查询前重建该键的索引
+    dirtyKeys_.insert(key);
+    generation_++;
+    return records_[key];
+}
+
+void ContinuousTaskTable::Reset(TaskMap &&records)
+{
+    clear();
+    records_ = std::move(records);
+    for (const auto &iter : records_) {
+        AddIndex(iter.first, iter.second);
+    }
+}
+
+void ContinuousTaskTable::Reindex(const std::string &key)
+{
+    RemoveIndex(key);
+    dirtyKeys_.erase(key);
+    auto iter = records_.find(key);
+    if (iter != records_.end()) {
+        AddIndex(key, iter->second);
+    }
+}
+
+const ContinuousTaskTable::TaskMap &ContinuousTaskTable::GetRecords() const
+{
+    return records_;
+}
+
+uint64_t ContinuousTaskTable::GetGeneration() const
+{
+    return generation_.load();
+}
+
+std::vector<std::string> ContinuousTaskTable::GetKeysByUid(int32_t uid)
+{
+    SyncIndex();
+    auto iter = uidIndex_.find(uid);
+    if (iter == uidIndex_.end()) {
+        return {};
+    }
+    return CollectKeys(iter->second, [uid](const std::shared_ptr<ContinuousTaskRecord> &record) {
+        return record->uid_ == uid;
+    });
+}
+
+std::vector<std::string> ContinuousTaskTable::GetKeysByNotificationLabel(const std::string &label)
+{
+    SyncIndex();
+    auto iter = labelIndex_.find(label);
+    if (iter == labelIndex_.end()) {
+        return {};
+    }
+    return CollectKeys(iter->second, [&label](const std::shared_ptr<ContinuousTaskRecord> &record) {
+        return record->notificationLabel_ == label;
+    });
+}
+
+std::vector<std::string> ContinuousTaskTable::GetKeysByAbility(int32_t uid, int32_t abilityId)
+{
+    SyncIndex();
+    auto iter = abilityIndex_.find(GetAbilityIndexKey(uid, abilityId));
+    if (iter == abilityIndex_.end()) {
+        return {};
+    }
+    return CollectKeys(iter->second, [uid, abilityId](const std::shared_ptr<ContinuousTaskRecord> &record) {
+        return record->uid_ == uid && record->abilityId_ == abilityId;
+    });
+}
+
+ContinuousTaskTable::iterator ContinuousTaskTable::FindByContinuousTaskId(int32_t continuousTaskId)
+{
+    SyncIndex();
+    auto iter = taskIdIndex_.find(continuousTaskId);
+    if (iter == taskIdIndex_.end()) {
+        return records_.end();
+    }
+    auto keys = CollectKeys(iter->second, [continuousTaskId](const std::shared_ptr<ContinuousTaskRecord> &record) {
+        return record->continuousTaskId_ == continuousTaskId;
+    });
+    return keys.empty() ? records_.end() : records_.find(keys.front());
+}
+
+uint64_t ContinuousTaskTable::GetAbilityIndexKey(int32_t uid, int32_t abilityId)
+{
+    return (static_cast<uint64_t>(static_cast<uint32_t>(uid)) << ABILITY_INDEX_UID_SHIFT) |
+        static_cast<uint32_t>(abilityId);
+}
+
+void ContinuousTaskTable::AddIndex(const std::string &key, const std::shared_ptr<ContinuousTaskRecord> &record)
+{
+    if (record == nullptr) {
+        return;
+    }
+    IndexedFields fields;
+    fields.uid = record->uid_;
+    fields.abilityId = record->abilityId_;
+    fields.continuousTaskId = record->continuousTaskId_;
+    fields.notificationLabel = record->notificationLabel_;
+    uidIndex_[fields.uid].insert(key);
+    labelIndex_[fields.notificationLabel].insert(key);
+    abilityIndex_[GetAbilityIndexKey(fields.uid, fields.abilityId)].insert(key);
+    taskIdIndex_[fields.continuousTaskId].insert(key);
+    indexedFields_[key] = std::move(fields);
+}
+
+void ContinuousTaskTable::RemoveIndex(const std::string &key)
+{
+    auto iter = indexedFields_.find(key);
+    if (iter == indexedFields_.end()) {
+        return;
+    }
+    const IndexedFields &fields = iter->second;
+    EraseIndexKey(uidIndex_, fields.uid, key);
+    EraseIndexKey(labelIndex_, fields.notificationLabel, key);
+    EraseIndexKey(abilityIndex_, GetAbilityIndexKey(fields.uid, fields.abilityId), key);
+    EraseIndexKey(taskIdIndex_, fields.continuousTaskId, key);
+    indexedFields_.erase(iter);
+}
+
+void ContinuousTaskTable::SyncIndex()
+{
+    if (dirtyKeys_.empty()) {
+        return;
+    }
+    KeySet dirtyKeys;
+    dirtyKeys.swap(dirtyKeys_);
+    for (const auto &key : dirtyKeys) {
+        Reindex(key);
+    }
+}
+
+std::vector<std::string> ContinuousTaskTable::CollectKeys(const KeySet &keys, const RecordMatcher &matcher)
+{
+    std::vector<std::string> result;
+    std::vector<std::string> staleKeys;
+    for (const auto &key : keys) {
+        auto iter = records_.find(key);
+        if (iter != records_.end() && iter->second != nullptr && matcher(iter->second)) {
+            result.emplace_back(key);
+        } else {
+            staleKeys.emplace_back(key);
+        }
+    }
+    // 索引字段被原地修改过，校验不通过的键重新建立索引
+    for (const auto &key : staleKeys) {
+        Reindex(key);
+    }
+    return result;
+}
+}  // namespace BackgroundTaskMgr
+}  // namespace OHOS
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "notification_pipeline.h"
+
+#include "continuous_task_log.h"
+
+namespace OHOS {
+namespace BackgroundTaskMgr {
+namespace {
+const std::string NOTIFICATION_RUNNER_NAME = "BgtaskNotification";
+const std::string TASK_DRAIN_NOTIFICATION = "DrainNotification";
+}
+
+NotificationPipeline::NotificationPipeline()
+{
+    auto runner = AppExecFwk::EventRunner::Create(NOTIFICATION_RUNNER_NAME);
+    handler_ = std::make_shared<AppExecFwk::EventHandler>(runner);
+}
+
+NotificationPipeline::~NotificationPipeline() {}
+
+void NotificationPipeline::Publish(const std::string &label, int32_t id, const Action &action)
+{
+    Enqueue(std::make_pair(label, id), action);
+}
+
+void NotificationPipeline::Cancel(const std::string &label, int32_t id, const Action &action)
+{
+    Enqueue(std::make_pair(label, id), action);
+}
+
+void NotificationPipeline::Enqueue(const RequestKey &key, const Action &action)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto iter = pending_.find(key);
+        if (iter != pending_.end()) {
+            coalescedCount_++;
+            iter->second = action;
+            return;
+        }
+        pending_.emplace(key, action);
+        order_.emplace_back(key);
+    }
+    if (handler_ == nullptr) {
+        Drain();
+        return;
+    }
+    handler_->PostTask([this]() { this->Drain(); }, TASK_DRAIN_NOTIFICATION);
+}
+
+void NotificationPipeline::Drain()
+{
+    while (true) {
+        RequestKey key;
+        Action action;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (order_.empty()) {
+                return;
+            }
+            key = order_.front();
+            order_.pop_front();
+            auto iter = pending_.find(key);
+            if (iter == pending_.end()) {
+                continue;
+            }
+            action = iter->second;
+            pending_.erase(iter);
+        }
+        if (action && action() != ERR_OK) {
+            BGTASK_LOGE("deliver notification request failed, %{public}s, %{public}d", key.first.c_str(),
+                key.second);
+        }
+    }
+}
+
+void NotificationPipeline::Flush()
+{
+    if (handler_ == nullptr) {
+        Drain();
+        return;
+    }
+    handler_->PostSyncTask([this]() { this->Drain(); });
+}
+
+size_t NotificationPipeline::GetPendingCount()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pending_.size();
+}
+
+uint64_t NotificationPipeline::GetCoalescedCount()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return coalescedCount_;
+}
+}  // namespace BackgroundTaskMgr
+}  // namespace OHOS
@@ -21,6 +21,7 @@
 #include "want_agent_helper.h"
 #endif
 #include "continuous_task_log.h"
+#include "notification_pipeline.h"
 #include "string_wrapper.h"
 #include "common_utils.h"
 #include "int_wrapper.h"
@@ -93,6 +94,27 @@ Notification::NotificationRequest CreateNotificationRequest(
     notificationRequest.SetOwnerUid(continuousTaskRecord->GetUid());
     return notificationRequest;
 }
+
+ErrCode PublishNotificationRequest(const Notification::NotificationRequest &notificationRequest, bool isNew)
+{
+    // 首次发布同步下发，失败时返回错误由调用方放弃该任务；已发布通知的更新交由通知流水线异步下发
+    if (isNew) {
+        if (Notification::NotificationHelper::PublishNotification(notificationRequest) != ERR_OK) {
+            BGTASK_LOGE("publish notification error, %{public}s, %{public}d", notificationRequest.GetLabel().c_str(),
+                notificationRequest.GetNotificationId());
+            return ERR_BGTASK_NOTIFICATION_ERR;
+        }
+        return ERR_OK;
+    }
+    DelayedSingleton<NotificationPipeline>::GetInstance()->Publish(notificationRequest.GetLabel(),
+        notificationRequest.GetNotificationId(), [notificationRequest]() mutable -> ErrCode {
+        if (Notification::NotificationHelper::PublishNotification(notificationRequest) != ERR_OK) {
+            return ERR_BGTASK_NOTIFICATION_ERR;
+        }
+        return ERR_OK;
+    });
+    return ERR_OK;
+}
 #endif
 
 WEAK_FUNC ErrCode NotificationTools::PublishNotification(
@@ -134,18 +156,18 @@ WEAK_FUNC ErrCode NotificationTools::PublishNotification(
         notificationRequest.SetUnremovable(true);
         notificationRequest.SetTapDismissed(false);
     }
-    if (continuousTaskRecord->GetNotificationId() == -1) {
+    bool isNew = continuousTaskRecord->GetNotificationId() == -1;
+    if (isNew) {
         notificationRequest.SetNotificationId(++notificationIdIndex_);
     } else {
         notificationRequest.SetNotificationId(continuousTaskRecord->GetNotificationId());
     }
-    if (Notification::NotificationHelper::PublishNotification(notificationRequest) != ERR_OK) {
-        BGTASK_LOGE("publish notification error, %{public}s, %{public}d", notificationLabel.c_str(),
-            continuousTaskRecord->notificationId_);
-        return ERR_BGTASK_NOTIFICATION_ERR;
+    ErrCode ret = PublishNotificationRequest(notificationRequest, isNew);
+    if (ret != ERR_OK) {
+        return ret;
     }
     continuousTaskRecord->notificationLabel_ = notificationLabel;
-    if (continuousTaskRecord->GetNotificationId() == -1) {
+    if (isNew) {
         continuousTaskRecord->notificationId_ = notificationIdIndex_;
     }
 #endif
@@ -155,10 +177,13 @@ WEAK_FUNC ErrCode NotificationTools::PublishNotification(
 WEAK_FUNC ErrCode NotificationTools::CancelNotification(const std::string &label, int32_t id)
 {
 #ifdef DISTRIBUTED_NOTIFICATION_ENABLE
-    if (Notification::NotificationHelper::CancelNotification(label, id) != ERR_OK) {
-        BGTASK_LOGE("CancelNotification error label %{public}s, id %{public}d", label.c_str(), id);
-        return ERR_BGTASK_NOTIFICATION_ERR;
-    }
+    DelayedSingleton<NotificationPipeline>::GetInstance()->Cancel(label, id, [label, id]() -> ErrCode {
+        if (Notification::NotificationHelper::CancelNotification(label, id) != ERR_OK) {
+            BGTASK_LOGE("CancelNotification error label %{public}s, id %{public}d", label.c_str(), id);
+            return ERR_BGTASK_NOTIFICATION_ERR;
+        }
+        return ERR_OK;
+    });
 #endif
     return ERR_OK;
 }
@@ -166,6 +191,7 @@ WEAK_FUNC ErrCode NotificationTools::CancelNotification(const std::string &label
 WEAK_FUNC void NotificationTools::GetAllActiveNotificationsLabels(std::set<std::string> &notificationLabels)
 {
 #ifdef DISTRIBUTED_NOTIFICATION_ENABLE
+    DelayedSingleton<NotificationPipeline>::GetInstance()->Flush();
     std::vector<sptr<Notification::Notification>> notifications;
     ErrCode ret = Notification::NotificationHelper::GetAllActiveNotifications(notifications);
     if (ret != ERR_OK) {
@@ -186,6 +212,7 @@ WEAK_FUNC void NotificationTools::RefreshContinuousNotifications(
         BGTASK_LOGI("newPromptInfos is empty.");
         return;
     }
+    DelayedSingleton<NotificationPipeline>::GetInstance()->Flush();
     std::vector<sptr<Notification::NotificationRequest>> notificationRequests;
     ErrCode ret = Notification::NotificationHelper::GetActiveNotifications(notificationRequests);
     if (ret != ERR_OK) {
@@ -213,6 +240,7 @@ WEAK_FUNC ErrCode NotificationTools::RefreshContinuousNotificationWantAndContext
     const std::shared_ptr<ContinuousTaskRecord> continuousTaskRecord, bool updateContent)
 {
 #ifdef DISTRIBUTED_NOTIFICATION_ENABLE
+    DelayedSingleton<NotificationPipeline>::GetInstance()->Flush();
     std::vector<sptr<Notification::NotificationRequest>> notificationRequests;
     ErrCode ret = Notification::NotificationHelper::GetActiveNotifications(notificationRequests);
     if (ret != ERR_OK) {
@@ -296,18 +324,18 @@ WEAK_FUNC ErrCode NotificationTools::PublishMainNotification(const std::shared_p
     notificationRequest.SetUpdateByOwnerAllowed(true);
     notificationRequest.SetSlotType(Notification::NotificationConstant::SlotType::LIVE_VIEW);
     notificationRequest.SetLabel(notificationLabel);
-    if (mainRecord->GetNotificationId() == -1) {
+    bool isNew = mainRecord->GetNotificationId() == -1;
+    if (isNew) {
         notificationRequest.SetNotificationId(++notificationIdIndex_);
     } else {
         notificationRequest.SetNotificationId(mainRecord->GetNotificationId());
     }
-    if (Notification::NotificationHelper::PublishNotification(notificationRequest) != ERR_OK) {
-        BGTASK_LOGE("publish notification error, %{public}s, %{public}d", notificationLabel.c_str(),
-            mainRecord->notificationId_);
-        return ERR_BGTASK_NOTIFICATION_ERR;
+    ErrCode ret = PublishNotificationRequest(notificationRequest, isNew);
+    if (ret != ERR_OK) {
+        return ret;
     }
     mainRecord->notificationLabel_ = notificationLabel;
-    if (mainRecord->GetNotificationId() == -1) {
+    if (isNew) {
         mainRecord->notificationId_ = notificationIdIndex_;
     }
 #endif
@@ -352,18 +380,18 @@ WEAK_FUNC ErrCode NotificationTools::PublishSubNotification(const std::shared_pt
     notificationRequest.SetUnremovable(true);
     notificationRequest.SetTapDismissed(false);
     notificationRequest.SetLabel(notificationLabel);
-    if (mainRecord->GetSubNotificationId() == -1) {
+    bool isNew = mainRecord->GetSubNotificationId() == -1;
+    if (isNew) {
         notificationRequest.SetNotificationId(++notificationIdIndex_);
     } else {
         notificationRequest.SetNotificationId(mainRecord->GetSubNotificationId());
     }
-    if (Notification::NotificationHelper::PublishNotification(notificationRequest) != ERR_OK) {
-        BGTASK_LOGE("publish notification error, %{public}s, %{public}d", notificationLabel.c_str(),
-            notificationIdIndex_);
-        return ERR_BGTASK_NOTIFICATION_ERR;
+    ErrCode ret = PublishNotificationRequest(notificationRequest, isNew);
+    if (ret != ERR_OK) {
+        return ret;
     }
     mainRecord->subNotificationLabel_ = notificationLabel;
-    if (mainRecord->GetSubNotificationId() == -1) {
+    if (isNew) {
         mainRecord->subNotificationId_ = notificationIdIndex_;
     }
 #endif
@@ -488,6 +516,7 @@ WEAK_FUNC void NotificationTools::RefreshBannerNotifications(const std::vector<s
         return;
     }
 #ifdef DISTRIBUTED_NOTIFICATION_ENABLE
+    DelayedSingleton<NotificationPipeline>::GetInstance()->Flush();
     std::vector<sptr<Notification::NotificationRequest>> notificationRequests;
     ErrCode ret = Notification::NotificationHelper::GetActiveNotifications(notificationRequests);
     if (ret != ERR_OK) {
@@ -94,6 +94,9 @@ public:
     ErrCode SuspendContinuousTask(
         int32_t uid, int32_t pid, int32_t reason, const std::string &key, bool isStandby = false) override;
     ErrCode ActiveContinuousTask(int32_t uid, int32_t pid, const std::string &key) override;
+    ErrCode StopContinuousTasks(const std::vector<ContinuousTaskControlInfo> &taskList, uint32_t taskType) override;
+    ErrCode SuspendContinuousTasks(const std::vector<ContinuousTaskControlInfo> &taskList, bool isStandby) override;
+    ErrCode ActiveContinuousTasks(const std::vector<ContinuousTaskControlInfo> &taskList) override;
     ErrCode AVSessionNotifyUpdateNotification(int32_t uid, int32_t pid, bool isPublish = false) override;
     ErrCode SetBgTaskConfig(const std::string &configData, int32_t sourceType) override;
     ErrCode SuspendContinuousAudioTask(int32_t uid) override;
@@ -111,6 +114,9 @@ public:
     ErrCode GetAllContinuousTasksBySystem(std::vector<std::shared_ptr<ContinuousTaskInfo>> &list) override;
     ErrCode SetSpecialExemptedProcess(const std::set<std::string> &bundleNameSet) override;
     ErrCode GetAllContinuousTaskApps(std::vector<ContinuousTaskCallbackInfo> &list) override;
+    ErrCode GetContinuousTaskAppsDelta(uint64_t sinceGeneration, uint64_t &generation, bool &isFullResync,
+        std::vector<ContinuousTaskCallbackInfo> &addedList, std::vector<ContinuousTaskCallbackInfo> &updatedList,
+        std::vector<ContinuousTaskCallbackInfo> &removedList) override;
     ErrCode SendNotificationByDeteTask(const std::set<std::string> &taskKeys) override;
     ErrCode RemoveAuthRecord(const ContinuousTaskParam &taskParam) override;
     int32_t Dump(int32_t fd, const std::vector<std::u16string> &args) override;
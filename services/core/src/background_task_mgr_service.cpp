@@ -26,9 +26,15 @@
 #include "common_event_manager.h"
 #include "common_event_support.h"
 #include "common_utils.h"
+#include "data_storage_helper.h"
+#include "event_lane_scheduler.h"
 #include "file_ex.h"
+#include "foreground_app_tracker.h"
+#include "init_step_graph.h"
+#include "notification_pipeline.h"
 #include "ipc_skeleton.h"
 #include "string_ex.h"
+#include "subscriber_dispatcher.h"
 #include "xcollie/xcollie.h"
 #include "xcollie/xcollie_define.h"
 
@@ -42,6 +48,8 @@ namespace {
 static constexpr int32_t NO_DUMP_PARAM_NUMS = 0;
 static constexpr int32_t RESOURCE_SCHEDULE_SERVICE_UID = 1096;
 static constexpr uint32_t CHECK_TIMEOUT = 10;
+// 批量暂停、激活、停止长时任务单次请求的最大条目数
+static constexpr size_t MAX_CONTROL_TASK_LIST_SIZE = 512;
 static constexpr char BGMODE_PERMISSION[] = "ohos.permission.KEEP_BACKGROUND_RUNNING";
 static constexpr char SET_BACKGROUND_TASK_STATE_PERMISSION[] = "ohos.permission.SET_BACKGROUND_TASK_STATE";
 static constexpr char GET_BACKGROUND_TASK_INFO_PERMISSION[] = "ohos.permission.GET_BACKGROUND_TASK_INFO";
@@ -118,6 +126,10 @@ int32_t BackgroundTaskMgrService::OnExtension(const std::string& extension, Mess
 void BackgroundTaskMgrService::OnAddSystemAbility(int32_t systemAbilityId, const std::string& deviceId)
 {
     BgTaskHiTraceChain traceChain(__func__);
+    if (systemAbilityId == APP_MGR_SERVICE_ID || systemAbilityId == RES_SCHED_SYS_ABILITY_ID) {
+        // 应用管理服务或转发进程事件的资源调度服务上线、重启后，期间的事件可能丢失，全量同步一次前台状态
+        DelayedSingleton<ForegroundAppTracker>::GetInstance()->Resync();
+    }
     DelayedSingleton<BgEfficiencyResourcesMgr>::GetInstance()->OnAddSystemAbility(systemAbilityId, deviceId);
 }
 
@@ -133,9 +145,17 @@ void BackgroundTaskMgrService::Init()
 {
     BgTaskHiTraceChain traceChain(__func__);
     runner_ = AppExecFwk::EventRunner::Create(BGTASK_SERVICE_NAME);
-    DelayedSingleton<BgTransientTaskMgr>::GetInstance()->Init(runner_);
-    DelayedSingleton<BgEfficiencyResourcesMgr>::GetInstance()->Init(runner_);
-    BgContinuousTaskMgr::GetInstance()->Init(runner_);
+    // 各管理模块的初始化互不依赖，并行执行，各自就绪后通过 SetReady 上报
+    InitStepGraph initGraph("BackgroundTaskMgrService");
+    initGraph.AddStep("BgTransientTaskMgr", [this]() {
+        DelayedSingleton<BgTransientTaskMgr>::GetInstance()->Init(runner_);
+        return true;
+    });
+    initGraph.AddStep("BgEfficiencyResourcesMgr",
+        [this]() { return DelayedSingleton<BgEfficiencyResourcesMgr>::GetInstance()->Init(runner_); });
+    initGraph.AddStep("BgContinuousTaskMgr",
+        [this]() { return BgContinuousTaskMgr::GetInstance()->Init(runner_); }, {}, true);
+    initGraph.Run();
 }
 
 void BackgroundTaskMgrService::OnStop()
@@ -143,6 +163,9 @@ void BackgroundTaskMgrService::OnStop()
     BgTaskHiTraceChain traceChain(__func__);
     BgContinuousTaskMgr::GetInstance()->Clear();
     DelayedSingleton<BgEfficiencyResourcesMgr>::GetInstance()->Clear();
+    DelayedSingleton<DataStorageHelper>::GetInstance()->FlushPendingRecord();
+    DelayedSingleton<NotificationPipeline>::GetInstance()->Flush();
+    DelayedSingleton<SubscriberDispatcher>::GetInstance()->Flush();
     state_ = ServiceRunningState::STATE_NOT_START;
     BGTASK_LOGI("background task manager stop");
 }
@@ -574,6 +597,51 @@ ErrCode BackgroundTaskMgrService::ActiveContinuousTask(int32_t uid, int32_t pid,
     return ERR_OK;
 }
 
+ErrCode BackgroundTaskMgrService::StopContinuousTasks(const std::vector<ContinuousTaskControlInfo> &taskList,
+    uint32_t taskType)
+{
+    BgTaskHiTraceChain traceChain(__func__);
+    if (!CheckCallingToken() || !CheckCallingProcess()) {
+        BGTASK_LOGW("StopContinuousTasks not allowed");
+        return ERR_BGTASK_PERMISSION_DENIED;
+    }
+    if (taskList.size() > MAX_CONTROL_TASK_LIST_SIZE) {
+        BGTASK_LOGE("StopContinuousTasks too many tasks: %{public}zu", taskList.size());
+        return ERR_BGTASK_INVALID_PARAM;
+    }
+    BgContinuousTaskMgr::GetInstance()->StopContinuousTasks(taskList, taskType);
+    return ERR_OK;
+}
+
+ErrCode BackgroundTaskMgrService::SuspendContinuousTasks(const std::vector<ContinuousTaskControlInfo> &taskList,
+    bool isStandby)
+{
+    if (!CheckCallingToken() || !CheckCallingProcess()) {
+        BGTASK_LOGW("SuspendContinuousTasks not allowed");
+        return ERR_BGTASK_PERMISSION_DENIED;
+    }
+    if (taskList.size() > MAX_CONTROL_TASK_LIST_SIZE) {
+        BGTASK_LOGE("SuspendContinuousTasks too many tasks: %{public}zu", taskList.size());
+        return ERR_BGTASK_INVALID_PARAM;
+    }
+    BgContinuousTaskMgr::GetInstance()->SuspendContinuousTasks(taskList, isStandby);
+    return ERR_OK;
+}
+
+ErrCode BackgroundTaskMgrService::ActiveContinuousTasks(const std::vector<ContinuousTaskControlInfo> &taskList)
+{
+    if (!CheckCallingToken() || !CheckCallingProcess()) {
+        BGTASK_LOGW("ActiveContinuousTasks not allowed");
+        return ERR_BGTASK_PERMISSION_DENIED;
+    }
+    if (taskList.size() > MAX_CONTROL_TASK_LIST_SIZE) {
+        BGTASK_LOGE("ActiveContinuousTasks too many tasks: %{public}zu", taskList.size());
+        return ERR_BGTASK_INVALID_PARAM;
+    }
+    BgContinuousTaskMgr::GetInstance()->ActiveContinuousTasks(taskList);
+    return ERR_OK;
+}
+
 ErrCode BackgroundTaskMgrService::AVSessionNotifyUpdateNotification(int32_t uid, int32_t pid, bool isPublish)
 {
     if (!CheckCallingToken()) {
@@ -809,6 +877,34 @@ ErrCode BackgroundTaskMgrService::GetAllContinuousTaskApps(std::vector<Continuou
     return result;
 }
 
+ErrCode BackgroundTaskMgrService::GetContinuousTaskAppsDelta(uint64_t sinceGeneration, uint64_t &generation,
+    bool &isFullResync, std::vector<ContinuousTaskCallbackInfo> &addedList,
+    std::vector<ContinuousTaskCallbackInfo> &updatedList, std::vector<ContinuousTaskCallbackInfo> &removedList)
+{
+    if (!CheckCallingToken() || !CheckCallingProcess()) {
+        return ERR_BGTASK_PERMISSION_DENIED;
+    }
+    ContinuousTaskAppsDelta delta;
+    ErrCode result = BgContinuousTaskMgr::GetInstance()->GetContinuousTaskAppsDelta(sinceGeneration, delta);
+    if (result != ERR_OK) {
+        return result;
+    }
+    generation = delta.generation;
+    isFullResync = delta.isFullResync;
+    auto copyList = [](const std::vector<std::shared_ptr<ContinuousTaskCallbackInfo>> &from,
+        std::vector<ContinuousTaskCallbackInfo> &to) {
+        for (const auto &ptr : from) {
+            if (ptr != nullptr) {
+                to.push_back(*ptr);
+            }
+        }
+    };
+    copyList(delta.addedList, addedList);
+    copyList(delta.updatedList, updatedList);
+    copyList(delta.removedList, removedList);
+    return result;
+}
+
 ErrCode BackgroundTaskMgrService::SendNotificationByDeteTask(const std::set<std::string> &taskKeys)
 {
     if (!CheckCallingToken() || !CheckCallingProcess()) {
@@ -875,6 +971,9 @@ int32_t BackgroundTaskMgrService::Dump(int32_t fd, const std::vector<std::u16str
             ret = BgContinuousTaskMgr::GetInstance()->ShellDump(argsInStr, infos);
         } else if (argsInStr[0] == "-E") {
             ret = DelayedSingleton<BgEfficiencyResourcesMgr>::GetInstance()->ShellDump(argsInStr, infos);
+        } else if (argsInStr[0] == "-L") {
+            DelayedSingleton<EventLaneScheduler>::GetInstance()->DumpLaneMetrics(infos);
+            DelayedSingleton<SubscriberDispatcher>::GetInstance()->DumpDispatcherInfo(infos);
         } else {
             infos.emplace_back("Error params.\n");
             ret = ERR_BGTASK_INVALID_PARAM;
@@ -910,7 +1009,9 @@ void BackgroundTaskMgrService::DumpUsage(std::string &result)
     "        --all                                list all efficiency resource aplications\n"
     "        --reset_all                          reset all efficiency resource aplications\n"
     "        --resetapp {uid} {resources}          reset one application of uid by specifying \n"
-    "        --resetproc {pid} {resources}         reset one application of pid by specifying \n";
+    "        --resetproc {pid} {resources}         reset one application of pid by specifying \n"
+    "    -L                                   list queue metrics of service event lanes and\n"
+    "                                         subscriber dispatcher\n";
 
     result.append(dumpHelpMsg);
 }  // namespace
@@ -24,6 +24,7 @@
 #include "singleton.h"
 #include "event_runner.h"
 #include "event_handler.h"
+#include "event_lane_scheduler.h"
 #include "event_info.h"
 #include "running_process_info.h"
 #include "app_mgr_client.h"
@@ -105,7 +106,8 @@ private:
     void EraseRecordIf(ResourceRecordMap &infoMap, const std::function<bool(ResourceRecordPair)> &fun);
     void RecoverDelayedTask(bool isProcess, ResourceRecordMap& infoMap);
     void HandlePersistenceData();
-    void CheckPersistenceData(const std::vector<AppExecFwk::RunningProcessInfo> &allProcesses);
+    bool IsPersistenceDataAlive(const std::set<int32_t> &runningIds, int32_t mapKey,
+        const std::shared_ptr<ResourceApplicationRecord> &record, bool isProcess);
     void RemoveListRecord(std::list<PersistTime> &resourceUnitList, uint32_t eraseBit);
     void GetEfficiencyResourcesInfosInner(const ResourceRecordMap &infoMap,
         std::vector<std::shared_ptr<ResourceCallbackInfo>> &list);
@@ -141,6 +143,7 @@ private:
     std::atomic<bool> isSysReady_ {false};
     std::mutex sysAbilityLock_;
     std::shared_ptr<AppExecFwk::EventHandler> handler_ {nullptr};
+    std::shared_ptr<EventLaneScheduler> laneScheduler_ {DelayedSingleton<EventLaneScheduler>::GetInstance()};
     std::unordered_map<int32_t, std::shared_ptr<ResourceApplicationRecord>> appResourceApplyMap_ {};
     std::unordered_map<int32_t, std::shared_ptr<ResourceApplicationRecord>> procResourceApplyMap_ {};
     std::shared_ptr<ResourcesSubscriberMgr> subscriberMgr_ {nullptr};
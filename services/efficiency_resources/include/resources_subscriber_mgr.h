@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2022-2025 Huawei Device Co., Ltd.
+ * Copyright (c) 2022-2026 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -26,6 +26,8 @@
 
 #include "bgtaskmgr_inner_errors.h"
 #include "ibackground_task_subscriber.h"
+#include "subscriber_event_parcel.h"
+#include "subscriber_registry.h"
 
 namespace OHOS {
 namespace BackgroundTaskMgr {
@@ -47,9 +49,12 @@ public:
     void HandleSubscriberDeath(const wptr<IRemoteObject>& remote);
 
 private:
+    void DispatchToSubscriber(const sptr<IBackgroundTaskSubscriber> &subscriber,
+        const std::shared_ptr<ResourceCallbackInfo> &callbackInfo, EfficiencyResourcesEventType type,
+        const std::shared_ptr<SubscriberEventParcel> &parcel);
 
     std::mutex subscriberLock_;
-    std::list<sptr<IBackgroundTaskSubscriber>> subscriberList_ {};
+    SubscriberRegistry<sptr<IBackgroundTaskSubscriber>> subscriberList_ {};
     sptr<ObserverDeathRecipient> deathRecipient_ {nullptr};
 };
 
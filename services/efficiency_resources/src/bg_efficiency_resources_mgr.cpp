@@ -29,6 +29,7 @@
 
 #include "resource_type.h"
 #include "time_provider.h"
+#include "bundle_info_cache.h"
 #include "bundle_manager_helper.h"
 #include "efficiency_resource_log.h"
 #include "tokenid_kit.h"
@@ -180,9 +181,19 @@ void BgEfficiencyResourcesMgr::HandlePersistenceData()
     std::vector<AppExecFwk::RunningProcessInfo> allAppProcessInfos;
     appMgrClient_->GetAllRunningProcesses(allAppProcessInfos);
     BGTASK_LOGI("start to recovery delayed task of apps and processes");
+    std::set<int32_t> runningUid;
+    std::set<int32_t> runningPid;
+    std::for_each(allAppProcessInfos.begin(), allAppProcessInfos.end(), [&runningUid, &runningPid](const auto &iter) {
+        runningUid.emplace(iter.uid_);
+        runningPid.emplace(iter.pid_);
+    });
+    // 恢复过程中直接丢弃已死亡进程和应用的记录
+    auto filter = [this, &runningUid, &runningPid](bool isProcess, int32_t mapKey,
+        const std::shared_ptr<ResourceApplicationRecord> &record) {
+        return IsPersistenceDataAlive(isProcess ? runningPid : runningUid, mapKey, record, isProcess);
+    };
     DelayedSingleton<DataStorageHelper>::GetInstance()->RestoreResourceRecord(
-        appResourceApplyMap_, procResourceApplyMap_);
-    CheckPersistenceData(allAppProcessInfos);
+        appResourceApplyMap_, procResourceApplyMap_, filter);
     RecoverResourceNumber();
     RecoverDelayedTask(true, procResourceApplyMap_);
     RecoverDelayedTask(false, appResourceApplyMap_);
@@ -202,26 +213,18 @@ void BgEfficiencyResourcesMgr::EraseRecordIf(ResourceRecordMap &infoMap,
     }
 }
 
-void BgEfficiencyResourcesMgr::CheckPersistenceData(const std::vector<AppExecFwk::RunningProcessInfo> &allProcesses)
+bool BgEfficiencyResourcesMgr::IsPersistenceDataAlive(const std::set<int32_t> &runningIds, int32_t mapKey,
+    const std::shared_ptr<ResourceApplicationRecord> &record, bool isProcess)
 {
-    BGTASK_LOGI("efficiency resources check existing uid and pid");
-    std::set<int32_t> runningUid;
-    std::set<int32_t> runningPid;
-    std::for_each(allProcesses.begin(), allProcesses.end(), [&runningUid, &runningPid](const auto &iter) {
-        runningUid.emplace(iter.uid_);
-        runningPid.emplace(iter.pid_);
-    });
-    auto removeUid = [&runningUid](const auto &iter) {
-        std::shared_ptr<ResourceApplicationRecord> record = iter.second;
-        if ((record->GetResourceNumber() & ResourceType::WORK_SCHEDULER) != 0 ||
-            (record->GetResourceNumber() & ResourceType::TIMER) != 0) {
-                return false;
-            }
-        return runningUid.find(iter.first) == runningUid.end();
-    };
-    EraseRecordIf(appResourceApplyMap_, removeUid);
-    auto removePid = [&runningPid](const auto &iter)  { return runningPid.find(iter.first) == runningPid.end(); };
-    EraseRecordIf(procResourceApplyMap_, removePid);
+    if (runningIds.find(mapKey) != runningIds.end()) {
+        return true;
+    }
+    if (isProcess) {
+        return false;
+    }
+    // 应用记录中的延时任务和定时器资源在应用退出后仍需保留, record为空时尚未解析出资源类型
+    return record == nullptr || (record->GetResourceNumber() & ResourceType::WORK_SCHEDULER) != 0 ||
+        (record->GetResourceNumber() & ResourceType::TIMER) != 0;
 }
 
 __attribute__((no_sanitize("cfi"))) void BgEfficiencyResourcesMgr::RecoverDelayedTask(bool isProcess,
@@ -733,7 +736,7 @@ bool BgEfficiencyResourcesMgr::IsCallingInfoLegal(int32_t uid, int32_t pid, std:
 ErrCode BgEfficiencyResourcesMgr::AddSubscriber(const sptr<IBackgroundTaskSubscriber> &subscriber)
 {
     BGTASK_LOGD("add subscriber to efficiency resources succeed");
-    handler_->PostSyncTask([this, &subscriber]() {
+    laneScheduler_->PostSyncTask(handler_, EventLane::IPC, [this, &subscriber]() {
         subscriberMgr_->AddSubscriber(subscriber);
     });
     return ERR_OK;
@@ -743,7 +746,7 @@ ErrCode BgEfficiencyResourcesMgr::RemoveSubscriber(const sptr<IBackgroundTaskSub
 {
     BGTASK_LOGD("remove subscriber to efficiency resources succeed");
     ErrCode result {};
-    handler_->PostSyncTask([this, &result, &subscriber]() {
+    laneScheduler_->PostSyncTask(handler_, EventLane::IPC, [this, &result, &subscriber]() {
         result = subscriberMgr_->RemoveSubscriber(subscriber);
     });
     return result;
@@ -1016,10 +1019,10 @@ void BgEfficiencyResourcesMgr::RemoveListRecord(std::list<PersistTime> &resource
 ErrCode BgEfficiencyResourcesMgr::GetEfficiencyResourcesInfos(std::vector<std::shared_ptr<
     ResourceCallbackInfo>> &appList, std::vector<std::shared_ptr<ResourceCallbackInfo>> &procList)
 {
-    handler_->PostSyncTask([this, &appList, &procList]() {
+    laneScheduler_->PostSyncTask(handler_, EventLane::IPC, [this, &appList, &procList]() {
         this->GetEfficiencyResourcesInfosInner(appResourceApplyMap_, appList);
         this->GetEfficiencyResourcesInfosInner(procResourceApplyMap_, procList);
-        }, AppExecFwk::EventQueue::Priority::HIGH);
+        });
 
     return ERR_OK;
 }
@@ -1118,7 +1121,7 @@ ErrCode BgEfficiencyResourcesMgr::GetAllEfficiencyResources(
         return ERR_BGTASK_NOT_SYSTEM_APP;
     }
 
-    handler_->PostSyncTask([this, &resourceInfoList, uid, pid]() {
+    laneScheduler_->PostSyncTask(handler_, EventLane::IPC, [this, &resourceInfoList, uid, pid]() {
             this->GetAllEfficiencyResourcesInner(appResourceApplyMap_, resourceInfoList, uid, pid, false);
             this->GetAllEfficiencyResourcesInner(procResourceApplyMap_, resourceInfoList, uid, pid, true);
         });
@@ -1217,15 +1220,15 @@ ErrCode BgEfficiencyResourcesMgr::CheckIfCanApplyCpuLevel(const sptr<EfficiencyR
         return ERR_BGTASK_EFFICIENCY_RESOURCES_CPU_LEVEL_NOT_ALLOW_APPLY;
     }
 
-    AppExecFwk::BundleInfo bundleInfo;
-    if (!BundleManagerHelper::GetInstance()->GetBundleInfo(bundleName,
-        AppExecFwk::BundleFlag::GET_BUNDLE_WITH_ABILITIES, bundleInfo, GetUserIdByUid(uid))) {
+    BundleMetadata metadata;
+    if (!DelayedSingleton<BundleInfoCache>::GetInstance()->GetBundleMetadata(bundleName, GetUserIdByUid(uid),
+        metadata)) {
         BGTASK_LOGE("%{public}s: get %{public}s bundle info failed", __func__, bundleName.c_str());
         return ERR_BGTASK_EFFICIENCY_RESOURCES_INVALID_BUNDLE_INFO;
     }
 
-    if (!DelayedSingleton<BgtaskConfig>::GetInstance()->CheckRequestCpuLevelAppSignatures(bundleName, bundleInfo.appId,
-        bundleInfo.signatureInfo.appIdentifier)) {
+    if (!DelayedSingleton<BgtaskConfig>::GetInstance()->CheckRequestCpuLevelAppSignatures(bundleName, metadata.appId,
+        metadata.appIdentifier)) {
         BGTASK_LOGE("%{public}s: %{public}s CheckRequestCpuLevelAppSignatures failed", __func__, bundleName.c_str());
         return ERR_BGTASK_EFFICIENCY_RESOURCES_CPU_LEVEL_APP_SIGNATURES_INVALID;
     }
@@ -17,9 +17,23 @@
 #include "efficiency_resource_log.h"
 #include "hisysevent.h"
 #include "background_task_observer.h"
+#include "subscriber_dispatcher.h"
 
 namespace OHOS {
 namespace BackgroundTaskMgr {
+namespace {
+const std::map<EfficiencyResourcesEventType, IBackgroundTaskSubscriberIpcCode> SUBSCRIBER_IPC_CODES = {
+    {EfficiencyResourcesEventType::APP_RESOURCE_APPLY,
+        IBackgroundTaskSubscriberIpcCode::COMMAND_ON_APP_EFFICIENCY_RESOURCES_APPLY},
+    {EfficiencyResourcesEventType::RESOURCE_APPLY,
+        IBackgroundTaskSubscriberIpcCode::COMMAND_ON_PROC_EFFICIENCY_RESOURCES_APPLY},
+    {EfficiencyResourcesEventType::APP_RESOURCE_RESET,
+        IBackgroundTaskSubscriberIpcCode::COMMAND_ON_APP_EFFICIENCY_RESOURCES_RESET},
+    {EfficiencyResourcesEventType::RESOURCE_RESET,
+        IBackgroundTaskSubscriberIpcCode::COMMAND_ON_PROC_EFFICIENCY_RESOURCES_RESET},
+};
+}
+
 ResourcesSubscriberMgr::ResourcesSubscriberMgr()
 {
     deathRecipient_ = new (std::nothrow) ObserverDeathRecipient();
@@ -45,9 +59,7 @@ ErrCode ResourcesSubscriberMgr::AddSubscriber(const sptr<IBackgroundTaskSubscrib
         return ERR_BGTASK_INVALID_PARAM;
     }
     std::lock_guard<std::mutex> subcriberLock(subscriberLock_);
-    auto subscriberIter = std::find_if(subscriberList_.begin(), subscriberList_.end(),
-        [&remote](const auto &subscriber) { return subscriber->AsObject() == remote; });
-    if (subscriberIter != subscriberList_.end()) {
+    if (subscriberList_.find(remote) != subscriberList_.end()) {
         BGTASK_LOGE("subscriber has already exist");
         return ERR_BGTASK_OBJECT_EXISTS;
     }
@@ -76,16 +88,13 @@ ErrCode ResourcesSubscriberMgr::RemoveSubscriber(const sptr<IBackgroundTaskSubsc
         return ERR_BGTASK_INVALID_PARAM;
     }
     std::lock_guard<std::mutex> subcriberLock(subscriberLock_);
-    auto findSuscriber = [&remote](const auto& subscriberList) {
-        return subscriberList->AsObject() == remote;
-    };
-    auto subscriberIter = std::find_if(subscriberList_.begin(), subscriberList_.end(), findSuscriber);
-    if (subscriberIter == subscriberList_.end()) {
+    if (subscriberList_.erase(remote) == 0) {
         BGTASK_LOGE("request subscriber is not exists");
         return ERR_BGTASK_OBJECT_EXISTS;
     }
-    subscriberList_.erase(subscriberIter);
     remote->RemoveDeathRecipient(deathRecipient_);
+    DelayedSingleton<SubscriberDispatcher>::GetInstance()->RemoveSubscriber(SubscriberSource::EFFICIENCY_RESOURCES,
+        remote);
     BGTASK_LOGD("remove subscriber from efficiency resources succeed");
     return ERR_OK;
 }
@@ -99,40 +108,67 @@ void ResourcesSubscriberMgr::OnResourceChanged(const std::shared_ptr<ResourceCal
         return;
     }
     std::lock_guard<std::mutex> subcriberLock(subscriberLock_);
-    const ResourceCallbackInfo& callbackInfoRef = *callbackInfo;
     switch (type) {
         case EfficiencyResourcesEventType::APP_RESOURCE_APPLY:
             BGTASK_LOGD("start callback function of app resources application");
             BackgroundTaskObserver::GetInstance().OnAppEfficiencyResourcesApply(callbackInfo);
-            for (auto iter = subscriberList_.begin(); iter != subscriberList_.end(); ++iter) {
-                (*iter)->OnAppEfficiencyResourcesApply(callbackInfoRef);
-            }
             break;
         case EfficiencyResourcesEventType::RESOURCE_APPLY:
             BGTASK_LOGD("start callback function of proc resources application");
             BackgroundTaskObserver::GetInstance().OnProcEfficiencyResourcesApply(callbackInfo);
-            for (auto iter = subscriberList_.begin(); iter != subscriberList_.end(); ++iter) {
-                (*iter)->OnProcEfficiencyResourcesApply(callbackInfoRef);
-            }
             break;
         case EfficiencyResourcesEventType::APP_RESOURCE_RESET:
             BGTASK_LOGD("start callback function of app resources reset");
             BackgroundTaskObserver::GetInstance().OnAppEfficiencyResourcesReset(callbackInfo);
-            for (auto iter = subscriberList_.begin(); iter != subscriberList_.end(); ++iter) {
-                (*iter)->OnAppEfficiencyResourcesReset(callbackInfoRef);
-            }
             break;
         case EfficiencyResourcesEventType::RESOURCE_RESET:
             BGTASK_LOGD("start callback function of proc resources reset");
             BackgroundTaskObserver::GetInstance().OnProcEfficiencyResourcesReset(callbackInfo);
-            for (auto iter = subscriberList_.begin(); iter != subscriberList_.end(); ++iter) {
-                (*iter)->OnProcEfficiencyResourcesReset(callbackInfoRef);
-            }
             break;
+        default:
+            return;
+    }
+    auto parcel = std::make_shared<SubscriberEventParcel>(callbackInfo);
+    for (auto iter = subscriberList_.begin(); iter != subscriberList_.end(); ++iter) {
+        DispatchToSubscriber(*iter, callbackInfo, type, parcel);
     }
     BGTASK_LOGD("efficiency resources on resources changed function succeed");
 }
 
+void ResourcesSubscriberMgr::DispatchToSubscriber(const sptr<IBackgroundTaskSubscriber> &subscriber,
+    const std::shared_ptr<ResourceCallbackInfo> &callbackInfo, EfficiencyResourcesEventType type,
+    const std::shared_ptr<SubscriberEventParcel> &parcel)
+{
+    SubscriberEvent event;
+    event.eventType = static_cast<uint32_t>(type);
+    event.delivery = [subscriber, callbackInfo, parcel](uint32_t eventType) {
+        auto type = static_cast<EfficiencyResourcesEventType>(eventType);
+        auto codeIter = SUBSCRIBER_IPC_CODES.find(type);
+        if (codeIter != SUBSCRIBER_IPC_CODES.end() && parcel->SendRequest(subscriber->AsObject(), codeIter->second)) {
+            return;
+        }
+        switch (type) {
+            case EfficiencyResourcesEventType::APP_RESOURCE_APPLY:
+                subscriber->OnAppEfficiencyResourcesApply(*callbackInfo);
+                break;
+            case EfficiencyResourcesEventType::RESOURCE_APPLY:
+                subscriber->OnProcEfficiencyResourcesApply(*callbackInfo);
+                break;
+            case EfficiencyResourcesEventType::APP_RESOURCE_RESET:
+                subscriber->OnAppEfficiencyResourcesReset(*callbackInfo);
+                break;
+            case EfficiencyResourcesEventType::RESOURCE_RESET:
+                subscriber->OnProcEfficiencyResourcesReset(*callbackInfo);
+                break;
+            default:
+                break;
+        }
+    };
+    event.resync = [subscriber]() { subscriber->OnConnected(); };
+    DelayedSingleton<SubscriberDispatcher>::GetInstance()->Dispatch(SubscriberSource::EFFICIENCY_RESOURCES,
+        subscriber->AsObject(), std::move(event));
+}
+
 void ResourcesSubscriberMgr::HandleSubscriberDeath(const wptr<IRemoteObject>& remote)
 {
     if (remote == nullptr) {
@@ -145,15 +181,12 @@ void ResourcesSubscriberMgr::HandleSubscriberDeath(const wptr<IRemoteObject>& re
         return;
     }
     std::lock_guard<std::mutex> subcriberLock(subscriberLock_);
-    auto findSuscriber = [&proxy](const auto& subscriber) {
-        return subscriber->AsObject() == proxy;
-    };
-    auto subscriberIter = std::find_if(subscriberList_.begin(), subscriberList_.end(), findSuscriber);
-    if (subscriberIter == subscriberList_.end()) {
+    if (subscriberList_.erase(proxy) == 0) {
         BGTASK_LOGI("suscriber death, remote in suscriber not found");
         return;
     }
-    subscriberList_.erase(subscriberIter);
+    DelayedSingleton<SubscriberDispatcher>::GetInstance()->RemoveSubscriber(SubscriberSource::EFFICIENCY_RESOURCES,
+        proxy);
     BGTASK_LOGD("suscriber death, remove it from list");
 }
 
@@ -23,6 +23,7 @@
 #include "bg_continuous_task_mgr.h"
 #include "bg_transient_task_mgr.h"
 #include "bg_efficiency_resources_mgr.h"
+#include "foreground_app_tracker.h"
 #include "singleton.h"
 
 namespace OHOS {
@@ -92,6 +93,7 @@ void AppStateObserverPluginAdapter::OnProcessDied(const nlohmann::json& payload)
     }
     BGTASK_LOGD("OnProcessDied, bundleName: %{public}s, uid: %{public}d, pid: %{public}d",
         processData.bundleName.c_str(), processData.uid, processData.pid);
+    DelayedSingleton<ForegroundAppTracker>::GetInstance()->OnProcessDied(processData);
     if (decisionMaker_ != nullptr) {
         decisionMaker_->OnProcessDied(processData);
     }
@@ -106,6 +108,7 @@ void AppStateObserverPluginAdapter::OnProcessStateChanged(const nlohmann::json&
     }
     BGTASK_LOGD("OnProcessStateChanged, bundleName: %{public}s, uid: %{public}d, pid: %{public}d",
         processData.bundleName.c_str(), processData.uid, processData.pid);
+    DelayedSingleton<ForegroundAppTracker>::GetInstance()->OnProcessStateChanged(processData);
     if (decisionMaker_ == nullptr) {
         BGTASK_LOGI("decisionMaker_ is nullptr");
         return;
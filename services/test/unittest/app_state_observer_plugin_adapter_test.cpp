@@ -16,7 +16,14 @@
 #include <gtest/gtest.h>
 #include "app_state_observer_plugin_adapter.h"
 #include "app_state_observer.h"
+#include "background_task_mgr_service.h"
 #include "decision_maker.h"
+#include "delay_suspend_info_ex.h"
+#include "device_info_manager.h"
+#include "foreground_app_tracker.h"
+#include "key_info.h"
+#include "pkg_delay_suspend_info.h"
+#include "timer_manager.h"
 #include "process_data.h"
 #include "app_state_data.h"
 #include "ability_state_data.h"
@@ -353,5 +360,49 @@ HWTEST_F(AppStateObserverPluginAdapterTest, AppStateObserverPluginAdapterTest_01
     AppExecFwk::AbilityStateData abilityStateData;
     EXPECT_FALSE(adapter->UnmarshallingAbilityStateData(payload, abilityStateData));
 }
+
+/**
+ * @tc.name: AppStateObserverPluginAdapterTest_015
+ * @tc.desc: test OnProcessStateChanged and OnProcessDied update foreground state and transient tasks.
+ * @tc.type: FUNC
+ */
+HWTEST_F(AppStateObserverPluginAdapterTest, AppStateObserverPluginAdapterTest_015, TestSize.Level2)
+{
+    auto adapter = AppStateObserverPluginAdapter::GetInstance();
+    adapter->Init();
+    auto deviceInfoManeger = std::make_shared<DeviceInfoManager>();
+    auto bgtaskService = sptr<BackgroundTaskMgrService>(new BackgroundTaskMgrService());
+    auto timerManager =
+        std::make_shared<TimerManager>(bgtaskService, AppExecFwk::EventRunner::Create("tdd_test_handler"));
+    auto decisionMaker = std::make_shared<DecisionMaker>(timerManager, deviceInfoManeger);
+    adapter->decisionMaker_ = decisionMaker;
+
+    int32_t uid = 100001;
+    int32_t pid = 100;
+    nlohmann::json payload = {
+        {"bundleName", "bundleName1"},
+        {"pid", std::to_string(pid)},
+        {"uid", std::to_string(uid)},
+        {"processType", "0"},
+        {"state", std::to_string(static_cast<int32_t>(AppExecFwk::AppProcessState::APP_STATE_FOREGROUND))},
+        {"extensionType", "0"},
+        {"preloadMode", "0"}
+    };
+    adapter->OnProcessStateChanged(payload);
+    EXPECT_TRUE(DelayedSingleton<ForegroundAppTracker>::GetInstance()->IsUidForeground(uid));
+    EXPECT_TRUE(decisionMaker->IsUidForeground(uid));
+
+    auto keyInfo = std::make_shared<KeyInfo>("bundleName1", uid);
+    auto pkgDelaySuspendInfo = std::make_shared<PkgDelaySuspendInfo>("bundleName1", uid, timerManager);
+    auto delayInfo = std::make_shared<DelaySuspendInfoEx>(pid);
+    pkgDelaySuspendInfo->requestList_.push_back(delayInfo);
+    decisionMaker->pkgDelaySuspendInfoMap_[keyInfo] = pkgDelaySuspendInfo;
+
+    adapter->OnProcessDied(payload);
+    EXPECT_FALSE(DelayedSingleton<ForegroundAppTracker>::GetInstance()->IsUidForeground(uid));
+    EXPECT_FALSE(decisionMaker->IsUidForeground(uid));
+    EXPECT_TRUE(pkgDelaySuspendInfo->isCounting_);
+    adapter->decisionMaker_ = nullptr;
+}
 }  // namespace BackgroundTaskMgr
 }  // namespace OHOS
\ No newline at end of file
@@ -13,7 +13,9 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <functional>
+#include <future>
 #include <chrono>
 #include <thread>
 
@@ -25,12 +27,17 @@
 #include "background_task_subscriber.h"
 #include "bg_continuous_task_dumper.h"
 #include "bg_continuous_task_mgr.h"
+#include "bundle_constants.h"
+#include "bundle_info_cache.h"
 #include "common_event_support.h"
 #include "want_agent.h"
 #include "user_auth_result.h"
 #include "common_utils.h"
 #include "expired_callback_proxy.h"
 #include "expired_callback_stub.h"
+#include "foreground_app_tracker.h"
+#include "init_step_graph.h"
+#include "notification_pipeline.h"
 #include "running_process_info.h"
 #include "background_task_observer.h"
 #ifdef GAME_PRE_LAUNCH_ENABLE
@@ -63,6 +70,7 @@ static constexpr int32_t DEFAULT_USERID = 100;
 static constexpr int32_t TEST_NUM_ONE = 1;
 static constexpr int32_t TEST_NUM_TWO = 2;
 static constexpr int32_t TEST_NUM_THREE = 3;
+static constexpr int32_t TEST_NUM_FOUR = 4;
 static constexpr uint32_t CALL_KIT_SA_UID = 7022;
 #ifdef FEATURE_PRODUCT_WATCH
 static constexpr uint32_t HEALTHSPORT_SA_UID = 7500;
@@ -2416,8 +2424,9 @@ HWTEST_F(BgContinuousTaskMgrTest, AllowApplyContinuousTask_001, TestSize.Level1)
     record->isFromWebview_ = true;
     record->uid_ = 1;
     EXPECT_EQ(bgContinuousTaskMgr_->CheckAbilityTaskNum(record), ERR_OK);
-    bgContinuousTaskMgr_->appOnForeground_.insert(1);
+    DelayedSingleton<ForegroundAppTracker>::GetInstance()->UpdateProcessState(1, 1, true);
     EXPECT_EQ(bgContinuousTaskMgr_->AllowApplyContinuousTask(record), ERR_OK);
+    DelayedSingleton<ForegroundAppTracker>::GetInstance()->UpdateProcessState(1, 1, false);
 }
 
 #ifdef GAME_PRE_LAUNCH_ENABLE
@@ -2458,12 +2467,26 @@ HWTEST_F(BgContinuousTaskMgrTest, OnAppStateChanged_001, TestSize.Level1)
     bgContinuousTaskMgr_->OnAppStateChanged(1,
         static_cast<int32_t>(AppExecFwk::ApplicationState::APP_STATE_FOREGROUND), preloadMode);
     bgContinuousTaskMgr_->isSysReady_.store(true);
+    bgContinuousTaskMgr_->continuousTaskInfosMap_.clear();
+    bgContinuousTaskMgr_->applyTaskOnForeground_[1] = {BackgroundMode::LOCATION};
+    bgContinuousTaskMgr_->OnAppStateChanged(1,
+        static_cast<int32_t>(AppExecFwk::ApplicationState::APP_STATE_BACKGROUND), preloadMode);
+    EXPECT_EQ(bgContinuousTaskMgr_->applyTaskOnForeground_.count(1), 0);
+
+    // 退后台时记录已申请的类型，切回前台不清除
+    auto record = std::make_shared<ContinuousTaskRecord>();
+    record->uid_ = 1;
+    record->bgModeIds_ = {BackgroundMode::DATA_TRANSFER, BackgroundMode::LOCATION};
+    bgContinuousTaskMgr_->continuousTaskInfosMap_["key1"] = record;
     bgContinuousTaskMgr_->OnAppStateChanged(1,
         static_cast<int32_t>(AppExecFwk::ApplicationState::APP_STATE_BACKGROUND), preloadMode);
-    EXPECT_EQ(bgContinuousTaskMgr_->appOnForeground_.size(), 0);
+    ASSERT_EQ(bgContinuousTaskMgr_->applyTaskOnForeground_.count(1), 1);
+    EXPECT_EQ(bgContinuousTaskMgr_->applyTaskOnForeground_.at(1), record->bgModeIds_);
     bgContinuousTaskMgr_->OnAppStateChanged(1,
         static_cast<int32_t>(AppExecFwk::ApplicationState::APP_STATE_FOREGROUND), preloadMode);
-    EXPECT_NE(bgContinuousTaskMgr_->appOnForeground_.size(), 0);
+    EXPECT_EQ(bgContinuousTaskMgr_->applyTaskOnForeground_.count(1), 1);
+    bgContinuousTaskMgr_->continuousTaskInfosMap_.clear();
+    bgContinuousTaskMgr_->applyTaskOnForeground_.clear();
 }
 
 #ifdef GAME_PRE_LAUNCH_ENABLE
@@ -3221,5 +3244,704 @@ HWTEST_F(BgContinuousTaskMgrTest, DebugContinuousTask_001, TestSize.Level3)
     BgContinuousTaskDumper::GetInstance()->DebugContinuousTask(dumpOption, dumpInfo);
     EXPECT_EQ(dumpInfo.size(), 1);
 }
+
+/**
+ * @tc.name: ContinuousTaskBatch_001
+ * @tc.desc: test ContinuousTaskBatch collect and commit.
+ * @tc.type: FUNC
+ * @tc.require: issueI5IRJK issueI4QT3W
+ */
+HWTEST_F(BgContinuousTaskMgrTest, ContinuousTaskBatch_001, TestSize.Level1)
+{
+    ContinuousTaskBatch batch;
+    EXPECT_TRUE(batch.IsEmpty());
+    auto record1 = std::make_shared<ContinuousTaskRecord>();
+    record1->uid_ = 1;
+    auto record2 = std::make_shared<ContinuousTaskRecord>();
+    record2->uid_ = 1;
+    batch.RemoveTask("key1", record1);
+    batch.RemoveTask("key2", record2);
+    batch.UpdateTask("key1");
+    batch.CancelNotification("label", 1);
+    batch.CancelNotification("label", 1);
+    batch.CancelNotification("label", -1);
+    EXPECT_FALSE(batch.IsEmpty());
+    EXPECT_EQ(batch.GetRemovedTasks().size(), 2);
+    EXPECT_EQ(batch.GetChangedKeys().size(), 2);
+    EXPECT_EQ(batch.GetNotifications().size(), 1);
+    EXPECT_EQ(batch.GetStoppedUids().size(), 1);
+
+    bgContinuousTaskMgr_->isSysReady_.store(true);
+    bgContinuousTaskMgr_->continuousTaskInfosMap_.clear();
+    for (int32_t i = 0; i < 3; i++) {
+        auto record = std::make_shared<ContinuousTaskRecord>();
+        record->uid_ = 1;
+        record->notificationLabel_ = "label";
+        record->notificationId_ = 1;
+        bgContinuousTaskMgr_->continuousTaskInfosMap_["key" + std::to_string(i)] = record;
+    }
+    auto other = std::make_shared<ContinuousTaskRecord>();
+    other->uid_ = 2;
+    bgContinuousTaskMgr_->continuousTaskInfosMap_["other"] = other;
+    bgContinuousTaskMgr_->OnAppStopped(1);
+    EXPECT_EQ(bgContinuousTaskMgr_->continuousTaskInfosMap_.size(), 1);
+    bgContinuousTaskMgr_->DumpCancelTask({}, true);
+    EXPECT_TRUE(bgContinuousTaskMgr_->continuousTaskInfosMap_.empty());
+}
+
+/**
+ * @tc.name: ContinuousTaskTable_001
+ * @tc.desc: test ContinuousTaskTable secondary indexes.
+ * @tc.type: FUNC
+ * @tc.require: issueI5IRJK issueI4QT3W
+ */
+HWTEST_F(BgContinuousTaskMgrTest, ContinuousTaskTable_001, TestSize.Level1)
+{
+    ContinuousTaskTable table;
+    auto record1 = std::make_shared<ContinuousTaskRecord>();
+    record1->uid_ = 1;
+    record1->abilityId_ = 1;
+    record1->continuousTaskId_ = 1;
+    record1->notificationLabel_ = "label";
+    table.emplace("key1", record1);
+    auto record2 = std::make_shared<ContinuousTaskRecord>();
+    table["key2"] = record2;
+    record2->uid_ = 1;
+    record2->abilityId_ = 2;
+    record2->continuousTaskId_ = 2;
+    record2->notificationLabel_ = "label";
+    EXPECT_EQ(table.GetKeysByUid(1).size(), 2);
+    EXPECT_EQ(table.GetKeysByAbility(1, 2).size(), 1);
+    EXPECT_EQ(table.GetKeysByNotificationLabel("label").size(), 2);
+    EXPECT_EQ(table.FindByContinuousTaskId(1)->first, "key1");
+
+    record1->notificationLabel_ = "other";
+    EXPECT_EQ(table.GetKeysByNotificationLabel("label").size(), 1);
+    table.Reindex("key1");
+    EXPECT_EQ(table.GetKeysByNotificationLabel("other").size(), 1);
+
+    table.erase("key1");
+    EXPECT_TRUE(table.FindByContinuousTaskId(1) == table.end());
+    EXPECT_EQ(table.GetKeysByUid(1).size(), 1);
+    table.clear();
+    EXPECT_TRUE(table.GetKeysByUid(1).empty());
+}
+
+/**
+ * @tc.name: ContinuousTaskSnapshot_001
+ * @tc.desc: test query continuous tasks from the published snapshot.
+ * @tc.type: FUNC
+ * @tc.require: issueI5IRJK issueI4QT3W
+ */
+HWTEST_F(BgContinuousTaskMgrTest, ContinuousTaskSnapshot_001, TestSize.Level1)
+{
+    bgContinuousTaskMgr_->continuousTaskInfosMap_.clear();
+    bgContinuousTaskMgr_->taskSnapshot_ = nullptr;
+    std::vector<std::shared_ptr<ContinuousTaskInfo>> list;
+    EXPECT_FALSE(bgContinuousTaskMgr_->GetAllContinuousTasksFromSnapshot(1, list));
+
+    auto record1 = std::make_shared<ContinuousTaskRecord>();
+    record1->uid_ = 1;
+    auto record2 = std::make_shared<ContinuousTaskRecord>();
+    record2->uid_ = 2;
+    record2->suspendState_ = true;
+    bgContinuousTaskMgr_->continuousTaskInfosMap_["key1"] = record1;
+    bgContinuousTaskMgr_->continuousTaskInfosMap_["key2"] = record2;
+    bgContinuousTaskMgr_->PublishTaskSnapshot();
+    uint64_t version = bgContinuousTaskMgr_->GetTaskSnapshot()->version_;
+    EXPECT_TRUE(bgContinuousTaskMgr_->GetAllContinuousTasksFromSnapshot(1, list));
+    EXPECT_EQ(list.size(), 1);
+    list.clear();
+    EXPECT_TRUE(bgContinuousTaskMgr_->GetAllContinuousTasksFromSnapshot(-1, list, false, true));
+    EXPECT_EQ(list.size(), 1);
+    std::vector<std::shared_ptr<ContinuousTaskCallbackInfo>> appList;
+    EXPECT_TRUE(bgContinuousTaskMgr_->GetContinuousTaskAppsFromSnapshot(appList, -1, true));
+    EXPECT_EQ(appList.size(), 2);
+
+    bgContinuousTaskMgr_->continuousTaskInfosMap_.erase("key1");
+    bgContinuousTaskMgr_->PublishTaskSnapshot({"key1"});
+    EXPECT_EQ(bgContinuousTaskMgr_->GetTaskSnapshot()->version_, version + 1);
+    list.clear();
+    EXPECT_TRUE(bgContinuousTaskMgr_->GetAllContinuousTasksFromSnapshot(1, list));
+    EXPECT_TRUE(list.empty());
+    bgContinuousTaskMgr_->continuousTaskInfosMap_.clear();
+    bgContinuousTaskMgr_->taskSnapshot_ = nullptr;
+}
+
+/**
+ * @tc.name: NotificationPipeline_001
+ * @tc.desc: test notification requests are delivered in order and coalesced by label.
+ * @tc.type: FUNC
+ * @tc.require: issueI5IRJK issueI4QT3W
+ */
+HWTEST_F(BgContinuousTaskMgrTest, NotificationPipeline_001, TestSize.Level1)
+{
+    auto pipeline = DelayedSingleton<NotificationPipeline>::GetInstance();
+    pipeline->Flush();
+    uint64_t coalescedCount = pipeline->GetCoalescedCount();
+    std::promise<void> started;
+    std::promise<void> release;
+    std::shared_future<void> releaseFuture = release.get_future().share();
+    std::vector<std::string> delivered;
+    pipeline->Publish("label1", 1, [&started, releaseFuture, &delivered]() {
+        started.set_value();
+        releaseFuture.wait();
+        delivered.emplace_back("publish1");
+        return ERR_OK;
+    });
+    started.get_future().wait();
+
+    pipeline->Publish("label2", 2, [&delivered]() {
+        delivered.emplace_back("publish2");
+        return ERR_OK;
+    });
+    pipeline->Cancel("label2", 2, [&delivered]() {
+        delivered.emplace_back("cancel2");
+        return ERR_OK;
+    });
+    pipeline->Publish("label3", 3, [&delivered]() {
+        delivered.emplace_back("publish3");
+        return ERR_OK;
+    });
+    pipeline->Publish("label3", 3, [&delivered]() {
+        delivered.emplace_back("update3");
+        return ERR_OK;
+    });
+    pipeline->Cancel("label1", 1, [&delivered]() {
+        delivered.emplace_back("cancel1");
+        return ERR_OK;
+    });
+    EXPECT_EQ(pipeline->GetPendingCount(), 3);
+    release.set_value();
+    pipeline->Flush();
+
+    std::vector<std::string> expected = {"publish1", "cancel2", "update3", "cancel1"};
+    EXPECT_EQ(delivered, expected);
+    EXPECT_EQ(pipeline->GetPendingCount(), 0);
+    EXPECT_EQ(pipeline->GetCoalescedCount(), coalescedCount + 2);
+}
+
+/**
+ * @tc.name: MergedNotificationTextCache_001
+ * @tc.desc: test merged notification text is formatted once per mode list and locale.
+ * @tc.type: FUNC
+ * @tc.require: issueI5IRJK issueI4QT3W
+ */
+HWTEST_F(BgContinuousTaskMgrTest, MergedNotificationTextCache_001, TestSize.Level1)
+{
+    auto modeTexts = bgContinuousTaskMgr_->modeForNotificationText_;
+    bgContinuousTaskMgr_->modeForNotificationText_[BackgroundMode::DATA_TRANSFER] = {"dataTransfer", "data"};
+    bgContinuousTaskMgr_->modeForNotificationText_[BackgroundMode::AUDIO_PLAYBACK] = {"audioPlayback", "audio"};
+    bgContinuousTaskMgr_->ClearMergedNotificationTextCache();
+    std::vector<uint32_t> checkModes = {BackgroundMode::DATA_TRANSFER, BackgroundMode::AUDIO_PLAYBACK};
+    std::string notificationText {""};
+    EXPECT_EQ(bgContinuousTaskMgr_->MergeNotificationText(notificationText, checkModes, ""), ERR_OK);
+    EXPECT_EQ(notificationText, "bgmode_merge_test");
+    EXPECT_EQ(bgContinuousTaskMgr_->mergedNotificationTexts_.size(), 1);
+
+    bgContinuousTaskMgr_->mergedNotificationTexts_[checkModes] = "cached";
+    notificationText = "";
+    EXPECT_EQ(bgContinuousTaskMgr_->MergeNotificationText(notificationText, checkModes, "carKey\n"), ERR_OK);
+    EXPECT_EQ(notificationText, "carKey\ncached");
+
+    bgContinuousTaskMgr_->mergedNotificationTextLocale_ = "invalid-locale";
+    notificationText = "";
+    EXPECT_EQ(bgContinuousTaskMgr_->MergeNotificationText(notificationText, checkModes, ""), ERR_OK);
+    EXPECT_EQ(notificationText, "bgmode_merge_test");
+    EXPECT_NE(bgContinuousTaskMgr_->mergedNotificationTextLocale_, "invalid-locale");
+
+    bgContinuousTaskMgr_->ClearMergedNotificationTextCache();
+    EXPECT_TRUE(bgContinuousTaskMgr_->mergedNotificationTexts_.empty());
+    bgContinuousTaskMgr_->modeForNotificationText_ = modeTexts;
+}
+
+/**
+ * @tc.name: BundleInfoCache_001
+ * @tc.desc: test bundle metadata cache is bounded and invalidated by bundle events.
+ * @tc.type: FUNC
+ * @tc.require: issueI5IRJK issueI4QT3W
+ */
+HWTEST_F(BgContinuousTaskMgrTest, BundleInfoCache_001, TestSize.Level1)
+{
+    LruCache<int32_t, int32_t> lruCache(2);
+    lruCache.emplace(1, 1);
+    lruCache.emplace(2, 2);
+    EXPECT_NE(lruCache.find(1), lruCache.end());
+    lruCache.emplace(3, 3);
+    EXPECT_EQ(lruCache.size(), 2);
+    EXPECT_EQ(lruCache.count(1), 1);
+    EXPECT_EQ(lruCache.count(2), 0);
+
+    auto bundleInfoCache = DelayedSingleton<BundleInfoCache>::GetInstance();
+    bundleInfoCache->Clear();
+    BundleMetadata metadata;
+    EXPECT_FALSE(bundleInfoCache->GetBundleMetadata("false-test", 100, metadata));
+    EXPECT_EQ(bundleInfoCache->GetMetadataCount(), 0);
+    EXPECT_TRUE(bundleInfoCache->GetBundleMetadata("valid", 100, metadata));
+    EXPECT_EQ(metadata.abilityBgModes.size(), 1);
+    EXPECT_EQ(metadata.reqPermissions.size(), 1);
+    EXPECT_EQ(bundleInfoCache->GetAppLabel("valid"), "label");
+    EXPECT_EQ(bundleInfoCache->GetAppLabelCount(), 1);
+    size_t capacity = bundleInfoCache->metadataCache_.capacity();
+    for (size_t i = 0; i <= capacity; i++) {
+        bundleInfoCache->GetBundleMetadata("bundle" + std::to_string(i), 100, metadata);
+    }
+    EXPECT_EQ(bundleInfoCache->GetMetadataCount(), capacity);
+
+    EventFwk::MatchingSkills matchingSkills;
+    EventFwk::CommonEventSubscribeInfo subscribeInfo(matchingSkills);
+    auto observer = std::make_shared<SystemEventObserver>(subscribeInfo);
+    AAFwk::Want want;
+    want.SetAction(EventFwk::CommonEventSupport::COMMON_EVENT_PACKAGE_CHANGED);
+    want.SetElementName("", "bundle1", "", "");
+    want.SetParam(AppExecFwk::Constants::USER_ID, -1);
+    EventFwk::CommonEventData eventData;
+    eventData.SetWant(want);
+    observer->OnReceiveEventBundleInfoCache(eventData);
+    EXPECT_EQ(bundleInfoCache->GetMetadataCount(), capacity - 1);
+    want.SetAction(EventFwk::CommonEventSupport::COMMON_EVENT_BUNDLE_RESOURCES_CHANGED);
+    eventData.SetWant(want);
+    observer->OnReceiveEventBundleInfoCache(eventData);
+    EXPECT_EQ(bundleInfoCache->GetAppLabelCount(), 0);
+    bundleInfoCache->Clear();
+}
+
+/**
+ * @tc.name: BundleInfoCache_002
+ * @tc.desc: test uid bundle names are cached and invalidated by bundle events.
+ * @tc.type: FUNC
+ * @tc.require: issueI5IRJK issueI4QT3W
+ */
+HWTEST_F(BgContinuousTaskMgrTest, BundleInfoCache_002, TestSize.Level1)
+{
+    auto bundleInfoCache = DelayedSingleton<BundleInfoCache>::GetInstance();
+    bundleInfoCache->Clear();
+    std::string bundleName;
+    EXPECT_FALSE(bundleInfoCache->GetBundleNameForUid(-1, bundleName));
+    EXPECT_EQ(bundleInfoCache->GetBundleNameCount(), 0);
+
+    bundleInfoCache->bundleNameCache_.emplace(TEST_NUM_ONE, "bundle1");
+    bundleInfoCache->bundleNameCache_.emplace(TEST_NUM_TWO, "bundle2");
+    bundleInfoCache->bundleNameCache_.emplace(TEST_NUM_THREE, "bundle1");
+    EXPECT_TRUE(bundleInfoCache->GetBundleNameForUid(TEST_NUM_ONE, bundleName));
+    EXPECT_EQ(bundleName, "bundle1");
+    bundleInfoCache->InvalidateBundle("bundle1", DEFAULT_USERID);
+    EXPECT_EQ(bundleInfoCache->GetBundleNameCount(), TEST_NUM_ONE);
+    EXPECT_TRUE(bundleInfoCache->GetBundleNameForUid(TEST_NUM_TWO, bundleName));
+    EXPECT_EQ(bundleName, "bundle2");
+    bundleInfoCache->Clear();
+    EXPECT_EQ(bundleInfoCache->GetBundleNameCount(), 0);
+}
+
+/**
+ * @tc.name: SubscriberDispatcher_001
+ * @tc.desc: test subscriber events are delivered in order and an update is merged into a pending start.
+ * @tc.type: FUNC
+ * @tc.require: issueI5IRJK issueI4QT3W
+ */
+HWTEST_F(BgContinuousTaskMgrTest, SubscriberDispatcher_001, TestSize.Level1)
+{
+    auto dispatcher = DelayedSingleton<SubscriberDispatcher>::GetInstance();
+    dispatcher->Flush();
+    SubscriberDispatcherStats before = dispatcher->GetStats();
+    EXPECT_FALSE(dispatcher->Dispatch(SubscriberSource::CONTINUOUS_TASK, nullptr, SubscriberEvent()));
+
+    std::mutex orderMutex;
+    std::vector<std::string> order;
+    auto record = [&orderMutex, &order](const std::string &name) {
+        std::lock_guard<std::mutex> lock(orderMutex);
+        order.emplace_back(name);
+    };
+    SubscriberEvent inlineEvent;
+    inlineEvent.delivery = [&record](uint32_t) { record("inline"); };
+    EXPECT_TRUE(dispatcher->Dispatch(SubscriberSource::CONTINUOUS_TASK, nullptr, inlineEvent));
+    EXPECT_EQ(order.size(), 1);
+
+    TestBackgroundTaskSubscriber subscriber = TestBackgroundTaskSubscriber();
+    sptr<IRemoteObject> remote = subscriber.GetImpl()->AsObject();
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    SubscriberEvent blockEvent;
+    blockEvent.delivery = [&record, released](uint32_t) {
+        released.wait();
+        record("block");
+    };
+    EXPECT_TRUE(dispatcher->Dispatch(SubscriberSource::CONTINUOUS_TASK, remote, blockEvent));
+    SubscriberEvent startEvent;
+    startEvent.eventType = TEST_NUM_ONE;
+    startEvent.coalesceKey = "task";
+    startEvent.delivery = [&record](uint32_t) { record("start"); };
+    EXPECT_TRUE(dispatcher->Dispatch(SubscriberSource::CONTINUOUS_TASK, remote, startEvent));
+    SubscriberEvent updateEvent;
+    updateEvent.eventType = TEST_NUM_TWO;
+    updateEvent.coalesceKey = "task";
+    updateEvent.foldInto = {TEST_NUM_ONE, TEST_NUM_TWO};
+    updateEvent.delivery = [&record](uint32_t eventType) { record("update" + std::to_string(eventType)); };
+    EXPECT_TRUE(dispatcher->Dispatch(SubscriberSource::CONTINUOUS_TASK, remote, updateEvent));
+    SubscriberEvent stopEvent;
+    stopEvent.eventType = TEST_NUM_THREE;
+    stopEvent.coalesceKey = "task";
+    stopEvent.foldInto = {TEST_NUM_ONE};
+    stopEvent.delivery = [&record](uint32_t) { record("stop"); };
+    EXPECT_TRUE(dispatcher->Dispatch(SubscriberSource::CONTINUOUS_TASK, remote, stopEvent));
+    release.set_value();
+    dispatcher->Flush();
+
+    std::vector<std::string> expected = {"inline", "block", "update1", "stop"};
+    EXPECT_EQ(order, expected);
+    SubscriberDispatcherStats after = dispatcher->GetStats();
+    EXPECT_EQ(after.dispatched - before.dispatched, 5);
+    EXPECT_EQ(after.delivered - before.delivered, 4);
+    EXPECT_EQ(after.coalesced - before.coalesced, 1);
+    dispatcher->RemoveSubscriber(SubscriberSource::CONTINUOUS_TASK, remote);
+    EXPECT_EQ(dispatcher->queues_.count({SubscriberSource::CONTINUOUS_TASK, remote.GetRefPtr()}), 0);
+    std::vector<std::string> dumpInfo;
+    dispatcher->DumpDispatcherInfo(dumpInfo);
+    EXPECT_EQ(dumpInfo.size(), 1);
+}
+
+/**
+ * @tc.name: SubscriberDispatcher_002
+ * @tc.desc: test subscriber queues of different sources, start and cancel folding, overflow and resync.
+ * @tc.type: FUNC
+ * @tc.require: issueI5IRJK issueI4QT3W
+ */
+HWTEST_F(BgContinuousTaskMgrTest, SubscriberDispatcher_002, TestSize.Level1)
+{
+    auto dispatcher = DelayedSingleton<SubscriberDispatcher>::GetInstance();
+    dispatcher->Flush();
+    SubscriberDispatcherStats before = dispatcher->GetStats();
+    TestBackgroundTaskSubscriber subscriber = TestBackgroundTaskSubscriber();
+    sptr<IRemoteObject> remote = subscriber.GetImpl()->AsObject();
+    std::mutex orderMutex;
+    std::vector<std::string> order;
+    auto record = [&orderMutex, &order](const std::string &name) {
+        std::lock_guard<std::mutex> lock(orderMutex);
+        order.emplace_back(name);
+    };
+
+    // 暂停订阅者，只积压事件
+    SubscriberEvent transientEvent;
+    transientEvent.delivery = [&record](uint32_t) { record("transient"); };
+    EXPECT_TRUE(dispatcher->Dispatch(SubscriberSource::TRANSIENT_TASK, remote, transientEvent));
+    dispatcher->Flush();
+    auto continuousKey = std::make_pair(SubscriberSource::CONTINUOUS_TASK, remote.GetRefPtr());
+    auto queue = std::make_shared<SubscriberDispatcher::SubscriberQueue>();
+    queue->source = SubscriberSource::CONTINUOUS_TASK;
+    queue->remote = remote;
+    queue->blocked = true;
+    dispatcher->queues_[continuousKey] = queue;
+
+    SubscriberEvent startEvent;
+    startEvent.eventType = TEST_NUM_ONE;
+    startEvent.coalesceKey = "task";
+    startEvent.delivery = [&record](uint32_t) { record("start"); };
+    EXPECT_TRUE(dispatcher->Dispatch(SubscriberSource::CONTINUOUS_TASK, remote, startEvent));
+    SubscriberEvent cancelEvent;
+    cancelEvent.eventType = TEST_NUM_THREE;
+    cancelEvent.coalesceKey = "task";
+    cancelEvent.cancelOut = {TEST_NUM_ONE};
+    cancelEvent.delivery = [&record](uint32_t) { record("cancel"); };
+    EXPECT_TRUE(dispatcher->Dispatch(SubscriberSource::CONTINUOUS_TASK, remote, cancelEvent));
+    EXPECT_TRUE(queue->events.empty());
+
+    // 队列满时先丢弃可覆盖的事件，再丢弃状态事件并在积压投递完成后通知重新查询
+    SubscriberEvent updateEvent;
+    updateEvent.eventType = TEST_NUM_TWO;
+    updateEvent.droppable = true;
+    updateEvent.delivery = [&record](uint32_t) { record("update"); };
+    EXPECT_TRUE(dispatcher->Dispatch(SubscriberSource::CONTINUOUS_TASK, remote, updateEvent));
+    SubscriberEvent stateEvent;
+    stateEvent.eventType = TEST_NUM_ONE;
+    stateEvent.delivery = [&record](uint32_t) { record("state"); };
+    stateEvent.resync = [&record]() { record("resync"); };
+    while (queue->events.size() < 128) {
+        EXPECT_TRUE(dispatcher->Dispatch(SubscriberSource::CONTINUOUS_TASK, remote, stateEvent));
+    }
+    EXPECT_TRUE(dispatcher->Dispatch(SubscriberSource::CONTINUOUS_TASK, remote, stateEvent));
+    EXPECT_FALSE(queue->needResync);
+    EXPECT_EQ(queue->events.size(), 128);
+    EXPECT_TRUE(dispatcher->Dispatch(SubscriberSource::CONTINUOUS_TASK, remote, stateEvent));
+    EXPECT_TRUE(queue->needResync);
+
+    // 其他来源取消订阅不影响该订阅者的持续任务事件
+    dispatcher->RemoveSubscriber(SubscriberSource::TRANSIENT_TASK, remote);
+    EXPECT_EQ(queue->events.size(), 128);
+    dispatcher->Unblock(queue);
+    dispatcher->Flush();
+    EXPECT_FALSE(queue->blocked);
+    ASSERT_EQ(order.size(), 130);
+    EXPECT_EQ(order.front(), "transient");
+    EXPECT_EQ(std::count(order.begin(), order.end(), "update"), 0);
+    EXPECT_EQ(std::count(order.begin(), order.end(), "state"), 128);
+    EXPECT_EQ(order.back(), "resync");
+    SubscriberDispatcherStats after = dispatcher->GetStats();
+    EXPECT_EQ(after.droppedStateEvents - before.droppedStateEvents, 1);
+    EXPECT_EQ(after.resyncs - before.resyncs, 1);
+    EXPECT_EQ(dispatcher->queues_.count(continuousKey), 0);
+}
+
+/**
+ * @tc.name: SubscriberEventParcel_001
+ * @tc.desc: test callback payload is marshalled once and only for remote subscribers.
+ * @tc.type: FUNC
+ * @tc.require: issueI5IRJK issueI4QT3W
+ */
+HWTEST_F(BgContinuousTaskMgrTest, SubscriberEventParcel_001, TestSize.Level1)
+{
+    SubscriberEventParcel emptyParcel(nullptr);
+    EXPECT_FALSE(emptyParcel.Marshal());
+
+    auto callbackInfo = std::make_shared<ContinuousTaskCallbackInfo>();
+    callbackInfo->SetContinuousTaskId(TEST_NUM_TWO);
+    callbackInfo->SetBundleName("bundleName");
+    SubscriberEventParcel parcel(callbackInfo);
+    TestBackgroundTaskSubscriber subscriber = TestBackgroundTaskSubscriber();
+    EXPECT_FALSE(parcel.SendRequest(nullptr, IBackgroundTaskSubscriberIpcCode::COMMAND_ON_CONTINUOUS_TASK_START));
+    EXPECT_FALSE(parcel.SendRequest(subscriber.GetImpl()->AsObject(),
+        IBackgroundTaskSubscriberIpcCode::COMMAND_ON_CONTINUOUS_TASK_START));
+    EXPECT_FALSE(parcel.IsMarshalled());
+
+    EXPECT_TRUE(parcel.Marshal());
+    EXPECT_TRUE(parcel.Marshal());
+    Parcel data;
+    data.WriteBuffer(parcel.payload_.data(), parcel.payload_.size());
+    std::unique_ptr<ContinuousTaskCallbackInfo> info(data.ReadParcelable<ContinuousTaskCallbackInfo>());
+    ASSERT_NE(info, nullptr);
+    EXPECT_EQ(info->GetContinuousTaskId(), TEST_NUM_TWO);
+    EXPECT_EQ(info->GetBundleName(), "bundleName");
+}
+
+/**
+ * @tc.name: SubscriberRegistry_001
+ * @tc.desc: test subscribers are indexed by remote object and listed in the buckets of their flags.
+ * @tc.type: FUNC
+ * @tc.require: issueI5IRJK issueI4QT3W
+ */
+HWTEST_F(BgContinuousTaskMgrTest, SubscriberRegistry_001, TestSize.Level1)
+{
+    auto &registry = bgContinuousTaskMgr_->bgTaskSubscribers_;
+    registry.clear();
+    TestBackgroundTaskSubscriber saSubscriber = TestBackgroundTaskSubscriber();
+    TestBackgroundTaskSubscriber hapSubscriber = TestBackgroundTaskSubscriber();
+    auto saInfo = std::make_shared<SubscriberInfo>(saSubscriber.GetImpl(), TEST_NUM_ONE, TEST_NUM_ONE, false, 0);
+    auto hapInfo = std::make_shared<SubscriberInfo>(hapSubscriber.GetImpl(), TEST_NUM_TWO, TEST_NUM_TWO, true, 0);
+    EXPECT_TRUE(registry.emplace_back(saInfo));
+    EXPECT_TRUE(registry.emplace_back(hapInfo));
+    EXPECT_FALSE(registry.emplace_back(hapInfo));
+    auto nullInfo = std::make_shared<SubscriberInfo>(nullptr, TEST_NUM_ONE, TEST_NUM_ONE, false, 0);
+    EXPECT_FALSE(registry.emplace_back(nullInfo));
+    EXPECT_EQ(registry.size(), TEST_NUM_TWO);
+    EXPECT_EQ(registry.GetBucket(SUBSCRIBER_BUCKET_SA).size(), TEST_NUM_ONE);
+    EXPECT_EQ(registry.GetBucket(SUBSCRIBER_BUCKET_HAP).size(), TEST_NUM_ONE);
+    EXPECT_TRUE(registry.GetBucket(SUBSCRIBER_BUCKET_HAP_STATE).empty());
+    EXPECT_TRUE(registry.GetBucket(SUBSCRIBER_BUCKET_BUTT).empty());
+
+    hapInfo->flag_ |= SUBSCRIBER_BACKGROUND_TASK_STATE;
+    registry.Reclassify();
+    EXPECT_EQ(registry.GetBucket(SUBSCRIBER_BUCKET_HAP_STATE).size(), TEST_NUM_ONE);
+    EXPECT_TRUE(bgContinuousTaskMgr_->IsExistCallback(TEST_NUM_TWO, SUBSCRIBER_BACKGROUND_TASK_STATE));
+
+    auto remote = hapSubscriber.GetImpl()->AsObject();
+    ASSERT_NE(registry.find(remote), registry.end());
+    EXPECT_EQ(registry.erase(remote), TEST_NUM_ONE);
+    EXPECT_EQ(registry.erase(remote), 0);
+    EXPECT_EQ(registry.find(remote), registry.end());
+    EXPECT_TRUE(registry.GetBucket(SUBSCRIBER_BUCKET_HAP).empty());
+    EXPECT_EQ(registry.GetBucket(SUBSCRIBER_BUCKET_SA).size(), TEST_NUM_ONE);
+    registry.clear();
+}
+
+/**
+ * @tc.name: ContinuousTaskControlBatch_001
+ * @tc.desc: test batched suspend, active and stop are applied in one batch.
+ * @tc.type: FUNC
+ * @tc.require: issueI5IRJK issueI4QT3W
+ */
+HWTEST_F(BgContinuousTaskMgrTest, ContinuousTaskControlBatch_001, TestSize.Level1)
+{
+    bgContinuousTaskMgr_->continuousTaskInfosMap_.clear();
+    bgContinuousTaskMgr_->bgTaskSubscribers_.clear();
+    bgContinuousTaskMgr_->isSysReady_.store(true);
+    for (int32_t index = TEST_NUM_ONE; index <= TEST_NUM_THREE; index++) {
+        std::shared_ptr<ContinuousTaskRecord> record = std::make_shared<ContinuousTaskRecord>();
+        record->uid_ = index == TEST_NUM_THREE ? TEST_NUM_TWO : TEST_NUM_ONE;
+        record->continuousTaskId_ = index;
+        record->bgModeIds_.push_back(TEST_NUM_TWO);
+        bgContinuousTaskMgr_->continuousTaskInfosMap_["key" + std::to_string(index)] = record;
+    }
+
+    ContinuousTaskBatch batch;
+    bgContinuousTaskMgr_->HandleStopContinuousTask(TEST_NUM_ONE, TEST_NUM_ONE, 0, "key1", batch);
+    bgContinuousTaskMgr_->HandleStopContinuousTask(TEST_NUM_TWO, TEST_NUM_TWO, 0, "key3", batch);
+    bgContinuousTaskMgr_->HandleStopContinuousTask(TEST_NUM_TWO, TEST_NUM_TWO, 0, "key4", batch);
+    EXPECT_EQ(bgContinuousTaskMgr_->continuousTaskInfosMap_.size(), TEST_NUM_ONE);
+    EXPECT_EQ(batch.GetRemovedTasks().size(), TEST_NUM_TWO);
+    EXPECT_EQ(batch.GetChangedKeys().size(), TEST_NUM_TWO);
+    EXPECT_EQ(batch.GetStoppedUids().size(), TEST_NUM_TWO);
+    bgContinuousTaskMgr_->CommitTaskBatch(batch);
+
+    // 没有订阅暂停回调时，暂停等同于停止
+    std::vector<ContinuousTaskControlInfo> taskList;
+    taskList.emplace_back(TEST_NUM_ONE, TEST_NUM_ONE, "key2", 4);
+    taskList.emplace_back(TEST_NUM_ONE, TEST_NUM_ONE, "key5", 4);
+    bgContinuousTaskMgr_->ActiveContinuousTasks(taskList);
+    bgContinuousTaskMgr_->SuspendContinuousTasks(taskList);
+    SleepForFC();
+    EXPECT_TRUE(bgContinuousTaskMgr_->continuousTaskInfosMap_.empty());
+    bgContinuousTaskMgr_->StopContinuousTasks(taskList, 0);
+    SleepForFC();
+    EXPECT_TRUE(bgContinuousTaskMgr_->continuousTaskInfosMap_.empty());
+}
+
+/**
+ * @tc.name: ContinuousTaskChangeLog_001
+ * @tc.desc: test changes of several generations are merged into net changes.
+ * @tc.type: FUNC
+ * @tc.require: issueI5IRJK issueI4QT3W
+ */
+HWTEST_F(BgContinuousTaskMgrTest, ContinuousTaskChangeLog_001, TestSize.Level1)
+{
+    ContinuousTaskChangeLog changeLog(TEST_NUM_THREE);
+    changeLog.Reset(TEST_NUM_ONE);
+    auto removedInfo = std::make_shared<ContinuousTaskCallbackInfo>();
+    changeLog.Append(TEST_NUM_TWO, "key1", ContinuousTaskChangeType::ADDED);
+    changeLog.Append(TEST_NUM_TWO, "key2", ContinuousTaskChangeType::UPDATED);
+    changeLog.Append(TEST_NUM_THREE, "key1", ContinuousTaskChangeType::REMOVED, removedInfo);
+    std::map<std::string, ContinuousTaskChange> changes;
+    EXPECT_TRUE(changeLog.Collect(TEST_NUM_ONE, TEST_NUM_THREE, changes));
+    // 区间内新增又删除的任务不返回
+    EXPECT_EQ(changes.size(), TEST_NUM_ONE);
+    EXPECT_EQ(changes["key2"].type, ContinuousTaskChangeType::UPDATED);
+    changes.clear();
+    EXPECT_TRUE(changeLog.Collect(TEST_NUM_TWO, TEST_NUM_THREE, changes));
+    EXPECT_EQ(changes["key1"].type, ContinuousTaskChangeType::REMOVED);
+    EXPECT_EQ(changes["key1"].removedInfo, removedInfo);
+    changes.clear();
+    EXPECT_TRUE(changeLog.Collect(TEST_NUM_ONE, TEST_NUM_TWO, changes));
+    EXPECT_EQ(changes["key1"].type, ContinuousTaskChangeType::ADDED);
+
+    changeLog.Append(TEST_NUM_FOUR, "key3", ContinuousTaskChangeType::ADDED);
+    EXPECT_EQ(changeLog.size(), TEST_NUM_THREE);
+    changes.clear();
+    EXPECT_FALSE(changeLog.Collect(TEST_NUM_ONE, TEST_NUM_FOUR, changes));
+    EXPECT_TRUE(changeLog.Collect(TEST_NUM_TWO, TEST_NUM_FOUR, changes));
+    changeLog.Reset(TEST_NUM_FOUR);
+    EXPECT_EQ(changeLog.size(), 0);
+    EXPECT_FALSE(changeLog.Collect(TEST_NUM_THREE, TEST_NUM_FOUR, changes));
+}
+
+/**
+ * @tc.name: ContinuousTaskAppsDelta_001
+ * @tc.desc: test query continuous task apps changed since a generation.
+ * @tc.type: FUNC
+ * @tc.require: issueI5IRJK issueI4QT3W
+ */
+HWTEST_F(BgContinuousTaskMgrTest, ContinuousTaskAppsDelta_001, TestSize.Level1)
+{
+    bgContinuousTaskMgr_->continuousTaskInfosMap_.clear();
+    bgContinuousTaskMgr_->taskSnapshot_ = nullptr;
+    bgContinuousTaskMgr_->isSysReady_.store(true);
+    auto record1 = std::make_shared<ContinuousTaskRecord>();
+    record1->uid_ = TEST_NUM_ONE;
+    auto record2 = std::make_shared<ContinuousTaskRecord>();
+    record2->uid_ = TEST_NUM_TWO;
+    bgContinuousTaskMgr_->continuousTaskInfosMap_["key1"] = record1;
+    bgContinuousTaskMgr_->continuousTaskInfosMap_["key2"] = record2;
+    bgContinuousTaskMgr_->PublishTaskSnapshot();
+
+    ContinuousTaskAppsDelta delta;
+    EXPECT_EQ(bgContinuousTaskMgr_->GetContinuousTaskAppsDelta(0, delta), ERR_OK);
+    EXPECT_TRUE(delta.isFullResync);
+    EXPECT_EQ(delta.addedList.size(), TEST_NUM_TWO);
+    uint64_t generation = delta.generation;
+
+    ContinuousTaskAppsDelta unchanged;
+    EXPECT_EQ(bgContinuousTaskMgr_->GetContinuousTaskAppsDelta(generation, unchanged), ERR_OK);
+    EXPECT_FALSE(unchanged.isFullResync);
+    EXPECT_TRUE(unchanged.addedList.empty());
+
+    record2->suspendState_ = true;
+    bgContinuousTaskMgr_->continuousTaskInfosMap_.erase("key1");
+    bgContinuousTaskMgr_->continuousTaskInfosMap_["key3"] = std::make_shared<ContinuousTaskRecord>();
+    bgContinuousTaskMgr_->PublishTaskSnapshot({"key1", "key2"});
+    bgContinuousTaskMgr_->PublishTaskSnapshot();
+    ContinuousTaskAppsDelta changed;
+    EXPECT_EQ(bgContinuousTaskMgr_->GetContinuousTaskAppsDelta(generation, changed), ERR_OK);
+    EXPECT_FALSE(changed.isFullResync);
+    EXPECT_EQ(changed.generation, generation + TEST_NUM_TWO);
+    EXPECT_EQ(changed.addedList.size(), TEST_NUM_ONE);
+    ASSERT_EQ(changed.updatedList.size(), TEST_NUM_ONE);
+    EXPECT_TRUE(changed.updatedList[0]->GetSuspendState());
+    ASSERT_EQ(changed.removedList.size(), TEST_NUM_ONE);
+    EXPECT_EQ(changed.removedList[0]->GetCreatorUid(), TEST_NUM_ONE);
+
+    // 调用方代数早于日志起点或来自未来时全量同步
+    ContinuousTaskAppsDelta resync;
+    EXPECT_EQ(bgContinuousTaskMgr_->GetContinuousTaskAppsDelta(generation - 1, resync), ERR_OK);
+    EXPECT_TRUE(resync.isFullResync);
+    EXPECT_EQ(resync.addedList.size(), TEST_NUM_TWO);
+
+    // 重新建立快照后纪元变化，旧纪元的代数需全量同步
+    bgContinuousTaskMgr_->taskSnapshot_ = nullptr;
+    bgContinuousTaskMgr_->PublishTaskSnapshot();
+    for (int32_t i = 0; i < TEST_NUM_THREE; i++) {
+        bgContinuousTaskMgr_->PublishTaskSnapshot();
+    }
+    ContinuousTaskAppsDelta restarted;
+    EXPECT_EQ(bgContinuousTaskMgr_->GetContinuousTaskAppsDelta(generation, restarted), ERR_OK);
+    EXPECT_TRUE(restarted.isFullResync);
+    EXPECT_NE(restarted.generation >> 32, generation >> 32);
+    bgContinuousTaskMgr_->continuousTaskInfosMap_.clear();
+    bgContinuousTaskMgr_->taskSnapshot_ = nullptr;
+}
+
+/**
+ * @tc.name: InitStepGraph_001
+ * @tc.desc: test init steps run after their dependencies and a failed step skips its dependents.
+ * @tc.type: FUNC
+ * @tc.require: issueI5IRJK issueI4QT3W
+ */
+HWTEST_F(BgContinuousTaskMgrTest, InitStepGraph_001, TestSize.Level1)
+{
+    std::mutex orderMutex;
+    std::vector<std::string> order;
+    auto record = [&orderMutex, &order](const std::string &name, bool result) {
+        return [&orderMutex, &order, name, result]() {
+            std::lock_guard<std::mutex> lock(orderMutex);
+            order.push_back(name);
+            return result;
+        };
+    };
+    InitStepGraph graph("test");
+    EXPECT_TRUE(graph.AddStep("step1", record("step1", true)));
+    EXPECT_TRUE(graph.AddStep("step2", record("step2", true)));
+    EXPECT_FALSE(graph.AddStep("step2", record("step2", true)));
+    EXPECT_FALSE(graph.AddStep("step3", record("step3", true), {"unknown"}));
+    EXPECT_TRUE(graph.AddStep("step3", record("step3", true), {"step1", "step2"}, true));
+    EXPECT_TRUE(graph.Run());
+    ASSERT_EQ(order.size(), TEST_NUM_THREE);
+    EXPECT_EQ(order.back(), "step3");
+
+    order.clear();
+    InitStepGraph failedGraph("test");
+    failedGraph.AddStep("step1", record("step1", false));
+    failedGraph.AddStep("step2", record("step2", true), {"step1"}, true);
+    EXPECT_FALSE(failedGraph.Run());
+    EXPECT_EQ(order.size(), TEST_NUM_ONE);
+    auto costs = failedGraph.GetStepCosts();
+    ASSERT_EQ(costs.size(), TEST_NUM_TWO);
+    EXPECT_EQ(costs[0].state, InitStepState::FAILED);
+    EXPECT_EQ(costs[1].state, InitStepState::PENDING);
+
+    // 未延后时不重新加载通知文案，已有文案保持不变
+    bgContinuousTaskMgr_->notificationPromptDeferred_ = false;
+    bgContinuousTaskMgr_->continuousTaskText_ = {"text"};
+    bgContinuousTaskMgr_->LoadDeferredNotificationPrompt();
+    EXPECT_EQ(bgContinuousTaskMgr_->continuousTaskText_.size(), TEST_NUM_ONE);
+    bgContinuousTaskMgr_->notificationPromptDeferred_ = true;
+    bgContinuousTaskMgr_->LoadDeferredNotificationPrompt();
+    EXPECT_FALSE(bgContinuousTaskMgr_->notificationPromptDeferred_);
+}
 }  // namespace BackgroundTaskMgr
 }  // namespace OHOS
\ No newline at end of file
@@ -21,6 +21,7 @@
 #include "bgtaskmgr_inner_errors.h"
 #include "background_task_subscriber.h"
 #include "bg_efficiency_resources_mgr.h"
+#include "data_storage_helper.h"
 #include "resource_type.h"
 #include "system_ability_definition.h"
 #include "time_provider.h"
@@ -746,5 +747,48 @@ HWTEST_F(BgEfficiencyResourcesMgrTest, RecoverResourceNumber_001, TestSize.Level
         EXPECT_EQ(iter->second->GetResourceNumber(), static_cast<uint32_t>(ResourceType::WORK_SCHEDULER));
     }
 }
+
+/**
+ * @tc.name: RestoreResourceRecord_001
+ * @tc.desc: drop records of dead apps and processes while restoring.
+ * @tc.type: FUNC
+ * @tc.require: issuesI5OD7X
+ */
+HWTEST_F(BgEfficiencyResourcesMgrTest, RestoreResourceRecord_001, TestSize.Level1)
+{
+    constexpr int32_t deadUid = 10003;
+    constexpr int32_t keepUid = 10004;
+    constexpr int32_t deadPid = 11003;
+    constexpr int32_t alivePid = 11004;
+    ResourceRecordMap appRecord;
+    ResourceRecordMap processRecord;
+    appRecord.emplace(deadUid, std::make_shared<ResourceApplicationRecord>(deadUid, 0, ResourceType::CPU, "test1"));
+    appRecord.emplace(keepUid,
+        std::make_shared<ResourceApplicationRecord>(keepUid, 0, ResourceType::WORK_SCHEDULER, "test2"));
+    processRecord.emplace(deadPid,
+        std::make_shared<ResourceApplicationRecord>(deadUid, deadPid, ResourceType::CPU, "test1"));
+    processRecord.emplace(alivePid,
+        std::make_shared<ResourceApplicationRecord>(keepUid, alivePid, ResourceType::CPU, "test2"));
+    auto dataStorageHelper = DelayedSingleton<DataStorageHelper>::GetInstance();
+    dataStorageHelper->RefreshResourceRecord(appRecord, processRecord);
+    dataStorageHelper->FlushPendingRecord();
+
+    std::set<int32_t> runningUid {};
+    std::set<int32_t> runningPid { alivePid };
+    auto filter = [this, &runningUid, &runningPid](bool isProcess, int32_t mapKey,
+        const std::shared_ptr<ResourceApplicationRecord> &record) {
+        return bgEfficiencyResourcesMgr_->IsPersistenceDataAlive(isProcess ? runningPid : runningUid, mapKey,
+            record, isProcess);
+    };
+    ResourceRecordMap restoredApp;
+    ResourceRecordMap restoredProcess;
+    EXPECT_EQ(dataStorageHelper->RestoreResourceRecord(restoredApp, restoredProcess, filter), ERR_OK);
+    EXPECT_EQ(restoredApp.count(deadUid), 0);
+    EXPECT_EQ(restoredApp.count(keepUid), 1);
+    EXPECT_EQ(restoredProcess.count(deadPid), 0);
+    EXPECT_EQ(restoredProcess.count(alivePid), 1);
+    dataStorageHelper->RefreshResourceRecord(ResourceRecordMap {}, ResourceRecordMap {});
+    dataStorageHelper->FlushPendingRecord();
+}
 }  // namespace BackgroundTaskMgr
 }  // namespace OHOS
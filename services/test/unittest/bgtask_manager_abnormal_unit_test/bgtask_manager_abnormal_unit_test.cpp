@@ -701,5 +701,59 @@ HWTEST_F(BgTaskManagerAbnormalUnitTest, BackgroundTaskMgrServiceAbnormalTest_017
     BgMockIpcUid(-1);
     BgMockTokenType(0);
 }
+
+/**
+ * @tc.name: BackgroundTaskMgrServiceAbnormalTest_018
+ * @tc.desc: test batched continuous task control of BackgroundTaskMgrService.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(BgTaskManagerAbnormalUnitTest, BackgroundTaskMgrServiceAbnormalTest_018, TestSize.Level3)
+{
+    std::vector<ContinuousTaskControlInfo> taskList;
+    taskList.emplace_back(1, 1, "", 4);
+    EXPECT_EQ(BackgroundTaskMgrService_->StopContinuousTasks(taskList, 1), ERR_BGTASK_PERMISSION_DENIED);
+    EXPECT_EQ(BackgroundTaskMgrService_->SuspendContinuousTasks(taskList, false), ERR_BGTASK_PERMISSION_DENIED);
+    EXPECT_EQ(BackgroundTaskMgrService_->ActiveContinuousTasks(taskList), ERR_BGTASK_PERMISSION_DENIED);
+
+    BgMockTokenType(2);
+    int32_t resUid = 1096;
+    BgMockIpcUid(resUid);
+    EXPECT_EQ(BackgroundTaskMgrService_->StopContinuousTasks(taskList, 1), 0);
+    EXPECT_EQ(BackgroundTaskMgrService_->SuspendContinuousTasks(taskList, false), 0);
+    EXPECT_EQ(BackgroundTaskMgrService_->ActiveContinuousTasks(taskList), 0);
+
+    std::vector<ContinuousTaskControlInfo> largeTaskList(513, ContinuousTaskControlInfo(1, 1, ""));
+    EXPECT_EQ(BackgroundTaskMgrService_->SuspendContinuousTasks(largeTaskList, false), ERR_BGTASK_INVALID_PARAM);
+
+    BgMockIpcUid(-1);
+    BgMockTokenType(0);
+}
+
+/**
+ * @tc.name: BackgroundTaskMgrServiceAbnormalTest_019
+ * @tc.desc: test GetContinuousTaskAppsDelta of BackgroundTaskMgrService.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(BgTaskManagerAbnormalUnitTest, BackgroundTaskMgrServiceAbnormalTest_019, TestSize.Level3)
+{
+    uint64_t generation = 0;
+    bool isFullResync = false;
+    std::vector<ContinuousTaskCallbackInfo> addedList;
+    std::vector<ContinuousTaskCallbackInfo> updatedList;
+    std::vector<ContinuousTaskCallbackInfo> removedList;
+    EXPECT_EQ(BackgroundTaskMgrService_->GetContinuousTaskAppsDelta(0, generation, isFullResync, addedList,
+        updatedList, removedList), ERR_BGTASK_PERMISSION_DENIED);
+
+    BgMockTokenType(2);
+    int32_t resUid = 1096;
+    BgMockIpcUid(resUid);
+    EXPECT_NE(BackgroundTaskMgrService_->GetContinuousTaskAppsDelta(0, generation, isFullResync, addedList,
+        updatedList, removedList), ERR_BGTASK_PERMISSION_DENIED);
+
+    BgMockIpcUid(-1);
+    BgMockTokenType(0);
+}
 }  // namespace BackgroundTaskMgr
 }  // namespace OHOS
\ No newline at end of file
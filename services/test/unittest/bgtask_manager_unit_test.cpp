@@ -27,6 +27,7 @@
 #include "config_data_source_type.h"
 #include "expired_callback_proxy.h"
 #include "expired_callback_stub.h"
+#include "foreground_app_tracker.h"
 #include "if_system_ability_manager.h"
 #include "iservice_registry.h"
 #include "resources_subscriber_mgr.h"
@@ -551,8 +552,9 @@ HWTEST_F(BgTaskManagerUnitTest, BgTaskManagerUnitTest_043, TestSize.Level1)
         bundleName = SCB_BUNDLE_NAME;
         uid = GetUidByBundleName(bundleName, DEFAULT_USERID);
     }
-    bgTransientTaskMgr_->decisionMaker_->foregroundUidPidMap_[uid].insert(1);
+    DelayedSingleton<ForegroundAppTracker>::GetInstance()->UpdateProcessState(uid, 1, true);
     EXPECT_NE(bgTransientTaskMgr_->PauseTransientTaskTimeForInner(uid), ERR_OK);
+    DelayedSingleton<ForegroundAppTracker>::GetInstance()->UpdateProcessState(uid, 1, false);
 }
 
 /**
@@ -579,8 +581,9 @@ HWTEST_F(BgTaskManagerUnitTest, BgTaskManagerUnitTest_044, TestSize.Level1)
         bundleName = SCB_BUNDLE_NAME;
         uid = GetUidByBundleName(bundleName, DEFAULT_USERID);
     }
-    bgTransientTaskMgr_->decisionMaker_->foregroundUidPidMap_[uid].insert(1);
+    DelayedSingleton<ForegroundAppTracker>::GetInstance()->UpdateProcessState(uid, 1, true);
     EXPECT_NE(bgTransientTaskMgr_->StartTransientTaskTimeForInner(uid), ERR_OK);
+    DelayedSingleton<ForegroundAppTracker>::GetInstance()->UpdateProcessState(uid, 1, false);
 }
 
 /**
@@ -13,6 +13,7 @@
  * limitations under the License.
  */
 
+#include <atomic>
 #include <functional>
 #include <chrono>
 #include <thread>
@@ -32,8 +33,10 @@
 #include "delay_suspend_info_ex.h"
 #include "device_info_manager.h"
 #include "event_info.h"
+#include "event_lane_scheduler.h"
 #include "event_handler.h"
 #include "event_runner.h"
+#include "foreground_app_tracker.h"
 #include "input_manager.h"
 #include "key_info.h"
 #ifdef DISTRIBUTED_NOTIFICATION_ENABLE
@@ -44,15 +47,18 @@
 #endif
 #include "notification_tools.h"
 #include "pkg_delay_suspend_info.h"
+#include "pkg_table.h"
 #include "process_data.h"
 #include "singleton.h"
 #include "string_wrapper.h"
 #include "suspend_controller.h"
 #include "time_provider.h"
 #include "timer_manager.h"
+#include "timing_wheel.h"
 #include "watchdog.h"
 #include "int_wrapper.h"
 #include "common_utils.h"
+#include "record_snapshot.h"
 #ifdef GAME_PRE_LAUNCH_ENABLE
 #include "game_pre_launch_mgr.h"
 #endif
@@ -274,6 +280,23 @@ HWTEST_F(BgTaskMiscUnitTest, ContinuousTaskRecordTest_001, TestSize.Level2)
     EXPECT_TRUE(record4.ParseFromJson(json5));
 }
 
+/**
+ * @tc.name: ContinuousTaskRecordTest_002
+ * @tc.desc: test ContinuousTaskRecord ParseToJson.
+ * @tc.type: FUNC
+ * @tc.require: issueI4QT3W
+ */
+HWTEST_F(BgTaskMiscUnitTest, ContinuousTaskRecordTest_002, TestSize.Level2)
+{
+    ContinuousTaskRecord record = ContinuousTaskRecord();
+    record.wantAgentInfo_ = std::make_shared<WantAgentInfo>();
+    nlohmann::json root;
+    record.ParseToJson(root["key"]);
+    EXPECT_EQ(root["key"], nlohmann::json::parse(record.ParseToJsonStr(), nullptr, false));
+    ContinuousTaskRecord record2 = ContinuousTaskRecord();
+    EXPECT_TRUE(record2.ParseFromJson(root["key"]));
+}
+
 /**
  * @tc.name: NotificationToolsTest_001
  * @tc.desc: test NotificationTools class.
@@ -666,6 +689,245 @@ HWTEST_F(BgTaskMiscUnitTest, DataStorageHelper_002, TestSize.Level2)
     EXPECT_FALSE(DelayedSingleton<DataStorageHelper>::GetInstance()->ParseFastSuspendDozeTime(file, time));
 }
 
+/**
+ * @tc.name: DataStorageHelper_003
+ * @tc.desc: test AppendTaskRecord and replay task journal.
+ * @tc.type: FUNC
+ * @tc.require: issueI4QT3W
+ */
+HWTEST_F(BgTaskMiscUnitTest, DataStorageHelper_003, TestSize.Level2)
+{
+    auto dataStorageHelper = DelayedSingleton<DataStorageHelper>::GetInstance();
+    std::unordered_map<std::string, std::shared_ptr<ContinuousTaskRecord>> continuousTaskInfosMap1;
+    auto record1 = std::make_shared<ContinuousTaskRecord>();
+    record1->uid_ = 1;
+    continuousTaskInfosMap1.emplace("key1", record1);
+    EXPECT_EQ(dataStorageHelper->RefreshTaskRecord(continuousTaskInfosMap1), ERR_OK);
+    EXPECT_EQ(dataStorageHelper->taskJournalEntries_, 0);
+
+    auto record2 = std::make_shared<ContinuousTaskRecord>();
+    record2->uid_ = TEST_NUM_TWO;
+    EXPECT_EQ(dataStorageHelper->AppendTaskRecord("key2", record2), ERR_OK);
+    EXPECT_EQ(dataStorageHelper->AppendTaskRecord("key1", nullptr), ERR_OK);
+    EXPECT_EQ(dataStorageHelper->taskJournalEntries_, TEST_NUM_TWO);
+    EXPECT_FALSE(dataStorageHelper->NeedCompactTaskRecord());
+
+    std::unordered_map<std::string, std::shared_ptr<ContinuousTaskRecord>> continuousTaskInfosMap2;
+    EXPECT_EQ(dataStorageHelper->RestoreTaskRecord(continuousTaskInfosMap2), ERR_OK);
+    EXPECT_EQ(continuousTaskInfosMap2.size(), 1);
+    EXPECT_EQ(continuousTaskInfosMap2.count("key2"), 1);
+
+    EXPECT_EQ(dataStorageHelper->RefreshTaskRecord(continuousTaskInfosMap2), ERR_OK);
+    EXPECT_EQ(dataStorageHelper->taskJournalEntries_, 0);
+}
+
+/**
+ * @tc.name: DataStorageHelper_004
+ * @tc.desc: test write-behind of record files and FlushPendingRecord.
+ * @tc.type: FUNC
+ * @tc.require: issueI4QT3W
+ */
+HWTEST_F(BgTaskMiscUnitTest, DataStorageHelper_004, TestSize.Level2)
+{
+    auto dataStorageHelper = DelayedSingleton<DataStorageHelper>::GetInstance();
+    std::unordered_map<std::string, std::shared_ptr<BannerNotificationRecord>> authRecord1;
+    auto record = std::make_shared<BannerNotificationRecord>();
+    record->SetBundleName("bundleName");
+    authRecord1.emplace("label", record);
+    EXPECT_EQ(dataStorageHelper->RefreshAuthRecord(authRecord1), ERR_OK);
+    EXPECT_EQ(dataStorageHelper->RefreshAuthRecord(authRecord1), ERR_OK);
+    EXPECT_EQ(dataStorageHelper->FlushPendingRecord(), ERR_OK);
+    EXPECT_TRUE(dataStorageHelper->pendingRecords_.empty());
+    EXPECT_TRUE(dataStorageHelper->pendingTaskJournal_.empty());
+
+    std::unordered_map<std::string, std::shared_ptr<BannerNotificationRecord>> authRecord2;
+    EXPECT_EQ(dataStorageHelper->RestoreAuthRecord(authRecord2), ERR_OK);
+    EXPECT_EQ(authRecord2.size(), 1);
+}
+
+/**
+ * @tc.name: DataStorageHelper_005
+ * @tc.desc: test binary task record snapshot and import from json.
+ * @tc.type: FUNC
+ * @tc.require: issueI4QT3W
+ */
+HWTEST_F(BgTaskMiscUnitTest, DataStorageHelper_005, TestSize.Level2)
+{
+    auto dataStorageHelper = DelayedSingleton<DataStorageHelper>::GetInstance();
+    bool binarySnapshot = dataStorageHelper->binarySnapshot_;
+    std::unordered_map<std::string, std::shared_ptr<ContinuousTaskRecord>> continuousTaskInfosMap1;
+    auto record = std::make_shared<ContinuousTaskRecord>();
+    record->uid_ = 1;
+    continuousTaskInfosMap1.emplace("key1", record);
+    dataStorageHelper->binarySnapshot_ = false;
+    EXPECT_EQ(dataStorageHelper->RefreshTaskRecord(continuousTaskInfosMap1), ERR_OK);
+    EXPECT_EQ(dataStorageHelper->FlushPendingRecord(), ERR_OK);
+
+    dataStorageHelper->binarySnapshot_ = true;
+    std::unordered_map<std::string, std::shared_ptr<ContinuousTaskRecord>> continuousTaskInfosMap2;
+    EXPECT_EQ(dataStorageHelper->RestoreTaskRecord(continuousTaskInfosMap2), ERR_OK);
+    EXPECT_EQ(continuousTaskInfosMap2.size(), 1);
+    EXPECT_EQ(dataStorageHelper->RefreshTaskRecord(continuousTaskInfosMap2), ERR_OK);
+    EXPECT_EQ(dataStorageHelper->FlushPendingRecord(), ERR_OK);
+
+    std::unordered_map<std::string, std::shared_ptr<ContinuousTaskRecord>> continuousTaskInfosMap3;
+    EXPECT_EQ(dataStorageHelper->RestoreTaskRecord(continuousTaskInfosMap3), ERR_OK);
+    EXPECT_EQ(continuousTaskInfosMap3.size(), 1);
+    EXPECT_EQ(continuousTaskInfosMap3["key1"]->uid_, 1);
+    dataStorageHelper->binarySnapshot_ = binarySnapshot;
+    EXPECT_EQ(dataStorageHelper->RefreshTaskRecord(continuousTaskInfosMap3), ERR_OK);
+    EXPECT_EQ(dataStorageHelper->FlushPendingRecord(), ERR_OK);
+}
+
+/**
+ * @tc.name: DataStorageHelper_006
+ * @tc.desc: test user data size sampler.
+ * @tc.type: FUNC
+ * @tc.require: issueI4QT3W
+ */
+HWTEST_F(BgTaskMiscUnitTest, DataStorageHelper_006, TestSize.Level2)
+{
+    auto dataStorageHelper = DelayedSingleton<DataStorageHelper>::GetInstance();
+    dataStorageHelper->ScheduleUserDataSizeSample();
+    dataStorageHelper->ScheduleUserDataSizeSample();
+    dataStorageHelper->lastReportedDataSize_ = -1;
+    dataStorageHelper->SampleUserDataSize();
+    EXPECT_FALSE(dataStorageHelper->isDataSizeSampleScheduled_);
+    EXPECT_GE(dataStorageHelper->lastReportedDataSize_, 0);
+    int64_t lastReportTime = dataStorageHelper->lastDataSizeReportTime_;
+    // 大小未变化且未超过上报间隔，不重复上报
+    dataStorageHelper->SampleUserDataSize();
+    EXPECT_EQ(dataStorageHelper->lastDataSizeReportTime_, lastReportTime);
+}
+
+/**
+ * @tc.name: DataStorageHelper_007
+ * @tc.desc: test task and auth records sharded by user.
+ * @tc.type: FUNC
+ * @tc.require: issueI4QT3W
+ */
+HWTEST_F(BgTaskMiscUnitTest, DataStorageHelper_007, TestSize.Level2)
+{
+    constexpr int32_t userId1 = 100;
+    constexpr int32_t userId2 = 101;
+    auto dataStorageHelper = DelayedSingleton<DataStorageHelper>::GetInstance();
+    std::unordered_map<std::string, std::shared_ptr<ContinuousTaskRecord>> continuousTaskInfosMap1;
+    auto record1 = std::make_shared<ContinuousTaskRecord>();
+    record1->userId_ = userId1;
+    auto record2 = std::make_shared<ContinuousTaskRecord>();
+    record2->userId_ = userId2;
+    continuousTaskInfosMap1.emplace("key1", record1);
+    continuousTaskInfosMap1.emplace("key2", record2);
+    EXPECT_EQ(dataStorageHelper->RefreshTaskRecord(continuousTaskInfosMap1), ERR_OK);
+    EXPECT_EQ(dataStorageHelper->FlushPendingRecord(), ERR_OK);
+    EXPECT_EQ(dataStorageHelper->taskShardUsers_.size(), TEST_NUM_TWO);
+
+    // 删除用户后只重写清单并删除该用户的分片
+    continuousTaskInfosMap1.erase("key2");
+    EXPECT_EQ(dataStorageHelper->RefreshTaskRecord(continuousTaskInfosMap1), ERR_OK);
+    EXPECT_EQ(dataStorageHelper->pendingRemovals_.count(
+        "/data/service/el1/public/background_task_mgr/running_task.101"), 1);
+    EXPECT_EQ(dataStorageHelper->FlushPendingRecord(), ERR_OK);
+    EXPECT_EQ(dataStorageHelper->taskShardUsers_.size(), 1);
+
+    std::unordered_map<std::string, std::shared_ptr<ContinuousTaskRecord>> continuousTaskInfosMap2;
+    EXPECT_EQ(dataStorageHelper->RestoreTaskRecord(continuousTaskInfosMap2), ERR_OK);
+    EXPECT_EQ(continuousTaskInfosMap2.size(), 1);
+    EXPECT_EQ(continuousTaskInfosMap2.count("key1"), 1);
+
+    std::unordered_map<std::string, std::shared_ptr<BannerNotificationRecord>> authRecord1;
+    auto authRecord = std::make_shared<BannerNotificationRecord>();
+    authRecord->SetUserId(userId2);
+    authRecord1.emplace("label", authRecord);
+    EXPECT_EQ(dataStorageHelper->RefreshAuthRecord(authRecord1), ERR_OK);
+    EXPECT_EQ(dataStorageHelper->FlushPendingRecord(), ERR_OK);
+    EXPECT_EQ(dataStorageHelper->authShardUsers_.count(userId2), 1);
+    EXPECT_EQ(dataStorageHelper->MergeAuthRecordShards(), ERR_OK);
+    std::unordered_map<std::string, std::shared_ptr<BannerNotificationRecord>> authRecord2;
+    EXPECT_EQ(dataStorageHelper->RestoreAuthRecord(authRecord2), ERR_OK);
+    EXPECT_EQ(authRecord2.size(), 1);
+}
+
+/**
+ * @tc.name: DataStorageHelper_008
+ * @tc.desc: test records and journal restaged after a failed flush.
+ * @tc.type: FUNC
+ * @tc.require: issueI4QT3W
+ */
+HWTEST_F(BgTaskMiscUnitTest, DataStorageHelper_008, TestSize.Level2)
+{
+    const std::string failedPath = "/data/service/el1/public/background_task_mgr/not_exist/record";
+    auto dataStorageHelper = DelayedSingleton<DataStorageHelper>::GetInstance();
+    auto persistHandler = dataStorageHelper->persistHandler_;
+    dataStorageHelper->persistHandler_ = nullptr;
+    EXPECT_EQ(dataStorageHelper->FlushPendingRecord(), ERR_OK);
+    dataStorageHelper->pendingRecords_[failedPath] = "{}";
+    EXPECT_NE(dataStorageHelper->FlushPendingRecord(), ERR_OK);
+    EXPECT_EQ(dataStorageHelper->pendingRecords_.count(failedPath), 1);
+    EXPECT_NE(dataStorageHelper->lastFlushResult_, ERR_OK);
+
+    std::map<std::string, std::string> failedRecords;
+    std::string failedJournal = "journal1\n";
+    dataStorageHelper->pendingTaskJournal_ = "journal2\n";
+    dataStorageHelper->HandleFlushResult(ERR_BGTASK_DATA_STORAGE_ERR, failedRecords, failedJournal);
+    EXPECT_EQ(dataStorageHelper->pendingTaskJournal_, "journal1\njournal2\n");
+
+    // 已暂存全量快照时丢弃失败的增量日志
+    std::map<std::string, std::string> records;
+    std::set<int32_t> users = dataStorageHelper->taskShardUsers_;
+    dataStorageHelper->StageShardRecord(records, users, "/data/service/el1/public/background_task_mgr/running_task",
+        "/data/service/el1/public/background_task_mgr/running_task.manifest", dataStorageHelper->taskShardUsers_);
+    failedJournal = "journal3\n";
+    dataStorageHelper->HandleFlushResult(ERR_BGTASK_DATA_STORAGE_ERR, failedRecords, failedJournal);
+    EXPECT_TRUE(dataStorageHelper->pendingTaskJournal_.empty());
+
+    dataStorageHelper->pendingRecords_.erase(failedPath);
+    EXPECT_EQ(dataStorageHelper->FlushPendingRecord(), ERR_OK);
+    EXPECT_EQ(dataStorageHelper->lastFlushResult_, ERR_OK);
+    dataStorageHelper->persistHandler_ = persistHandler;
+}
+
+/**
+ * @tc.name: RecordSnapshotTest_001
+ * @tc.desc: test RecordSnapshot encode and decode.
+ * @tc.type: FUNC
+ * @tc.require: issueI4QT3W
+ */
+HWTEST_F(BgTaskMiscUnitTest, RecordSnapshotTest_001, TestSize.Level2)
+{
+    RecordSnapshot snapshot;
+    nlohmann::json value1;
+    value1["uid"] = 1;
+    nlohmann::json value2;
+    value2["bundleName"] = "bundleName";
+    snapshot.Append(0, "key1", value1);
+    snapshot.Append(1, "key2", value2);
+    std::string data = snapshot.Finish();
+    const uint8_t *buffer = reinterpret_cast<const uint8_t *>(data.data());
+    EXPECT_TRUE(RecordSnapshot::IsSnapshot(buffer, data.size()));
+
+    std::map<std::string, nlohmann::json> result;
+    auto visitor = [&result](uint32_t section, const std::string &key, const nlohmann::json &value) {
+        result[key] = value;
+    };
+    EXPECT_TRUE(RecordSnapshot::Decode(buffer, data.size(), visitor));
+    EXPECT_EQ(result.size(), TEST_NUM_TWO);
+    EXPECT_EQ(result["key1"], value1);
+    EXPECT_EQ(result["key2"], value2);
+
+    // 篡改最后一条记录，校验失败的记录被跳过
+    std::string corrupted = data;
+    corrupted.back() ^= 1;
+    result.clear();
+    EXPECT_TRUE(RecordSnapshot::Decode(reinterpret_cast<const uint8_t *>(corrupted.data()),
+        corrupted.size(), visitor));
+    EXPECT_EQ(result.size(), 1);
+
+    // 截断的快照返回失败
+    EXPECT_FALSE(RecordSnapshot::Decode(buffer, data.size() - 1, visitor));
+    EXPECT_FALSE(RecordSnapshot::IsSnapshot(reinterpret_cast<const uint8_t *>("{}"), TEST_NUM_TWO));
+}
+
 /**
  * @tc.name: DecisionMakerTest_004
  * @tc.desc: test PauseTransientTaskTimeForInner.
@@ -682,11 +944,11 @@ HWTEST_F(BgTaskMiscUnitTest, DecisionMakerTest_004, TestSize.Level2)
 
     std::string name = "bundleName1";
     int32_t uid = 1;
-    decisionMaker->foregroundUidPidMap_[uid].insert(1);
+    DelayedSingleton<ForegroundAppTracker>::GetInstance()->UpdateProcessState(uid, 1, true);
     EXPECT_EQ(decisionMaker->PauseTransientTaskTimeForInner(uid, name), ERR_BGTASK_FOREGROUND);
 
     auto keyInfo = std::make_shared<KeyInfo>("bundleName1", 1);
-    decisionMaker->foregroundUidPidMap_.clear();
+    DelayedSingleton<ForegroundAppTracker>::GetInstance()->Clear();
     decisionMaker->pkgDelaySuspendInfoMap_.clear();
     EXPECT_EQ(decisionMaker->PauseTransientTaskTimeForInner(uid, name), ERR_BGTASK_NOREQUEST_TASK);
     
@@ -714,11 +976,11 @@ HWTEST_F(BgTaskMiscUnitTest, DecisionMakerTest_005, TestSize.Level2)
 
     std::string name = "bundleName1";
     int32_t uid = 1;
-    decisionMaker->foregroundUidPidMap_[uid].insert(1);
+    DelayedSingleton<ForegroundAppTracker>::GetInstance()->UpdateProcessState(uid, 1, true);
     EXPECT_EQ(decisionMaker->StartTransientTaskTimeForInner(uid, name), ERR_BGTASK_FOREGROUND);
 
     auto keyInfo = std::make_shared<KeyInfo>("bundleName1", 1);
-    decisionMaker->foregroundUidPidMap_.clear();
+    DelayedSingleton<ForegroundAppTracker>::GetInstance()->Clear();
     decisionMaker->pkgDelaySuspendInfoMap_.clear();
     EXPECT_EQ(decisionMaker->StartTransientTaskTimeForInner(uid, name), ERR_BGTASK_NOREQUEST_TASK);
     
@@ -727,7 +989,7 @@ HWTEST_F(BgTaskMiscUnitTest, DecisionMakerTest_005, TestSize.Level2)
     auto delayInfo = std::make_shared<DelaySuspendInfoEx>(1);
     pkgDelaySuspendInfo->requestList_.push_back(delayInfo);
     decisionMaker->pkgDelaySuspendInfoMap_[keyInfo1] = pkgDelaySuspendInfo;
-    decisionMaker->foregroundUidPidMap_.clear();
+    DelayedSingleton<ForegroundAppTracker>::GetInstance()->Clear();
     EXPECT_EQ(decisionMaker->StartTransientTaskTimeForInner(uid, name), ERR_OK);
 }
 
@@ -776,7 +1038,7 @@ HWTEST_F(BgTaskMiscUnitTest, DelaySuspendInfoEx_001, TestSize.Level2)
     delayInfo->StartAccounting();
     delayInfo->baseTime_ = 0;
     delayInfo->StopAccounting();
-    EXPECT_EQ(delayInfo->spendTime_, 0);
+    EXPECT_EQ(delayInfo->spendTime_.load(), 0);
 }
 
 /**
@@ -858,38 +1120,6 @@ HWTEST_F(BgTaskMiscUnitTest, OnProcessStateChanged_001, TestSize.Level2)
     EXPECT_EQ((int32_t)decisionMaker->pkgDelaySuspendInfoMap_.size(), 1);
 }
 
-/**
- * @tc.name: OnProcessDied_001
- * @tc.desc: test DecisionMaker::OnProcessDied.
- * @tc.type: FUNC
- */
-HWTEST_F(BgTaskMiscUnitTest, OnProcessDied_001, TestSize.Level2)
-{
-    auto deviceInfoManeger = std::make_shared<DeviceInfoManager>();
-    auto bgtaskService = sptr<BackgroundTaskMgrService>(new BackgroundTaskMgrService());
-    auto timerManager =
-        std::make_shared<TimerManager>(bgtaskService, AppExecFwk::EventRunner::Create("tdd_test_handler"));
-    auto decisionMaker = std::make_shared<DecisionMaker>(timerManager, deviceInfoManeger);
-
-    AppExecFwk::ProcessData processData;
-    processData.uid = 100001;
-    processData.pid = 100;
-    processData.bundleName = "bundleName1";
-    processData.state = AppExecFwk::AppProcessState::APP_STATE_FOREGROUND;
-    decisionMaker->OnProcessStateChanged(processData);
-    EXPECT_TRUE(decisionMaker->IsUidForeground(processData.uid));
-
-    auto keyInfo1 = std::make_shared<KeyInfo>("bundleName1", processData.uid);
-    auto pkgDelaySuspendInfo = std::make_shared<PkgDelaySuspendInfo>("bundleName1", processData.uid, timerManager);
-    auto delayInfo = std::make_shared<DelaySuspendInfoEx>(processData.pid);
-    pkgDelaySuspendInfo->requestList_.push_back(delayInfo);
-    decisionMaker->pkgDelaySuspendInfoMap_[keyInfo1] = pkgDelaySuspendInfo;
-
-    decisionMaker->OnProcessDied(processData);
-    EXPECT_FALSE(decisionMaker->IsUidForeground(processData.uid));
-    EXPECT_TRUE(pkgDelaySuspendInfo->isCounting_);
-}
-
 /**
  * @tc.name: TaskNotificationSubscriber_003
  * @tc.desc: test TaskNotificationSubscriber class.
@@ -1028,7 +1258,7 @@ HWTEST_F(BgTaskMiscUnitTest, NotificationToolsTest_003, TestSize.Level2)
         subRecord, "appName", "prompt", 1, mainRecord), ERR_BGTASK_NOTIFICATION_ERR);
     mainRecord->notificationId_ = 1;
     EXPECT_EQ(NotificationTools::GetInstance()->PublishMainNotification(
-        subRecord, "appName", "prompt", 1, mainRecord), ERR_BGTASK_NOTIFICATION_ERR);
+        subRecord, "appName", "prompt", 1, mainRecord), ERR_OK);
 #endif
 }
 
@@ -1203,5 +1433,247 @@ HWTEST_F(BgTaskMiscUnitTest, NotificationToolsTest_005, TestSize.Level2)
         "prompt", 0, bannerNotificationBtn), ERR_BGTASK_NOTIFICATION_ERR);
 #endif
 }
+
+/**
+ * @tc.name: NotificationToolsTest_006
+ * @tc.desc: test task found by notification label published after it was inserted.
+ * @tc.type: FUNC
+ * @tc.require: issueI4QT3W
+ */
+HWTEST_F(BgTaskMiscUnitTest, NotificationToolsTest_006, TestSize.Level2)
+{
+#ifdef DISTRIBUTED_NOTIFICATION_ENABLE
+    SetPublishContinuousTaskNotificationFlag(0);
+    auto bgContinuousTaskMgr = std::make_shared<BgContinuousTaskMgr>();
+    bgContinuousTaskMgr->continuousTaskText_.push_back("bgmode_test");
+    CachedBundleInfo info = CachedBundleInfo();
+    info.appName_ = "appName";
+    bgContinuousTaskMgr->cachedBundleInfos_.emplace(TEST_NUM_ONE, info);
+    auto record = std::make_shared<ContinuousTaskRecord>();
+    record->uid_ = TEST_NUM_ONE;
+    record->abilityName_ = "abilityName";
+    record->bgModeId_ = BackgroundMode::DATA_TRANSFER;
+    record->bgModeIds_.push_back(BackgroundMode::DATA_TRANSFER);
+    record->isNewApi_ = true;
+    record->notificationId_ = 1;
+    bgContinuousTaskMgr->continuousTaskInfosMap_.emplace("1_abilityName_0", record);
+    EXPECT_EQ(bgContinuousTaskMgr->continuousTaskInfosMap_.GetKeysByNotificationLabel("").size(), 1);
+
+    EXPECT_EQ(bgContinuousTaskMgr->SendContinuousTaskNotification(record), ERR_OK);
+    EXPECT_FALSE(record->notificationLabel_.empty());
+    auto keys = bgContinuousTaskMgr->continuousTaskInfosMap_.GetKeysByNotificationLabel(record->notificationLabel_);
+    ASSERT_EQ(keys.size(), 1);
+    EXPECT_EQ(keys.front(), "1_abilityName_0");
+    EXPECT_TRUE(bgContinuousTaskMgr->continuousTaskInfosMap_.GetKeysByNotificationLabel("").empty());
+#endif
+}
+
+/**
+ * @tc.name: EventLaneSchedulerTest_001
+ * @tc.desc: test ipc lane runs ahead of queued maintenance tasks and lane metrics.
+ * @tc.type: FUNC
+ * @tc.require: issueI4QT3W
+ */
+HWTEST_F(BgTaskMiscUnitTest, EventLaneSchedulerTest_001, TestSize.Level2)
+{
+    auto scheduler = DelayedSingleton<EventLaneScheduler>::GetInstance();
+    scheduler->ResetLaneMetrics();
+    EXPECT_FALSE(scheduler->PostSyncTask(nullptr, EventLane::IPC, []() {}));
+    EXPECT_FALSE(scheduler->PostTask(nullptr, EventLane::MAINTENANCE, []() {}));
+
+    auto runner = AppExecFwk::EventRunner::Create("EventLaneSchedulerTest");
+    auto handler = std::make_shared<AppExecFwk::EventHandler>(runner);
+    std::mutex orderMutex;
+    std::vector<int32_t> order;
+    scheduler->PostTask(handler, EventLane::MAINTENANCE, []() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(SLEEP_TIME));
+    });
+    for (int32_t i = 1; i <= 3; i++) {
+        scheduler->PostTask(handler, EventLane::MAINTENANCE, [&orderMutex, &order, i]() {
+            std::lock_guard<std::mutex> lock(orderMutex);
+            order.emplace_back(i);
+        });
+    }
+    EXPECT_TRUE(scheduler->PostSyncTask(handler, EventLane::IPC, [&orderMutex, &order]() {
+        std::lock_guard<std::mutex> lock(orderMutex);
+        order.emplace_back(0);
+    }));
+    scheduler->PostTask(handler, EventLane::MAINTENANCE, []() {}, "EventLaneSchedulerTest", SLEEP_TIME);
+    handler->RemoveTask("EventLaneSchedulerTest");
+    scheduler->PostSyncTask(handler, EventLane::MAINTENANCE, []() {});
+    ASSERT_EQ(order.size(), 4);
+    EXPECT_EQ(order.front(), 0);
+
+    EventLaneMetrics ipcMetrics = scheduler->GetLaneMetrics(EventLane::IPC);
+    EXPECT_EQ(ipcMetrics.posted, 1);
+    EXPECT_EQ(ipcMetrics.executed, 1);
+    EXPECT_EQ(ipcMetrics.pending, 0);
+    EventLaneMetrics maintenanceMetrics = scheduler->GetLaneMetrics(EventLane::MAINTENANCE);
+    EXPECT_EQ(maintenanceMetrics.posted, 6);
+    EXPECT_EQ(maintenanceMetrics.executed, 5);
+    EXPECT_EQ(maintenanceMetrics.dropped, 1);
+    EXPECT_EQ(maintenanceMetrics.pending, 0);
+    EXPECT_GE(maintenanceMetrics.maxPending, 3);
+
+    std::vector<std::string> dumpInfo;
+    scheduler->DumpLaneMetrics(dumpInfo);
+    EXPECT_EQ(dumpInfo.size(), static_cast<size_t>(EventLane::LANE_BUTT));
+}
+
+/**
+ * @tc.name: PkgTableTest_001
+ * @tc.desc: test PkgTable lookup by name and uid, and erasing while iterating.
+ * @tc.type: FUNC
+ * @tc.require: issueI4QT3W
+ */
+HWTEST_F(BgTaskMiscUnitTest, PkgTableTest_001, TestSize.Level2)
+{
+    PkgTable<int32_t> table;
+    auto keyInfo1 = std::make_shared<KeyInfo>("bundleName1", 1, 100);
+    auto keyInfo2 = std::make_shared<KeyInfo>("bundleName1", TEST_NUM_TWO);
+    auto keyInfo3 = std::make_shared<KeyInfo>("bundleName2", 1);
+    table[keyInfo1] = 1;
+    table[keyInfo2] = TEST_NUM_TWO;
+    table[keyInfo3] = 3;
+    EXPECT_EQ(table.size(), 3);
+    EXPECT_EQ(table.find(nullptr), table.end());
+    EXPECT_EQ(table.find("bundleName3", 1), table.end());
+    ASSERT_NE(table.find("bundleName1", 1), table.end());
+    EXPECT_EQ(table.find("bundleName1", 1)->second, 1);
+    EXPECT_EQ(table.find("bundleName1", 1)->first->GetPid(), 100);
+    table[std::make_shared<KeyInfo>("bundleName1", 1)] = 4;
+    EXPECT_EQ(table.size(), 3);
+    EXPECT_EQ(table.find(keyInfo1)->second, 4);
+
+    for (auto iter = table.begin(); iter != table.end();) {
+        if (iter->first->GetPkg() == "bundleName1") {
+            iter = table.erase(iter);
+        } else {
+            iter++;
+        }
+    }
+    EXPECT_EQ(table.size(), 1);
+    EXPECT_EQ(table.count(keyInfo1), 0);
+    EXPECT_EQ(table.find("bundleName2", 1)->second, 3);
+    EXPECT_EQ(table.erase(keyInfo3), 1);
+    EXPECT_TRUE(table.empty());
+    table[keyInfo2] = TEST_NUM_TWO;
+    table.clear();
+    EXPECT_EQ(table.find(keyInfo2), table.end());
+}
+
+/**
+ * @tc.name: ForegroundAppTrackerTest_001
+ * @tc.desc: test ForegroundAppTracker keeps the foreground uids from process events.
+ * @tc.type: FUNC
+ * @tc.require: issueI4QT3W
+ */
+HWTEST_F(BgTaskMiscUnitTest, ForegroundAppTrackerTest_001, TestSize.Level2)
+{
+    auto tracker = DelayedSingleton<ForegroundAppTracker>::GetInstance();
+    tracker->Clear();
+    AppExecFwk::ProcessData processData;
+    processData.uid = 100001;
+    processData.pid = 100;
+    processData.state = AppExecFwk::AppProcessState::APP_STATE_FOCUS;
+    tracker->OnProcessStateChanged(processData);
+    tracker->UpdateProcessState(processData.uid, 101, true);
+    tracker->UpdateProcessState(100002, 200, true);
+    EXPECT_TRUE(tracker->IsUidForeground(processData.uid));
+    std::set<int32_t> uids;
+    tracker->ForEachForegroundUid([&uids](int32_t uid) { uids.insert(uid); });
+    EXPECT_EQ(uids.size(), TEST_NUM_TWO);
+
+    processData.state = AppExecFwk::AppProcessState::APP_STATE_BACKGROUND;
+    tracker->OnProcessStateChanged(processData);
+    EXPECT_TRUE(tracker->IsUidForeground(processData.uid));
+    processData.pid = 101;
+    tracker->OnProcessDied(processData);
+    EXPECT_FALSE(tracker->IsUidForeground(processData.uid));
+    tracker->Clear();
+    EXPECT_FALSE(tracker->IsUidForeground(100002));
+}
+
+/**
+ * @tc.name: TimingWheelTest_001
+ * @tc.desc: test TimingWheel arm, cancel, re-arm and cascade of far timers.
+ * @tc.type: FUNC
+ * @tc.require: issueI4QT3W
+ */
+HWTEST_F(BgTaskMiscUnitTest, TimingWheelTest_001, TestSize.Level2)
+{
+    constexpr int64_t tickMs = 100;
+    TimingWheel timingWheel(tickMs, 0);
+    EXPECT_EQ(timingWheel.GetNextWakeupMs(), -1);
+    timingWheel.Arm(1, 250);
+    timingWheel.Arm(2, 180000);
+    timingWheel.Arm(3, 1000);
+    timingWheel.Arm(1, 500);
+    EXPECT_TRUE(timingWheel.Cancel(3));
+    EXPECT_FALSE(timingWheel.Cancel(3));
+    EXPECT_EQ(timingWheel.Size(), TEST_NUM_TWO);
+    EXPECT_EQ(timingWheel.GetNextWakeupMs(), 500);
+
+    std::vector<ExpiredTimer> expired;
+    timingWheel.Advance(499, expired);
+    EXPECT_TRUE(expired.empty());
+    timingWheel.Advance(550, expired);
+    ASSERT_EQ(expired.size(), 1);
+    EXPECT_EQ(expired[0].key, 1);
+    EXPECT_FALSE(timingWheel.IsArmed(1));
+
+    expired.clear();
+    int64_t nowMs = 550;
+    while (timingWheel.Size() > 0) {
+        nowMs = timingWheel.GetNextWakeupMs();
+        ASSERT_GT(nowMs, 0);
+        timingWheel.Advance(nowMs, expired);
+    }
+    ASSERT_EQ(expired.size(), 1);
+    EXPECT_EQ(expired[0].key, TEST_NUM_TWO);
+    EXPECT_EQ(nowMs, 180000);
+}
+
+/**
+ * @tc.name: PkgDelaySuspendInfoTest_003
+ * @tc.desc: test remaining time and quota read without locking while the package is accounting.
+ * @tc.type: FUNC
+ * @tc.require: issueI4QT3W
+ */
+HWTEST_F(BgTaskMiscUnitTest, PkgDelaySuspendInfoTest_003, TestSize.Level2)
+{
+    constexpr int32_t readTimes = 1000;
+    auto bgtaskService = sptr<BackgroundTaskMgrService>(new BackgroundTaskMgrService());
+    auto timerManager =
+        std::make_shared<TimerManager>(bgtaskService, AppExecFwk::EventRunner::Create("tdd_test_handler"));
+    auto pkgDelaySuspendInfo = std::make_shared<PkgDelaySuspendInfo>("bundleName1", 1, timerManager);
+    auto delayInfo = std::make_shared<DelaySuspendInfoEx>(1, 1);
+    pkgDelaySuspendInfo->AddRequest(delayInfo, DELAY_TIME_NORMAL);
+    int32_t delayTime = delayInfo->GetActualDelayTime();
+
+    std::atomic<bool> stop {false};
+    std::thread accounting([&pkgDelaySuspendInfo, &stop]() {
+        while (!stop.load()) {
+            pkgDelaySuspendInfo->StartAccounting(1);
+            pkgDelaySuspendInfo->StopAccounting(1);
+        }
+    });
+    for (int32_t i = 0; i < readTimes; i++) {
+        int32_t remainTime = pkgDelaySuspendInfo->GetRemainDelayTime(1);
+        EXPECT_GE(remainTime, 0);
+        EXPECT_LE(remainTime, delayTime);
+        int32_t quota = pkgDelaySuspendInfo->GetRemainQuota();
+        EXPECT_GE(quota, 0);
+        EXPECT_LE(quota, INIT_QUOTA);
+    }
+    stop.store(true);
+    accounting.join();
+
+    pkgDelaySuspendInfo->StopAccountingAll();
+    EXPECT_EQ(pkgDelaySuspendInfo->GetRemainQuota(), pkgDelaySuspendInfo->GetQuota());
+    EXPECT_EQ(pkgDelaySuspendInfo->GetRemainDelayTime(1), delayInfo->GetRemainDelayTime());
+    pkgDelaySuspendInfo->RemoveRequest(1);
+    EXPECT_TRUE(pkgDelaySuspendInfo->IsRequestEmpty());
+}
 }
 }
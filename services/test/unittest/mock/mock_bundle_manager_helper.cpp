@@ -19,6 +19,8 @@
 
 #include "continuous_task_log.h"
 #include "include/ibundle_manager_helper.h"
+#include "iservice_registry.h"
+#include "system_ability_definition.h"
 
 namespace OHOS {
 namespace BackgroundTaskMgr {
@@ -62,6 +64,20 @@ std::string BundleManagerHelper::GetClientBundleName(int32_t uid)
     return TEST_DEFAULT_BUNDLE;
 }
 
+bool BundleManagerHelper::GetBundleNameForUid(int32_t uid, std::string &bundleName)
+{
+    sptr<ISystemAbilityManager> systemMgr = SystemAbilityManagerClient::GetInstance().GetSystemAbilityManager();
+    if (systemMgr == nullptr) {
+        return false;
+    }
+    sptr<AppExecFwk::IBundleMgr> bundleMgrProxy =
+        iface_cast<AppExecFwk::IBundleMgr>(systemMgr->GetSystemAbility(BUNDLE_MGR_SERVICE_SYS_ABILITY_ID));
+    if (bundleMgrProxy == nullptr) {
+        return false;
+    }
+    return bundleMgrProxy->GetNameForUid(uid, bundleName) == ERR_OK;
+}
+
 bool BundleManagerHelper::CheckPermission(const std::string &permission)
 {
     return true;
@@ -33,10 +33,14 @@
 #include "delay_suspend_info.h"
 #include "device_info_manager.h"
 #include "event_handler.h"
+#include "event_lane_scheduler.h"
 #include "event_info.h"
 #include "ibackground_task_mgr.h"
 #include "iexpired_callback.h"
 #include "ibackground_task_subscriber.h"
+#include "subscriber_dispatcher.h"
+#include "subscriber_event_parcel.h"
+#include "subscriber_registry.h"
 #include "timer_manager.h"
 #include "transient_task_app_info.h"
 #include "watchdog.h"
@@ -93,6 +97,9 @@ private:
     ErrCode CancelSuspendDelayLocked(int32_t requestId);
     void NotifyTransientTaskSuscriber(const shared_ptr<TransientTaskAppInfo>& appInfo,
         const TransientTaskEventType type);
+    void DispatchToSubscriber(const sptr<IBackgroundTaskSubscriber>& subscriber,
+        const shared_ptr<TransientTaskAppInfo>& appInfo, const TransientTaskEventType type,
+        const shared_ptr<SubscriberEventParcel>& parcel);
     bool DumpAllRequestId(std::vector<std::string> &dumpInfo);
     void DumpTaskTime(const std::vector<std::string> &dumpOption, bool pause, std::vector<std::string> &dumpInfo);
     void SendLowBatteryEvent(std::vector<std::string> &dumpInfo);
@@ -104,9 +111,11 @@ private:
     sptr<SubscriberDeathRecipient> susriberDeathRecipient_ {nullptr};
     std::mutex expiredCallbackLock_;
     std::map<int32_t, sptr<IExpiredCallback>> expiredCallbackMap_;
+    // 修改keyInfoMap_需同时持有expiredCallbackLock_和keyInfoLock_，查询持有任一即可
+    std::mutex keyInfoLock_;
     std::map<int32_t, std::shared_ptr<KeyInfo>> keyInfoMap_;
     sptr<ExpiredCallbackDeathRecipient> callbackDeathRecipient_ {nullptr};
-    std::list<sptr<IBackgroundTaskSubscriber>> subscriberList_;
+    SubscriberRegistry<sptr<IBackgroundTaskSubscriber>> subscriberList_ {};
 
     std::shared_ptr<TimerManager> timerManager_ {nullptr};
     std::shared_ptr<Watchdog> watchdog_ {nullptr};
@@ -114,6 +123,9 @@ private:
     std::shared_ptr<DeviceInfoManager> deviceInfoManeger_ {nullptr};
     std::shared_ptr<DecisionMaker> decisionMaker_ {nullptr};
     std::shared_ptr<AppExecFwk::EventHandler> handler_;
+    std::shared_ptr<EventLaneScheduler> laneScheduler_ {DelayedSingleton<EventLaneScheduler>::GetInstance()};
+    std::shared_ptr<SubscriberDispatcher> subscriberDispatcher_ {
+        DelayedSingleton<SubscriberDispatcher>::GetInstance()};
     std::mutex transientUidLock_;
     std::set<int32_t> transientPauseUid_ {};
 };
@@ -33,6 +33,7 @@
 #include "iremote_object.h"
 #include "key_info.h"
 #include "pkg_delay_suspend_info.h"
+#include "pkg_table.h"
 #include "suspend_controller.h"
 #include "timer_manager.h"
 
@@ -72,20 +73,21 @@ private:
     int GetAllowRequestTime();
     ErrCode CheckQuotaTime(const std::shared_ptr<PkgDelaySuspendInfo>& pkgInfo, const std::string &name,
         int32_t uid, const std::shared_ptr<KeyInfo>& key, bool& needSetTime);
-    void UpdateForegroundUidPidMap(int32_t uid, int32_t pid, bool isForeground);
     ErrCode TryStartAccounting(int32_t uid, const std::string &bundleName);
+    std::shared_ptr<PkgDelaySuspendInfo> FindPkgInfo(const std::string &pkg, int32_t uid);
 
     const int32_t initRequestId_ = 1;
     int32_t requestId_ {initRequestId_};
+    // 决策锁，串行化申请、取消与状态变化；查询只持有表锁和包内锁
     std::mutex lock_;
+    // 表锁，持有决策锁时增删包信息需同时持有
+    std::mutex pkgMapLock_;
     int64_t lastRequestTime_ {0};
     SuspendController suspendController_;
     std::shared_ptr<TimerManager> timerManager_ {nullptr};
     std::shared_ptr<DeviceInfoManager> deviceInfoManager_ {nullptr};
-    std::map<std::shared_ptr<KeyInfo>, std::shared_ptr<PkgDelaySuspendInfo>, KeyInfoComp> pkgDelaySuspendInfoMap_;
-    std::map<std::shared_ptr<KeyInfo>, int32_t, KeyInfoComp> pkgBgDurationMap_;
-    std::recursive_mutex recMutex_;
-    std::map<int32_t, std::set<int32_t>> foregroundUidPidMap_;
+    PkgTable<std::shared_ptr<PkgDelaySuspendInfo>> pkgDelaySuspendInfoMap_;
+    PkgTable<int32_t> pkgBgDurationMap_;
 };
 }  // namespace BackgroundTaskMgr
 }  // namespace OHOS
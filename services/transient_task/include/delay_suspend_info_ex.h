@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Copyright (c) 2022-2026 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -16,13 +16,19 @@
 #ifndef FOUNDATION_RESOURCESCHEDULE_BACKGROUND_TASK_MGR_SERVICES_TRANSIENT_TASK_INCLUDE_DELAY_SUSPEND_INFO_EX_H
 #define FOUNDATION_RESOURCESCHEDULE_BACKGROUND_TASK_MGR_SERVICES_TRANSIENT_TASK_INCLUDE_DELAY_SUSPEND_INFO_EX_H
 
+#include <atomic>
 #include <string>
 
 #include "delay_suspend_info.h"
+#include "seq_counter.h"
 #include "time_provider.h"
 
 namespace OHOS {
 namespace BackgroundTaskMgr {
+/**
+ * Transient task request with its accounting state. Accounting is started and stopped by the owning package under
+ * its lock, the remaining time is read without locking.
+ */
 class DelaySuspendInfoEx : public DelaySuspendInfo {
 public:
     explicit DelaySuspendInfoEx(const int32_t& pid, const int32_t& requestId = -1, const int32_t& delaytime = 0);
@@ -44,14 +50,18 @@ public:
 
     inline int64_t GetBaseTime() const
     {
-        return baseTime_;
+        return baseTime_.load(std::memory_order_relaxed);
     }
 
+private:
+    void LoadTimes(int64_t &baseTime, int64_t &spendTime) const;
+
 private:
     const int32_t advanceTime_ = 6 * MSEC_PER_SEC; // 6s
     int32_t pid_ {-1};
-    int64_t baseTime_ {0};
-    int64_t spendTime_ {0};
+    SeqCounter timeSeq_;
+    std::atomic<int64_t> baseTime_ {0};
+    std::atomic<int64_t> spendTime_ {0};
 };
 }  // namespace BackgroundTaskMgr
 }  // namespace OHOS
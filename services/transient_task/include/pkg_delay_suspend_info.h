@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Copyright (c) 2022-2026 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -16,11 +16,15 @@
 #ifndef FOUNDATION_RESOURCESCHEDULE_BACKGROUND_TASK_MGR_SERVICES_TRANSIENT_TASK_INCLUDE_PKG_DELAY_SUSPEND_INFO_H
 #define FOUNDATION_RESOURCESCHEDULE_BACKGROUND_TASK_MGR_SERVICES_TRANSIENT_TASK_INCLUDE_PKG_DELAY_SUSPEND_INFO_H
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 #include "bgtask_common.h"
 #include "delay_suspend_info_ex.h"
+#include "seq_counter.h"
 #include "timer_manager.h"
 
 namespace OHOS {
@@ -29,6 +33,11 @@ using std::shared_ptr;
 using std::vector;
 using std::string;
 
+/**
+ * Transient task requests and quota of one package. The request list is guarded by the lock of the package, so
+ * accounting of different packages never contends. Quota fields are updated under that lock as well and may be
+ * read without locking.
+ */
 class PkgDelaySuspendInfo {
 public:
     PkgDelaySuspendInfo(const string& pkg, const int32_t& uid, const shared_ptr<TimerManager>& timerManager)
@@ -44,6 +53,11 @@ public:
     void StopAccountingAll();
     void UpdateQuota(bool reset = false);
 
+    /**
+     * @brief Get the quota left at this moment, without locking or updating the quota.
+     */
+    int32_t GetRemainQuota();
+
     inline const string& GetPkg() const
     {
         return pkg_;
@@ -56,34 +70,42 @@ public:
 
     inline bool IsRequestEmpty() const
     {
+        std::lock_guard<std::mutex> lock(infoLock_);
         return requestList_.empty();
     }
 
     inline size_t GetRequestSize() const
     {
+        std::lock_guard<std::mutex> lock(infoLock_);
         return requestList_.size();
     }
 
     inline int32_t GetQuota() const
     {
-        return quota_;
+        return quota_.load(std::memory_order_relaxed);
     }
 
     inline vector<shared_ptr<DelaySuspendInfoEx>> GetRequestList() const
     {
+        std::lock_guard<std::mutex> lock(infoLock_);
         return requestList_;
     }
 
 private:
-    int32_t GetModifiedTime();
+    int32_t GetModifiedTime(int32_t baseTime);
+    void UpdateQuotaLocked(bool reset = false);
+    void SetCountingLocked(bool isCounting);
+    void StopAccountingLocked(const int32_t requestId);
 
 private:
     string pkg_ {""};
     int32_t uid_ {-1};
-    int32_t quota_ {INIT_QUOTA};
-    int32_t spendTime_ {0};
-    int32_t baseTime_ {0};
-    bool isCounting_ {false};
+    mutable std::mutex infoLock_;
+    SeqCounter quotaSeq_;
+    std::atomic<int32_t> quota_ {INIT_QUOTA};
+    std::atomic<int32_t> spendTime_ {0};
+    std::atomic<int32_t> baseTime_ {0};
+    std::atomic<bool> isCounting_ {false};
     shared_ptr<TimerManager> timerManager_ {nullptr};
     vector<shared_ptr<DelaySuspendInfoEx>> requestList_;
 };
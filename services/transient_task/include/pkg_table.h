@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FOUNDATION_RESOURCESCHEDULE_BACKGROUND_TASK_MGR_SERVICES_TRANSIENT_TASK_INCLUDE_PKG_TABLE_H
+#define FOUNDATION_RESOURCESCHEDULE_BACKGROUND_TASK_MGR_SERVICES_TRANSIENT_TASK_INCLUDE_PKG_TABLE_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "key_info.h"
+
+namespace OHOS {
+namespace BackgroundTaskMgr {
+/**
+ * Package table keyed by (uid, package). Package names are interned to ids, so the key of an entry is a single
+ * integer and a lookup by name and uid neither allocates nor compares strings beyond one hash lookup. Entries are
+ * stored densely for cache friendly iteration, erasing moves the last entry into the freed slot. The key of an
+ * entry is the first KeyInfo inserted for it. Keys must not be null. Not thread safe.
+ */
+template<typename Value>
+class PkgTable {
+public:
+    using value_type = std::pair<std::shared_ptr<KeyInfo>, Value>;
+    using iterator = typename std::vector<value_type>::iterator;
+    using const_iterator = typename std::vector<value_type>::const_iterator;
+
+    iterator begin()
+    {
+        return entries_.begin();
+    }
+
+    iterator end()
+    {
+        return entries_.end();
+    }
+
+    const_iterator begin() const
+    {
+        return entries_.begin();
+    }
+
+    const_iterator end() const
+    {
+        return entries_.end();
+    }
+
+    size_t size() const
+    {
+        return entries_.size();
+    }
+
+    bool empty() const
+    {
+        return entries_.empty();
+    }
+
+    iterator find(const std::string &pkg, int32_t uid)
+    {
+        auto pkgIter = pkgIds_.find(pkg);
+        if (pkgIter == pkgIds_.end()) {
+            return entries_.end();
+        }
+        auto iter = index_.find(MakeKey(pkgIter->second, uid));
+        return iter == index_.end() ? entries_.end() : entries_.begin() + iter->second;
+    }
+
+    iterator find(const std::shared_ptr<KeyInfo> &key)
+    {
+        if (key == nullptr) {
+            return entries_.end();
+        }
+        return find(key->GetPkg(), key->GetUid());
+    }
+
+    size_t count(const std::shared_ptr<KeyInfo> &key)
+    {
+        return find(key) == entries_.end() ? 0 : 1;
+    }
+
+    Value &operator[](const std::shared_ptr<KeyInfo> &key)
+    {
+        auto iter = find(key);
+        if (iter != entries_.end()) {
+            return iter->second;
+        }
+        index_.emplace(MakeKey(InternPkg(key->GetPkg()), key->GetUid()), entries_.size());
+        entries_.emplace_back(key, Value {});
+        return entries_.back().second;
+    }
+
+    /**
+     * @brief Erase an entry.
+     *
+     * @return Iterator at the same position, now holding the former last entry, so erasing while iterating visits
+     * every entry once.
+     */
+    iterator erase(iterator iter)
+    {
+        size_t pos = static_cast<size_t>(iter - entries_.begin());
+        index_.erase(MakeKey(pkgIds_.at(iter->first->GetPkg()), iter->first->GetUid()));
+        size_t last = entries_.size() - 1;
+        if (pos != last) {
+            auto &moved = entries_[last];
+            index_[MakeKey(pkgIds_.at(moved.first->GetPkg()), moved.first->GetUid())] = pos;
+            entries_[pos] = std::move(moved);
+        }
+        entries_.pop_back();
+        return entries_.begin() + pos;
+    }
+
+    size_t erase(const std::shared_ptr<KeyInfo> &key)
+    {
+        auto iter = find(key);
+        if (iter == entries_.end()) {
+            return 0;
+        }
+        erase(iter);
+        return 1;
+    }
+
+    void clear()
+    {
+        entries_.clear();
+        index_.clear();
+        pkgIds_.clear();
+    }
+
+private:
+    static uint64_t MakeKey(uint32_t pkgId, int32_t uid)
+    {
+        return (static_cast<uint64_t>(pkgId) << 32) | static_cast<uint32_t>(uid);
+    }
+
+    uint32_t InternPkg(const std::string &pkg)
+    {
+        // 包名id只在清空时回收，数量以设备上的应用数为上限
+        auto iter = pkgIds_.find(pkg);
+        if (iter != pkgIds_.end()) {
+            return iter->second;
+        }
+        uint32_t pkgId = static_cast<uint32_t>(pkgIds_.size());
+        pkgIds_.emplace(pkg, pkgId);
+        return pkgId;
+    }
+
+    std::vector<value_type> entries_ {};
+    std::unordered_map<uint64_t, size_t> index_ {};
+    std::unordered_map<std::string, uint32_t> pkgIds_ {};
+};
+}  // namespace BackgroundTaskMgr
+}  // namespace OHOS
+#endif  // FOUNDATION_RESOURCESCHEDULE_BACKGROUND_TASK_MGR_SERVICES_TRANSIENT_TASK_INCLUDE_PKG_TABLE_H
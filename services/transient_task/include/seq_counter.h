@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FOUNDATION_RESOURCESCHEDULE_BACKGROUND_TASK_MGR_SERVICES_TRANSIENT_TASK_INCLUDE_SEQ_COUNTER_H
+#define FOUNDATION_RESOURCESCHEDULE_BACKGROUND_TASK_MGR_SERVICES_TRANSIENT_TASK_INCLUDE_SEQ_COUNTER_H
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+namespace OHOS {
+namespace BackgroundTaskMgr {
+/**
+ * Sequence counter guarding a group of atomic fields that must be read as a consistent set. Writers are serialized
+ * by the owner and wrap their stores in BeginWrite and EndWrite, readers load the fields without locking and retry
+ * while ReadRetry reports that a write overlapped the read.
+ */
+class SeqCounter {
+public:
+    uint32_t ReadBegin() const
+    {
+        uint32_t seq = seq_.load(std::memory_order_acquire);
+        while ((seq & 1u) != 0) {
+            std::this_thread::yield();
+            seq = seq_.load(std::memory_order_acquire);
+        }
+        return seq;
+    }
+
+    bool ReadRetry(uint32_t seq) const
+    {
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return seq_.load(std::memory_order_relaxed) != seq;
+    }
+
+    void BeginWrite()
+    {
+        seq_.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+    }
+
+    void EndWrite()
+    {
+        seq_.fetch_add(1, std::memory_order_release);
+    }
+
+private:
+    std::atomic<uint32_t> seq_ {0};
+};
+
+class SeqWriteGuard {
+public:
+    explicit SeqWriteGuard(SeqCounter &counter) : counter_(counter)
+    {
+        counter_.BeginWrite();
+    }
+
+    ~SeqWriteGuard()
+    {
+        counter_.EndWrite();
+    }
+
+    SeqWriteGuard(const SeqWriteGuard &) = delete;
+    SeqWriteGuard &operator=(const SeqWriteGuard &) = delete;
+
+private:
+    SeqCounter &counter_;
+};
+}  // namespace BackgroundTaskMgr
+}  // namespace OHOS
+#endif  // FOUNDATION_RESOURCESCHEDULE_BACKGROUND_TASK_MGR_SERVICES_TRANSIENT_TASK_INCLUDE_SEQ_COUNTER_H
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Copyright (c) 2022-2026 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -18,23 +18,55 @@
 
 #include <event_handler.h>
 #include <event_runner.h>
+#include <mutex>
 #include <refbase.h>
+#include <vector>
+
+#include "timing_wheel.h"
 
 namespace OHOS {
 namespace BackgroundTaskMgr {
 class BackgroundTaskMgrService;
 
+enum class TimerType : uint32_t {
+    EXPIRY = 0,
+    WATCHDOG,
+};
+
+struct TimerStats {
+    uint32_t expiryCount {0};
+    uint32_t watchdogCount {0};
+    uint64_t firedCount {0};
+    uint64_t tickCount {0};
+    int64_t lastLatenessMs {0};
+    int64_t maxLatenessMs {0};
+};
+
+/**
+ * Expiry and watchdog timers of transient tasks. All timers live in one timing wheel driven by a single tick event
+ * on the runner, which is only rescheduled when the next wakeup moves earlier. Timers expired in one tick are
+ * dispatched as a batch.
+ */
 class TimerManager : public AppExecFwk::EventHandler {
 public:
     explicit TimerManager(const wptr<BackgroundTaskMgrService>& service,
         const std::shared_ptr<AppExecFwk::EventRunner>& runner);
     ~TimerManager() override = default;
-    bool AddTimer(int32_t requestId, int32_t interval);
-    void RemoveTimer(int32_t requestId);
+    bool AddTimer(int32_t requestId, int32_t interval, TimerType type = TimerType::EXPIRY);
+    void RemoveTimer(int32_t requestId, TimerType type = TimerType::EXPIRY);
+    TimerStats GetTimerStats();
     void ProcessEvent(const AppExecFwk::InnerEvent::Pointer& event) override;
 
 private:
+    void CountTimerLocked(uint64_t key, bool armed);
+    void ScheduleTickLocked(int64_t nowMs);
+    void DispatchExpiredTimers(const std::vector<ExpiredTimer> &expired);
+
     wptr<BackgroundTaskMgrService> service_;
+    std::mutex timerMutex_;
+    TimingWheel timingWheel_;
+    int64_t scheduledWakeupMs_ {-1};
+    TimerStats stats_ {};
 };
 }  // namespace BackgroundTaskMgr
 }  // namespace OHOS
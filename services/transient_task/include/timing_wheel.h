@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FOUNDATION_RESOURCESCHEDULE_BACKGROUND_TASK_MGR_SERVICES_TRANSIENT_TASK_INCLUDE_TIMING_WHEEL_H
+#define FOUNDATION_RESOURCESCHEDULE_BACKGROUND_TASK_MGR_SERVICES_TRANSIENT_TASK_INCLUDE_TIMING_WHEEL_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+namespace OHOS {
+namespace BackgroundTaskMgr {
+struct ExpiredTimer {
+    uint64_t key {0};
+    int64_t expireMs {0};
+};
+
+/**
+ * Hierarchical timing wheel. Level 0 has one slot per tick, every higher level has one slot per full turn of the
+ * level below, and the slots of a higher level are cascaded down when the lower level wraps. Arm, cancel and re-arm
+ * are O(1). A timer fires on the first tick at or after its deadline. Not thread safe.
+ */
+class TimingWheel {
+public:
+    TimingWheel(int64_t tickMs, int64_t startMs);
+
+    /**
+     * @brief Arm a timer, an armed timer with the same key is re-armed.
+     */
+    void Arm(uint64_t key, int64_t expireMs);
+
+    bool Cancel(uint64_t key);
+
+    bool IsArmed(uint64_t key) const;
+
+    size_t Size() const;
+
+    /**
+     * @brief Advance the wheel to the time and append the timers expired on the way, in tick order.
+     */
+    void Advance(int64_t nowMs, std::vector<ExpiredTimer> &expired);
+
+    /**
+     * @brief Get the time of the next tick that fires or cascades timers.
+     *
+     * @return -1 if no timer is armed.
+     */
+    int64_t GetNextWakeupMs() const;
+
+private:
+    static constexpr uint32_t SLOT_BITS = 6;
+    static constexpr uint32_t SLOT_COUNT = 1u << SLOT_BITS;
+    static constexpr uint32_t SLOT_MASK = SLOT_COUNT - 1;
+    static constexpr uint32_t LEVEL_COUNT = 4;
+
+    struct TimerEntry {
+        int64_t expireMs {0};
+        uint64_t expireTick {0};
+        uint32_t level {0};
+        uint32_t slot {0};
+        std::list<uint64_t>::iterator pos {};
+    };
+
+    uint64_t ToTick(int64_t timeMs, bool roundUp) const;
+    void Place(uint64_t key, TimerEntry &entry);
+    void Unlink(const TimerEntry &entry);
+    void Cascade(uint32_t level);
+    void Expire(std::vector<ExpiredTimer> &expired);
+
+    int64_t tickMs_ {1};
+    int64_t startMs_ {0};
+    uint64_t currentTick_ {0};
+    std::array<std::array<std::list<uint64_t>, SLOT_COUNT>, LEVEL_COUNT> slots_ {};
+    std::array<uint64_t, LEVEL_COUNT> occupied_ {};
+    std::unordered_map<uint64_t, TimerEntry> entries_ {};
+};
+}  // namespace BackgroundTaskMgr
+}  // namespace OHOS
+#endif  // FOUNDATION_RESOURCESCHEDULE_BACKGROUND_TASK_MGR_SERVICES_TRANSIENT_TASK_INCLUDE_TIMING_WHEEL_H
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Copyright (c) 2022-2026 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -16,33 +16,22 @@
 #ifndef FOUNDATION_RESOURCESCHEDULE_BACKGROUND_TASK_MGR_SERVICES_TRANSIENT_TASK_INCLUDE_WATCHDOG_H
 #define FOUNDATION_RESOURCESCHEDULE_BACKGROUND_TASK_MGR_SERVICES_TRANSIENT_TASK_INCLUDE_WATCHDOG_H
 
-#include <event_handler.h>
-#include <event_runner.h>
-#include <refbase.h>
+#include <memory>
 
-#include "appmgr/app_mgr_client.h"
-
-#include "decision_maker.h"
 #include "key_info.h"
+#include "timer_manager.h"
 
 namespace OHOS {
 namespace BackgroundTaskMgr {
-class BackgroundTaskMgrService;
-
-class Watchdog : public AppExecFwk::EventHandler {
+class Watchdog {
 public:
-    Watchdog(const wptr<BackgroundTaskMgrService>& service, const std::shared_ptr<DecisionMaker>& decision,
-        const std::shared_ptr<AppExecFwk::EventRunner>& runner);
-    ~Watchdog() override = default;
+    explicit Watchdog(const std::shared_ptr<TimerManager>& timerManager);
+    ~Watchdog() = default;
     bool AddWatchdog(int32_t requestId, const std::shared_ptr<KeyInfo>& info, int32_t interval);
     void RemoveWatchdog(int32_t requestId);
-    void ProcessEvent(const AppExecFwk::InnerEvent::Pointer& event) override;
 
 private:
-
-    wptr<BackgroundTaskMgrService> service_;
-    std::unique_ptr<AppExecFwk::AppMgrClient> appMgrClient_;
-    std::shared_ptr<DecisionMaker> decision_ {nullptr};
+    std::shared_ptr<TimerManager> timerManager_ {nullptr};
 };
 }  // namespace BackgroundTaskMgr
 }  // namespace OHOS
@@ -32,6 +32,7 @@
 
 #include "background_task_mgr_service.h"
 #include "bgtask_hitrace_chain.h"
+#include "bundle_info_cache.h"
 #include "bgtaskmgr_inner_errors.h"
 #include "time_provider.h"
 #include "transient_task_log.h"
@@ -59,6 +60,14 @@ const std::set<std::string> SUSPEND_NATIVE_OPERATE_CALLER = {
     "resource_schedule_service",
     "hidumper_service",
 };
+
+const std::map<TransientTaskEventType, IBackgroundTaskSubscriberIpcCode> SUBSCRIBER_IPC_CODES = {
+    {TransientTaskEventType::TASK_START, IBackgroundTaskSubscriberIpcCode::COMMAND_ON_TRANSIENT_TASK_START},
+    {TransientTaskEventType::TASK_END, IBackgroundTaskSubscriberIpcCode::COMMAND_ON_TRANSIENT_TASK_END},
+    {TransientTaskEventType::TASK_ERR, IBackgroundTaskSubscriberIpcCode::COMMAND_ON_TRANSIENT_TASK_ERR},
+    {TransientTaskEventType::APP_TASK_START, IBackgroundTaskSubscriberIpcCode::COMMAND_ON_APP_TRANSIENT_TASK_START},
+    {TransientTaskEventType::APP_TASK_END, IBackgroundTaskSubscriberIpcCode::COMMAND_ON_APP_TRANSIENT_TASK_END},
+};
 }
 
 #ifdef BGTASK_MGR_UNIT_TEST
@@ -108,8 +117,7 @@ void BgTransientTaskMgr::InitNecessaryState(const std::shared_ptr<AppExecFwk::Ev
     deviceInfoManeger_ = make_shared<DeviceInfoManager>();
     timerManager_ = make_shared<TimerManager>(DelayedSingleton<BackgroundTaskMgrService>::GetInstance().get(), runner);
     decisionMaker_ = make_shared<DecisionMaker>(timerManager_, deviceInfoManeger_);
-    watchdog_ = make_shared<Watchdog>(DelayedSingleton<BackgroundTaskMgrService>::GetInstance().get(),
-        decisionMaker_, runner);
+    watchdog_ = make_shared<Watchdog>(timerManager_);
 
     inputManager_ = make_shared<InputManager>(runner);
     if (inputManager_ == nullptr) {
@@ -126,29 +134,8 @@ void BgTransientTaskMgr::InitNecessaryState(const std::shared_ptr<AppExecFwk::Ev
 
 bool BgTransientTaskMgr::GetBundleNamesForUid(int32_t uid, std::string &bundleName)
 {
-    sptr<ISystemAbilityManager> systemMgr = SystemAbilityManagerClient::GetInstance().GetSystemAbilityManager();
-    if (systemMgr == nullptr) {
-        BGTASK_LOGE("Fail to get system ability mgr");
-        return false;
-    }
-
-    sptr<IRemoteObject> remoteObject = systemMgr->GetSystemAbility(BUNDLE_MGR_SERVICE_SYS_ABILITY_ID);
-    if (remoteObject == nullptr) {
-        BGTASK_LOGE("Fail to get bundle manager proxy");
-        return false;
-    }
-
-    sptr<OHOS::AppExecFwk::IBundleMgr> bundleMgrProxy = iface_cast<OHOS::AppExecFwk::IBundleMgr>(remoteObject);
-    if (bundleMgrProxy == nullptr) {
-        BGTASK_LOGE("Bundle mgr proxy is nullptr");
-        return false;
-    }
-
-    if (bundleMgrProxy->GetNameForUid(uid, bundleName) != ERR_OK) {
-        BGTASK_LOGE("Get bundle name failed");
-        return false;
-    }
-    return true;
+    // 命中缓存时不访问包管理服务，缓存随包变更事件和包管理服务死亡失效
+    return DelayedSingleton<BundleInfoCache>::GetInstance()->GetBundleNameForUid(uid, bundleName);
 }
 
 ErrCode BgTransientTaskMgr::IsCallingInfoLegal(int32_t uid, int32_t pid, std::string &name,
@@ -221,7 +208,10 @@ ErrCode BgTransientTaskMgr::RequestSuspendDelay(const std::u16string& reason,
     BGTASK_LOGI("request suspend success, pkg : %{public}s, uid : %{public}d, pid : %{public}d, requestId: %{public}d,"
         "delayTime: %{public}d", name.c_str(), uid, pid, infoEx->GetRequestId(), infoEx->GetActualDelayTime());
     expiredCallbackMap_[infoEx->GetRequestId()] = callback;
-    keyInfoMap_[infoEx->GetRequestId()] = keyInfo;
+    {
+        lock_guard<mutex> keyInfoLock(keyInfoLock_);
+        keyInfoMap_[infoEx->GetRequestId()] = keyInfo;
+    }
     if (callbackDeathRecipient_ != nullptr) {
         (void)remote->AddDeathRecipient(callbackDeathRecipient_);
     }
@@ -325,43 +315,67 @@ void BgTransientTaskMgr::NotifyTransientTaskSuscriber(const shared_ptr<Transient
         BGTASK_LOGE("NotifyTransientTaskSuscriber failed, appInfo is null.");
         return;
     }
-    const TransientTaskAppInfo& appInfoRef = *appInfo;
     switch (type) {
         case TransientTaskEventType::TASK_START:
             BackgroundTaskObserver::GetInstance().OnTransientTaskStart(appInfo);
-            for (auto iter = subscriberList_.begin(); iter != subscriberList_.end(); iter++) {
-                (*iter)->OnTransientTaskStart(appInfoRef);
-            }
             break;
         case TransientTaskEventType::TASK_END:
             BackgroundTaskObserver::GetInstance().OnTransientTaskEnd(appInfo);
-            for (auto iter = subscriberList_.begin(); iter != subscriberList_.end(); iter++) {
-                (*iter)->OnTransientTaskEnd(appInfoRef);
-            }
             break;
         case TransientTaskEventType::TASK_ERR:
             BackgroundTaskObserver::GetInstance().OnTransientTaskErr(appInfo);
-            for (auto iter = subscriberList_.begin(); iter != subscriberList_.end(); iter++) {
-                (*iter)->OnTransientTaskErr(appInfoRef);
-            }
             break;
         case TransientTaskEventType::APP_TASK_START:
             BackgroundTaskObserver::GetInstance().OnAppTransientTaskStart(appInfo);
-            for (auto iter = subscriberList_.begin(); iter != subscriberList_.end(); iter++) {
-                (*iter)->OnAppTransientTaskStart(appInfoRef);
-            }
             break;
         case TransientTaskEventType::APP_TASK_END:
             BackgroundTaskObserver::GetInstance().OnAppTransientTaskEnd(appInfo);
-            for (auto iter = subscriberList_.begin(); iter != subscriberList_.end(); iter++) {
-                (*iter)->OnAppTransientTaskEnd(appInfoRef);
-            }
             break;
         default:
-            break;
+            return;
+    }
+    auto parcel = make_shared<SubscriberEventParcel>(appInfo);
+    for (auto iter = subscriberList_.begin(); iter != subscriberList_.end(); iter++) {
+        DispatchToSubscriber(*iter, appInfo, type, parcel);
     }
 }
 
+void BgTransientTaskMgr::DispatchToSubscriber(const sptr<IBackgroundTaskSubscriber>& subscriber,
+    const shared_ptr<TransientTaskAppInfo>& appInfo, const TransientTaskEventType type,
+    const shared_ptr<SubscriberEventParcel>& parcel)
+{
+    SubscriberEvent event;
+    event.eventType = static_cast<uint32_t>(type);
+    event.delivery = [subscriber, appInfo, parcel](uint32_t eventType) {
+        auto type = static_cast<TransientTaskEventType>(eventType);
+        auto codeIter = SUBSCRIBER_IPC_CODES.find(type);
+        if (codeIter != SUBSCRIBER_IPC_CODES.end() && parcel->SendRequest(subscriber->AsObject(), codeIter->second)) {
+            return;
+        }
+        switch (type) {
+            case TransientTaskEventType::TASK_START:
+                subscriber->OnTransientTaskStart(*appInfo);
+                break;
+            case TransientTaskEventType::TASK_END:
+                subscriber->OnTransientTaskEnd(*appInfo);
+                break;
+            case TransientTaskEventType::TASK_ERR:
+                subscriber->OnTransientTaskErr(*appInfo);
+                break;
+            case TransientTaskEventType::APP_TASK_START:
+                subscriber->OnAppTransientTaskStart(*appInfo);
+                break;
+            case TransientTaskEventType::APP_TASK_END:
+                subscriber->OnAppTransientTaskEnd(*appInfo);
+                break;
+            default:
+                break;
+        }
+    };
+    event.resync = [subscriber]() { subscriber->OnConnected(); };
+    subscriberDispatcher_->Dispatch(SubscriberSource::TRANSIENT_TASK, subscriber->AsObject(), std::move(event));
+}
+
 ErrCode BgTransientTaskMgr::CancelSuspendDelay(int32_t requestId)
 {
     HitraceScoped traceScoped(HITRACE_TAG_OHOS,
@@ -398,8 +412,12 @@ ErrCode BgTransientTaskMgr::CancelSuspendDelay(int32_t requestId)
 ErrCode BgTransientTaskMgr::CancelSuspendDelayLocked(int32_t requestId)
 {
     watchdog_->RemoveWatchdog(requestId);
-    decisionMaker_->RemoveRequest(keyInfoMap_[requestId], requestId);
-    keyInfoMap_.erase(requestId);
+    auto keyInfoIter = keyInfoMap_.find(requestId);
+    decisionMaker_->RemoveRequest(keyInfoIter == keyInfoMap_.end() ? nullptr : keyInfoIter->second, requestId);
+    {
+        lock_guard<mutex> keyInfoLock(keyInfoLock_);
+        keyInfoMap_.erase(requestId);
+    }
 
     auto iter = expiredCallbackMap_.find(requestId);
     if (iter == expiredCallbackMap_.end()) {
@@ -452,14 +470,19 @@ ErrCode BgTransientTaskMgr::GetRemainingDelayTime(int32_t requestId, int32_t &de
     BGTASK_LOGI("get remain time pkg : %{public}s, uid : %{public}d, requestId : %{public}d",
         name.c_str(), uid, requestId);
 
-    lock_guard<mutex> lock(expiredCallbackLock_);
-    if (!VerifyRequestIdLocked(name, uid, requestId)) {
-        BGTASK_LOGE("get remain time failed, requestId is illegal.");
-        delayTime = BG_INVALID_REMAIN_TIME;
-        return ERR_BGTASK_INVALID_REQUEST_ID;
+    std::shared_ptr<KeyInfo> keyInfo = nullptr;
+    {
+        // 仅持有keyInfoLock_，查询剩余时间不等待申请和取消流程
+        lock_guard<mutex> lock(keyInfoLock_);
+        if (!VerifyRequestIdLocked(name, uid, requestId)) {
+            BGTASK_LOGE("get remain time failed, requestId is illegal.");
+            delayTime = BG_INVALID_REMAIN_TIME;
+            return ERR_BGTASK_INVALID_REQUEST_ID;
+        }
+        keyInfo = keyInfoMap_.find(requestId)->second;
     }
 
-    delayTime = decisionMaker_->GetRemainingDelayTime(keyInfoMap_[requestId], requestId);
+    delayTime = decisionMaker_->GetRemainingDelayTime(keyInfo, requestId);
     return ERR_OK;
 }
 
@@ -485,18 +508,20 @@ ErrCode BgTransientTaskMgr::GetAllTransientTasks(int32_t &remainingQuota,
     }
     auto keyInfo = std::make_shared<KeyInfo>(name, uid, pid);
     remainingQuota = decisionMaker_->GetQuota(keyInfo);
-    lock_guard<mutex> lock(expiredCallbackLock_);
-    if (keyInfoMap_.empty()) {
-        BGTASK_LOGD("not have transient task, pkg : %{public}s, uid : %{public}d", name.c_str(), uid);
-        return ERR_OK;
-    }
-    for (const auto &record : keyInfoMap_) {
-        if (!record.second) {
-            continue;
+    std::vector<std::pair<int32_t, std::shared_ptr<KeyInfo>>> records;
+    {
+        lock_guard<mutex> lock(keyInfoLock_);
+        if (keyInfoMap_.empty()) {
+            BGTASK_LOGD("not have transient task, pkg : %{public}s, uid : %{public}d", name.c_str(), uid);
+            return ERR_OK;
         }
-        if (record.second->GetPkg() != name || record.second->GetUid() != uid) {
-            continue;
+        for (const auto &record : keyInfoMap_) {
+            if (record.second && record.second->IsEqual(name, uid)) {
+                records.emplace_back(record);
+            }
         }
+    }
+    for (const auto &record : records) {
         auto info = std::make_shared<DelaySuspendInfo>();
         info->SetRequestId(record.first);
         info->SetActualDelayTime(decisionMaker_->GetRemainingDelayTime(record.second, record.first));
@@ -549,6 +574,7 @@ void BgTransientTaskMgr::HandleExpiredCallbackDeath(const wptr<IRemoteObject>& r
     BGTASK_LOGI("expiredCallback death, %{public}s, requestId : %{public}d", keyInfoIter->second->ToString().c_str(),
         keyInfoIter->first);
     decisionMaker_->RemoveRequest(keyInfoIter->second, keyInfoIter->first);
+    lock_guard<mutex> keyInfoLock(keyInfoLock_);
     keyInfoMap_.erase(keyInfoIter);
 }
 
@@ -560,15 +586,14 @@ void BgTransientTaskMgr::HandleSubscriberDeath(const wptr<IRemoteObject>& remote
     }
 
     handler_->PostSyncTask([&]() {
-        auto findSuscriber = [&remote](const auto& subscriberList) {
-            return remote == subscriberList->AsObject();
-        };
-        auto subscriberIter = find_if(subscriberList_.begin(), subscriberList_.end(), findSuscriber);
+        sptr<IRemoteObject> proxy = remote.promote();
+        auto subscriberIter = subscriberList_.find(proxy);
         if (subscriberIter == subscriberList_.end()) {
             BGTASK_LOGE("suscriber death, remote in suscriber not found.");
             return;
         }
 
+        subscriberDispatcher_->RemoveSubscriber(SubscriberSource::TRANSIENT_TASK, proxy);
         subscriberList_.erase(subscriberIter);
         BGTASK_LOGI("suscriber death, remove it.");
     });
@@ -606,12 +631,8 @@ ErrCode BgTransientTaskMgr::SubscribeBackgroundTask(const sptr<IBackgroundTaskSu
         return ERR_BGTASK_INVALID_PARAM;
     }
 
-    handler_->PostSyncTask([=]() {
-        auto findSuscriber = [&remote](const auto& subscriberList) {
-            return remote == subscriberList->AsObject();
-        };
-        auto subscriberIter = find_if(subscriberList_.begin(), subscriberList_.end(), findSuscriber);
-        if (subscriberIter != subscriberList_.end()) {
+    laneScheduler_->PostSyncTask(handler_, EventLane::IPC, [=]() {
+        if (subscriberList_.find(remote) != subscriberList_.end()) {
             BGTASK_LOGE("request subscriber is already exists.");
             return;
         }
@@ -637,17 +658,13 @@ ErrCode BgTransientTaskMgr::UnsubscribeBackgroundTask(const sptr<IBackgroundTask
         return ERR_BGTASK_INVALID_PARAM;
     }
 
-    handler_->PostSyncTask([=]() {
-        auto findSuscriber = [&remote](const auto& subscriberList) {
-            return remote == subscriberList->AsObject();
-        };
-        auto subscriberIter = find_if(subscriberList_.begin(), subscriberList_.end(), findSuscriber);
-        if (subscriberIter == subscriberList_.end()) {
+    laneScheduler_->PostSyncTask(handler_, EventLane::IPC, [=]() {
+        if (subscriberList_.erase(remote) == 0) {
             BGTASK_LOGE("request subscriber is not exists.");
             return;
         }
         remote->RemoveDeathRecipient(susriberDeathRecipient_);
-        subscriberList_.erase(subscriberIter);
+        subscriberDispatcher_->RemoveSubscriber(SubscriberSource::TRANSIENT_TASK, remote);
         BGTASK_LOGI("unsubscribe transient task success.");
     });
     return ERR_OK;
@@ -655,7 +672,7 @@ ErrCode BgTransientTaskMgr::UnsubscribeBackgroundTask(const sptr<IBackgroundTask
 
 ErrCode BgTransientTaskMgr::GetTransientTaskApps(std::vector<std::shared_ptr<TransientTaskAppInfo>> &list)
 {
-    lock_guard<mutex> lock(expiredCallbackLock_);
+    lock_guard<mutex> lock(keyInfoLock_);
     if (keyInfoMap_.empty()) {
         return ERR_OK;
     }
@@ -839,6 +856,17 @@ bool BgTransientTaskMgr::DumpAllRequestId(std::vector<std::string> &dumpInfo)
         stream << "\n";
         dumpInfo.push_back(stream.str());
     }
+    if (timerManager_ != nullptr) {
+        TimerStats stats = timerManager_->GetTimerStats();
+        stream.clear();
+        stream.str("");
+        stream << "TimerStats:\n";
+        stream << "\tExpiryTimers: " << stats.expiryCount << "\n";
+        stream << "\tWatchdogTimers: " << stats.watchdogCount << "\n";
+        stream << "\tFired: " << stats.firedCount << ", Ticks: " << stats.tickCount << "\n";
+        stream << "\tLateness(ms): last " << stats.lastLatenessMs << ", max " << stats.maxLatenessMs << "\n";
+        dumpInfo.push_back(stream.str());
+    }
 
     return true;
 }
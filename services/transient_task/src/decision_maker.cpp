@@ -26,7 +26,7 @@
 #include "hisysevent.h"
 #include "data_storage_helper.h"
 #include "bgtask_config.h"
-#include "app_mgr_helper.h"
+#include "foreground_app_tracker.h"
 
 using namespace std;
 
@@ -51,7 +51,6 @@ void DecisionMaker::OnProcessStateChanged(const AppExecFwk::ProcessData &process
     bool isBackground = processData.state == AppExecFwk::AppProcessState::APP_STATE_BACKGROUND;
     BGTASK_LOGI("pid: %{public}d, OnProcessState: %{public}d, isForeground: %{public}d, isBackground: %{public}d",
         processData.pid, processData.state, isForeground, isBackground);
-    UpdateForegroundUidPidMap(processData.uid, processData.pid, isForeground);
     if (isForeground || isBackground) {
         HandleStateChange(processData.bundleName, processData.uid, isForeground, isBackground);
     }
@@ -59,7 +58,6 @@ void DecisionMaker::OnProcessStateChanged(const AppExecFwk::ProcessData &process
 
 void DecisionMaker::OnProcessDied(const AppExecFwk::ProcessData &processData)
 {
-    UpdateForegroundUidPidMap(processData.uid, processData.pid, false);
     if (TryStartAccounting(processData.uid, processData.bundleName) == ERR_OK) {
         BGTASK_LOGI("%{public}s_%{public}d start accounting because pid:%{public}d died",
             processData.bundleName.c_str(), processData.uid, processData.pid);
@@ -69,8 +67,7 @@ void DecisionMaker::OnProcessDied(const AppExecFwk::ProcessData &processData)
 ErrCode DecisionMaker::TryStartAccounting(int32_t uid, const std::string &bundleName)
 {
     lock_guard<mutex> lock(lock_);
-    auto key = std::make_shared<KeyInfo>(bundleName, uid);
-    auto it = pkgDelaySuspendInfoMap_.find(key);
+    auto it = pkgDelaySuspendInfoMap_.find(bundleName, uid);
     if (it == pkgDelaySuspendInfoMap_.end()) {
         BGTASK_LOGD("pkgname: %{public}s, uid: %{public}d not request transient task.", bundleName.c_str(), uid);
         return ERR_BGTASK_NOREQUEST_TASK;
@@ -85,46 +82,29 @@ ErrCode DecisionMaker::TryStartAccounting(int32_t uid, const std::string &bundle
     }
 }
 
-void DecisionMaker::UpdateForegroundUidPidMap(int32_t uid, int32_t pid, bool isForeground)
-{
-    lock_guard<recursive_mutex> lock(recMutex_);
-    set<int32_t>& pids = foregroundUidPidMap_[uid];
-    if (isForeground) {
-        pids.insert(pid);
-    } else {
-        pids.erase(pid);
-        if (pids.empty()) {
-            foregroundUidPidMap_.erase(uid);
-        }
-    }
-}
-
 bool DecisionMaker::IsUidForeground(int32_t uid)
 {
-    lock_guard<recursive_mutex> lock(recMutex_);
-    return foregroundUidPidMap_.count(uid) != 0;
+    return DelayedSingleton<ForegroundAppTracker>::GetInstance()->IsUidForeground(uid);
 }
 
 void DecisionMaker::HandleStateChange(
     const std::string &bundleName, int32_t uid, bool isForeground, bool isBackground)
 {
     lock_guard<mutex> lock(lock_);
-    auto key = std::make_shared<KeyInfo>(bundleName, uid);
-
     if (isForeground) {
-        auto it = pkgDelaySuspendInfoMap_.find(key);
+        auto it = pkgDelaySuspendInfoMap_.find(bundleName, uid);
         if (it != pkgDelaySuspendInfoMap_.end()) {
             auto pkgInfo = it->second;
             BGTASK_LOGI("pkgname: %{public}s, uid: %{public}d is foreground, stop accounting",
                 bundleName.c_str(), uid);
             pkgInfo->StopAccountingAll();
         }
-        auto itBg = pkgBgDurationMap_.find(key);
+        auto itBg = pkgBgDurationMap_.find(bundleName, uid);
         if (itBg != pkgBgDurationMap_.end()) {
             pkgBgDurationMap_.erase(itBg);
         }
     } else if (isBackground) {
-        auto it = pkgDelaySuspendInfoMap_.find(key);
+        auto it = pkgDelaySuspendInfoMap_.find(bundleName, uid);
         if (it == pkgDelaySuspendInfoMap_.end()) {
             BGTASK_LOGI("pkgname: %{public}s, uid: %{public}d is not in delay suspend list",
                 bundleName.c_str(), uid);
@@ -135,7 +115,12 @@ void DecisionMaker::HandleStateChange(
             BGTASK_LOGI("pkgname: %{public}s, uid: %{public}d is background, start accounting",
                 bundleName.c_str(), uid);
             pkgInfo->StartAccounting();
-            pkgBgDurationMap_[key] = TimeProvider::GetCurrentTime();
+            auto itBg = pkgBgDurationMap_.find(bundleName, uid);
+            if (itBg != pkgBgDurationMap_.end()) {
+                itBg->second = TimeProvider::GetCurrentTime();
+            } else {
+                pkgBgDurationMap_[std::make_shared<KeyInfo>(bundleName, uid)] = TimeProvider::GetCurrentTime();
+            }
         }
     }
 }
@@ -196,11 +181,13 @@ ErrCode DecisionMaker::Decide(const std::shared_ptr<KeyInfo>& key, const std::sh
     }
     const string &name = key->GetPkg();
     int32_t uid = key->GetUid();
-    auto findInfoIt = pkgDelaySuspendInfoMap_.find(key);
+    auto findInfoIt = pkgDelaySuspendInfoMap_.find(name, uid);
     if (findInfoIt == pkgDelaySuspendInfoMap_.end()) {
+        lock_guard<mutex> mapLock(pkgMapLock_);
         pkgDelaySuspendInfoMap_[key] = make_shared<PkgDelaySuspendInfo>(name, uid, timerManager_);
+        findInfoIt = pkgDelaySuspendInfoMap_.find(name, uid);
     }
-    auto pkgInfo = pkgDelaySuspendInfoMap_[key];
+    auto pkgInfo = findInfoIt->second;
     bool needSetTime = false;
     ErrCode ret = CheckQuotaTime(pkgInfo, name, uid, key, needSetTime);
     if (ret != ERR_OK) {
@@ -234,8 +221,7 @@ ErrCode DecisionMaker::PauseTransientTaskTimeForInner(int32_t uid, const std::st
         return ERR_BGTASK_FOREGROUND;
     }
     lock_guard<mutex> lock(lock_);
-    auto key = std::make_shared<KeyInfo>(name, uid);
-    auto it = pkgDelaySuspendInfoMap_.find(key);
+    auto it = pkgDelaySuspendInfoMap_.find(name, uid);
     if (it == pkgDelaySuspendInfoMap_.end()) {
         BGTASK_LOGE("pkgname: %{public}s, uid: %{public}d not request transient task.", name.c_str(), uid);
         return ERR_BGTASK_NOREQUEST_TASK;
@@ -287,17 +273,22 @@ void DecisionMaker::RemoveRequest(const std::shared_ptr<KeyInfo>& key, const int
     }
 }
 
+std::shared_ptr<PkgDelaySuspendInfo> DecisionMaker::FindPkgInfo(const std::string &pkg, int32_t uid)
+{
+    lock_guard<mutex> lock(pkgMapLock_);
+    auto it = pkgDelaySuspendInfoMap_.find(pkg, uid);
+    return it == pkgDelaySuspendInfoMap_.end() ? nullptr : it->second;
+}
+
 int32_t DecisionMaker::GetRemainingDelayTime(const std::shared_ptr<KeyInfo>& key, const int32_t requestId)
 {
-    lock_guard<mutex> lock(lock_);
     if (key == nullptr) {
         BGTASK_LOGE("GetRemainingDelayTime, key is null.");
         return -1;
     }
 
-    auto it = pkgDelaySuspendInfoMap_.find(key);
-    if (it != pkgDelaySuspendInfoMap_.end()) {
-        auto pkgInfo = it->second;
+    auto pkgInfo = FindPkgInfo(key->GetPkg(), key->GetUid());
+    if (pkgInfo != nullptr) {
         return pkgInfo->GetRemainDelayTime(requestId);
     }
     return -1;
@@ -305,15 +296,13 @@ int32_t DecisionMaker::GetRemainingDelayTime(const std::shared_ptr<KeyInfo>& key
 
 vector<int32_t> DecisionMaker::GetRequestIdListByKey(const std::shared_ptr<KeyInfo>& key)
 {
-    lock_guard<mutex> lock(lock_);
     vector<int32_t> requestIdList;
     if (key == nullptr) {
         BGTASK_LOGE("GetRequestListByKey, key is null.");
         return requestIdList;
     }
-    auto it = pkgDelaySuspendInfoMap_.find(key);
-    if (it != pkgDelaySuspendInfoMap_.end()) {
-        auto pkgInfo = it->second;
+    auto pkgInfo = FindPkgInfo(key->GetPkg(), key->GetUid());
+    if (pkgInfo != nullptr) {
         for (const auto &task : pkgInfo->GetRequestList()) {
             requestIdList.emplace_back(task->GetRequestId());
         }
@@ -326,35 +315,22 @@ vector<int32_t> DecisionMaker::GetRequestIdListByKey(const std::shared_ptr<KeyIn
 
 int32_t DecisionMaker::GetQuota(const std::shared_ptr<KeyInfo>& key)
 {
-    lock_guard<mutex> lock(lock_);
     if (key == nullptr) {
         BGTASK_LOGE("GetQuota, key is null.");
         return -1;
     }
 
-    auto it = pkgDelaySuspendInfoMap_.find(key);
-    if (it != pkgDelaySuspendInfoMap_.end()) {
-        auto pkgInfo = it->second;
-        pkgInfo->UpdateQuota();
-        return pkgInfo->GetQuota();
+    auto pkgInfo = FindPkgInfo(key->GetPkg(), key->GetUid());
+    if (pkgInfo != nullptr) {
+        return pkgInfo->GetRemainQuota();
     }
     return INIT_QUOTA;
 }
 
 bool DecisionMaker::IsFrontApp(const string& pkgName, int32_t uid)
 {
-    lock_guard<mutex> lock(lock_);
-    vector<AppExecFwk::AppStateData> fgAppList;
-    if (!AppMgrHelper::GetInstance()->GetForegroundApplications(fgAppList)) {
-        BGTASK_LOGE("GetForegroundApplications failed");
-        return false;
-    }
-    for (auto fgApp : fgAppList) {
-        if (fgApp.bundleName == pkgName && fgApp.uid == uid) {
-            return true;
-        }
-    }
-    return false;
+    // uid 已唯一确定应用，无需再比较包名
+    return IsUidForeground(uid);
 }
 
 bool DecisionMaker::CanStartAccountingLocked(const std::shared_ptr<PkgDelaySuspendInfo>& pkgInfo)
@@ -391,6 +367,7 @@ void DecisionMaker::ResetDayQuotaLocked()
     for (auto iter = pkgDelaySuspendInfoMap_.begin(); iter != pkgDelaySuspendInfoMap_.end();) {
         auto pkgInfo = iter->second;
         if (pkgInfo->IsRequestEmpty()) {
+            lock_guard<mutex> mapLock(pkgMapLock_);
             iter = pkgDelaySuspendInfoMap_.erase(iter);
         } else {
             pkgInfo->UpdateQuota(true);
@@ -429,17 +406,10 @@ void DecisionMaker::OnInputEvent(const EventInfo& eventInfo)
 void DecisionMaker::HandleScreenOn()
 {
     lock_guard<mutex> lock(lock_);
-    vector<AppExecFwk::AppStateData> fgAppList;
-    if (!AppMgrHelper::GetInstance()->GetForegroundApplications(fgAppList)) {
-        BGTASK_LOGE("GetForegroundApplications failed");
-        return;
-    }
-    for (auto fgApp : fgAppList) {
-        auto key = std::make_shared<KeyInfo>(fgApp.bundleName, fgApp.uid);
-        auto it = pkgDelaySuspendInfoMap_.find(key);
-        if (it != pkgDelaySuspendInfoMap_.end()) {
-            auto pkgInfo = it->second;
-            BGTASK_LOGI("screen is on and uid: %{public}d is foreground app, stop accounting", fgApp.uid);
+    for (const auto &p : pkgDelaySuspendInfoMap_) {
+        auto pkgInfo = p.second;
+        if (IsUidForeground(pkgInfo->GetUid())) {
+            BGTASK_LOGI("screen is on and uid: %{public}d is foreground app, stop accounting", pkgInfo->GetUid());
             pkgInfo->StopAccountingAll();
         }
     }
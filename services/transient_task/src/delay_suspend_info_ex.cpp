@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Copyright (c) 2022-2026 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -27,9 +27,24 @@ DelaySuspendInfoEx::DelaySuspendInfoEx(const int32_t& pid, const int32_t& reques
     SetActualDelayTime(delaytime);
 }
 
+void DelaySuspendInfoEx::LoadTimes(int64_t &baseTime, int64_t &spendTime) const
+{
+    uint32_t seq = 0;
+    do {
+        seq = timeSeq_.ReadBegin();
+        baseTime = baseTime_.load(std::memory_order_relaxed);
+        spendTime = spendTime_.load(std::memory_order_relaxed);
+    } while (timeSeq_.ReadRetry(seq));
+}
+
 int32_t DelaySuspendInfoEx::GetRemainDelayTime()
 {
-    int64_t spendTime = (baseTime_ > 0) ? (spendTime_ + (TimeProvider::GetCurrentTime() - baseTime_)) : spendTime_;
+    int64_t baseTime = 0;
+    int64_t spendTime = 0;
+    LoadTimes(baseTime, spendTime);
+    if (baseTime > 0) {
+        spendTime += TimeProvider::GetCurrentTime() - baseTime;
+    }
     int32_t remainTime = GetActualDelayTime() - (int32_t)spendTime;
     BGTASK_LOGI("requestId %{public}d remainTime %{public}d", GetRequestId(), remainTime);
     return (remainTime < 0) ? 0 : remainTime;
@@ -43,16 +58,21 @@ int32_t DelaySuspendInfoEx::GetAdvanceCallbackTime()
 
 void DelaySuspendInfoEx::StartAccounting()
 {
-    if (baseTime_ == 0) {
-        baseTime_ = TimeProvider::GetCurrentTime();
+    if (baseTime_.load(std::memory_order_relaxed) == 0) {
+        SeqWriteGuard guard(timeSeq_);
+        baseTime_.store(TimeProvider::GetCurrentTime(), std::memory_order_relaxed);
     }
 }
 
 void DelaySuspendInfoEx::StopAccounting()
 {
-    if (baseTime_ != 0) {
-        spendTime_ += TimeProvider::GetCurrentTime() - baseTime_;
-        baseTime_ = 0;
+    int64_t baseTime = baseTime_.load(std::memory_order_relaxed);
+    if (baseTime != 0) {
+        // 耗时与起始时间需成组更新，避免无锁读取到重复计算或漏算的时长
+        SeqWriteGuard guard(timeSeq_);
+        spendTime_.store(spendTime_.load(std::memory_order_relaxed) + TimeProvider::GetCurrentTime() - baseTime,
+            std::memory_order_relaxed);
+        baseTime_.store(0, std::memory_order_relaxed);
     }
 }
 
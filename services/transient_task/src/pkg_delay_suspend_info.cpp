@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Copyright (c) 2022-2026 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -34,11 +34,12 @@ namespace {
 
 ErrCode PkgDelaySuspendInfo::IsAllowRequest()
 {
+    lock_guard<mutex> lock(infoLock_);
     if (requestList_.size() >= MAX_REQUEST_ID) {
         return ERR_BGTASK_EXCEEDS_THRESHOLD;
     }
 
-    UpdateQuota();
+    UpdateQuotaLocked();
     if (quota_ >= MIN_ALLOW_QUOTA_TIME) {
         return ERR_OK;
     }
@@ -49,30 +50,33 @@ ErrCode PkgDelaySuspendInfo::IsAllowRequest()
 void PkgDelaySuspendInfo::AddRequest(const shared_ptr<DelaySuspendInfoEx>& delayInfo,
     const int32_t delayTime, const bool needSetTime)
 {
+    lock_guard<mutex> lock(infoLock_);
     if (needSetTime) {
         int32_t exempted_quota = DelayedSingleton<BgtaskConfig>::GetInstance()->GetTransientTaskExemptedQuato();
         BGTASK_LOGI("pkgname: %{public}s, requestId: %{public}d exempted_quota %{public}d", pkg_.c_str(),
             delayInfo->GetRequestId(), exempted_quota);
         delayInfo->SetActualDelayTime(exempted_quota + WATCHDOG_DELAY_TIME);
     } else {
-        delayInfo->SetActualDelayTime((quota_ < delayTime) ? quota_ : delayTime);
+        int32_t quota = quota_.load(std::memory_order_relaxed);
+        delayInfo->SetActualDelayTime((quota < delayTime) ? quota : delayTime);
         BGTASK_LOGI("pkgname: %{public}s, requestId: %{public}d, quota_: %{public}d, delayTime: %{public}d",
-            pkg_.c_str(), delayInfo->GetRequestId(), quota_, delayTime);
+            pkg_.c_str(), delayInfo->GetRequestId(), quota, delayTime);
     }
     requestList_.push_back(delayInfo);
 }
 
 void PkgDelaySuspendInfo::RemoveRequest(const int32_t requestId)
 {
+    lock_guard<mutex> lock(infoLock_);
     for (auto iter = requestList_.begin(); iter != requestList_.end(); iter++) {
         if (!(*iter)->IsSameRequestId(requestId)) {
             continue;
         }
-        StopAccounting(requestId);
+        StopAccountingLocked(requestId);
         requestList_.erase(iter);
         if (requestList_.empty()) {
-            UpdateQuota();
-            isCounting_ = false;
+            UpdateQuotaLocked();
+            SetCountingLocked(false);
         }
         break;
     }
@@ -80,23 +84,30 @@ void PkgDelaySuspendInfo::RemoveRequest(const int32_t requestId)
 
 int32_t PkgDelaySuspendInfo::GetRemainDelayTime(const int32_t requestId)
 {
-    for (auto &info : requestList_) {
-        if (info->IsSameRequestId(requestId)) {
-            return info->GetRemainDelayTime();
+    shared_ptr<DelaySuspendInfoEx> delayInfo = nullptr;
+    {
+        lock_guard<mutex> lock(infoLock_);
+        for (auto &info : requestList_) {
+            if (info->IsSameRequestId(requestId)) {
+                delayInfo = info;
+                break;
+            }
         }
     }
-    return 0;
+    // 计时字段可无锁读取，查询剩余时间不阻塞本包的计时操作
+    return delayInfo == nullptr ? 0 : delayInfo->GetRemainDelayTime();
 }
 
 void PkgDelaySuspendInfo::StartAccounting(const int32_t requestId)
 {
+    lock_guard<mutex> lock(infoLock_);
     for (auto &info : requestList_) {
         if ((requestId != -1) && !info->IsSameRequestId(requestId)) {
             continue;
         }
         if (!isCounting_) {
-            UpdateQuota();
-            isCounting_ = true;
+            UpdateQuotaLocked();
+            SetCountingLocked(true);
         }
         if (info->GetBaseTime() == 0) {
             info->StartAccounting();
@@ -108,6 +119,12 @@ void PkgDelaySuspendInfo::StartAccounting(const int32_t requestId)
 }
 
 void PkgDelaySuspendInfo::StopAccounting(const int32_t requestId)
+{
+    lock_guard<mutex> lock(infoLock_);
+    StopAccountingLocked(requestId);
+}
+
+void PkgDelaySuspendInfo::StopAccountingLocked(const int32_t requestId)
 {
     for (auto &info : requestList_) {
         if (!info->IsSameRequestId(requestId) || (info->GetBaseTime() == 0)) {
@@ -123,6 +140,7 @@ void PkgDelaySuspendInfo::StopAccounting(const int32_t requestId)
 void PkgDelaySuspendInfo::StopAccountingAll()
 {
     BGTASK_LOGD("StopAccountingAll %{public}s", pkg_.c_str());
+    lock_guard<mutex> lock(infoLock_);
     for (auto &info : requestList_) {
         if (info->GetBaseTime() == 0) {
             continue;
@@ -132,26 +150,62 @@ void PkgDelaySuspendInfo::StopAccountingAll()
         BGTASK_LOGD("StopAccountingAll pkgname: %{public}s, requestId: %{public}d, pid: %{public}d",
             pkg_.c_str(), info->GetRequestId(), info->GetPid());
     }
-    UpdateQuota();
-    isCounting_ = false;
+    UpdateQuotaLocked();
+    SetCountingLocked(false);
 }
 
 void PkgDelaySuspendInfo::UpdateQuota(bool reset)
 {
-    spendTime_ = isCounting_ ? GetModifiedTime() : 0;
-    quota_ -= spendTime_;
-    if (quota_ < 0) {
-        quota_ = 0;
+    lock_guard<mutex> lock(infoLock_);
+    UpdateQuotaLocked(reset);
+}
+
+void PkgDelaySuspendInfo::UpdateQuotaLocked(bool reset)
+{
+    bool isCounting = isCounting_.load(std::memory_order_relaxed);
+    int32_t spendTime = isCounting ? GetModifiedTime(baseTime_.load(std::memory_order_relaxed)) : 0;
+    int32_t quota = quota_.load(std::memory_order_relaxed) - spendTime;
+    if (quota < 0) {
+        quota = 0;
     }
-    baseTime_ = static_cast<int32_t>(TimeProvider::GetCurrentTime());
     if (reset) {
-        quota_ = INIT_QUOTA;
+        quota = INIT_QUOTA;
+    }
+    {
+        SeqWriteGuard guard(quotaSeq_);
+        spendTime_.store(spendTime, std::memory_order_relaxed);
+        quota_.store(quota, std::memory_order_relaxed);
+        baseTime_.store(static_cast<int32_t>(TimeProvider::GetCurrentTime()), std::memory_order_relaxed);
     }
     BGTASK_LOGI("%{public}s Lastest quota: %{public}d, spendTime: %{public}d, isCounting: %{public}d",
-        pkg_.c_str(), quota_, spendTime_, isCounting_);
+        pkg_.c_str(), quota, spendTime, isCounting);
+}
+
+void PkgDelaySuspendInfo::SetCountingLocked(bool isCounting)
+{
+    SeqWriteGuard guard(quotaSeq_);
+    isCounting_.store(isCounting, std::memory_order_relaxed);
+}
+
+int32_t PkgDelaySuspendInfo::GetRemainQuota()
+{
+    int32_t quota = 0;
+    int32_t baseTime = 0;
+    bool isCounting = false;
+    uint32_t seq = 0;
+    do {
+        seq = quotaSeq_.ReadBegin();
+        quota = quota_.load(std::memory_order_relaxed);
+        baseTime = baseTime_.load(std::memory_order_relaxed);
+        isCounting = isCounting_.load(std::memory_order_relaxed);
+    } while (quotaSeq_.ReadRetry(seq));
+    if (isCounting) {
+        quota -= GetModifiedTime(baseTime);
+    }
+    return (quota < 0) ? 0 : quota;
 }
 
-int32_t PkgDelaySuspendInfo::GetModifiedTime()
+int32_t PkgDelaySuspendInfo::GetModifiedTime(int32_t baseTime)
 {
     bool isExemptedApp = DelayedSingleton<BgtaskConfig>::GetInstance()->
         IsTransientTaskExemptedQuatoApp(pkg_);
@@ -161,7 +215,7 @@ int32_t PkgDelaySuspendInfo::GetModifiedTime()
     }
     BGTASK_LOGD("bundleName: %{public}s exempted: %{public}d exempted_quota: %{public}d",
         pkg_.c_str(), isExemptedApp, exempted_quota);
-    int32_t time = static_cast<int32_t>(TimeProvider::GetCurrentTime()) - baseTime_ - exempted_quota;
+    int32_t time = static_cast<int32_t>(TimeProvider::GetCurrentTime()) - baseTime - exempted_quota;
     return (time < 0) ? 0 : time;
 }
 
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Copyright (c) 2022-2026 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -15,43 +15,139 @@
 
 #include "timer_manager.h"
 
+#include <algorithm>
+
 #include "background_task_mgr_service.h"
+#include "time_provider.h"
 #include "transient_task_log.h"
 
 namespace OHOS {
 namespace BackgroundTaskMgr {
+namespace {
+constexpr uint32_t TICK_EVENT_ID = 0;
+constexpr int64_t TICK_INTERVAL_MS = 100;
+constexpr uint32_t TIMER_TYPE_SHIFT = 32;
+
+uint64_t MakeTimerKey(int32_t requestId, TimerType type)
+{
+    return (static_cast<uint64_t>(type) << TIMER_TYPE_SHIFT) | static_cast<uint32_t>(requestId);
+}
+
+bool IsExpiryTimer(uint64_t key)
+{
+    return (key >> TIMER_TYPE_SHIFT) == static_cast<uint64_t>(TimerType::EXPIRY);
+}
+}
 
 TimerManager::TimerManager(const wptr<BackgroundTaskMgrService>& service,
-    const std::shared_ptr<AppExecFwk::EventRunner>& runner) : service_(service)
+    const std::shared_ptr<AppExecFwk::EventRunner>& runner)
+    : service_(service), timingWheel_(TICK_INTERVAL_MS, TimeProvider::GetCurrentTime())
 {
     if (runner != nullptr) {
         SetEventRunner(runner);
     }
 }
 
-bool TimerManager::AddTimer(int32_t requestId, int32_t interval)
+bool TimerManager::AddTimer(int32_t requestId, int32_t interval, TimerType type)
+{
+    BGTASK_LOGI("Add request id: %{public}d, type: %{public}u", requestId, static_cast<uint32_t>(type));
+    std::lock_guard<std::mutex> lock(timerMutex_);
+    int64_t nowMs = TimeProvider::GetCurrentTime();
+    uint64_t key = MakeTimerKey(requestId, type);
+    if (!timingWheel_.IsArmed(key)) {
+        CountTimerLocked(key, true);
+    }
+    timingWheel_.Arm(key, nowMs + interval);
+    ScheduleTickLocked(nowMs);
+    return true;
+}
+
+void TimerManager::RemoveTimer(int32_t requestId, TimerType type)
+{
+    BGTASK_LOGI("Remove request id: %{public}d, type: %{public}u", requestId, static_cast<uint32_t>(type));
+    std::lock_guard<std::mutex> lock(timerMutex_);
+    uint64_t key = MakeTimerKey(requestId, type);
+    if (!timingWheel_.Cancel(key)) {
+        return;
+    }
+    CountTimerLocked(key, false);
+    if (timingWheel_.Size() == 0) {
+        // 提前触发的刻度只会空转，仅在没有定时器时移除
+        RemoveEvent(TICK_EVENT_ID);
+        scheduledWakeupMs_ = -1;
+    }
+}
+
+TimerStats TimerManager::GetTimerStats()
+{
+    std::lock_guard<std::mutex> lock(timerMutex_);
+    return stats_;
+}
+
+void TimerManager::CountTimerLocked(uint64_t key, bool armed)
 {
-    BGTASK_LOGI("Add request id: %{public}d", requestId);
-    return SendEvent(requestId, 0, interval);
+    uint32_t &count = IsExpiryTimer(key) ? stats_.expiryCount : stats_.watchdogCount;
+    if (armed) {
+        count++;
+    } else if (count > 0) {
+        count--;
+    }
 }
 
-void TimerManager::RemoveTimer(int32_t requestId)
+void TimerManager::ScheduleTickLocked(int64_t nowMs)
 {
-    BGTASK_LOGI("Remove request id: %{public}d", requestId);
-    return RemoveEvent(requestId);
+    int64_t wakeupMs = timingWheel_.GetNextWakeupMs();
+    if (wakeupMs < 0 || (scheduledWakeupMs_ >= 0 && scheduledWakeupMs_ <= wakeupMs)) {
+        return;
+    }
+    RemoveEvent(TICK_EVENT_ID);
+    if (SendEvent(TICK_EVENT_ID, 0, std::max<int64_t>(wakeupMs - nowMs, 0))) {
+        scheduledWakeupMs_ = wakeupMs;
+    }
 }
 
 void TimerManager::ProcessEvent(const AppExecFwk::InnerEvent::Pointer& event)
 {
-    if (event == nullptr) {
+    if (event == nullptr || event->GetInnerEventId() != TICK_EVENT_ID) {
+        return;
+    }
+    std::vector<ExpiredTimer> expired;
+    {
+        std::lock_guard<std::mutex> lock(timerMutex_);
+        int64_t nowMs = TimeProvider::GetCurrentTime();
+        scheduledWakeupMs_ = -1;
+        timingWheel_.Advance(nowMs, expired);
+        stats_.tickCount++;
+        for (const auto &timer : expired) {
+            CountTimerLocked(timer.key, false);
+            stats_.lastLatenessMs = nowMs - timer.expireMs;
+            stats_.maxLatenessMs = std::max(stats_.maxLatenessMs, stats_.lastLatenessMs);
+        }
+        stats_.firedCount += expired.size();
+        ScheduleTickLocked(nowMs);
+    }
+    // 回调中会重新添加定时器，需在锁外分发
+    DispatchExpiredTimers(expired);
+}
+
+void TimerManager::DispatchExpiredTimers(const std::vector<ExpiredTimer> &expired)
+{
+    if (expired.empty()) {
         return;
     }
-    int32_t requestId = event->GetInnerEventId();
     auto bgTask = service_.promote();
     if (bgTask == nullptr) {
         return;
     }
-    bgTask->HandleRequestExpired(requestId);
+    for (const auto &timer : expired) {
+        int32_t requestId = static_cast<int32_t>(static_cast<uint32_t>(timer.key));
+        if (IsExpiryTimer(timer.key)) {
+            bgTask->HandleRequestExpired(requestId);
+        } else {
+            BGTASK_LOGI("handle watchdog, force cancel requestId: %{public}d", requestId);
+            bgTask->ForceCancelSuspendDelay(requestId);
+        }
+    }
 }
 }  // namespace BackgroundTaskMgr
-}  // namespace OHOS
\ No newline at end of file
+}  // namespace OHOS
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "timing_wheel.h"
+
+#include <algorithm>
+
+namespace OHOS {
+namespace BackgroundTaskMgr {
+TimingWheel::TimingWheel(int64_t tickMs, int64_t startMs) : tickMs_(std::max<int64_t>(tickMs, 1)), startMs_(startMs)
+{}
+
+uint64_t TimingWheel::ToTick(int64_t timeMs, bool roundUp) const
+{
+    int64_t elapsed = timeMs - startMs_;
+    if (elapsed <= 0) {
+        return 0;
+    }
+    return static_cast<uint64_t>(roundUp ? (elapsed + tickMs_ - 1) / tickMs_ : elapsed / tickMs_);
+}
+
+void TimingWheel::Arm(uint64_t key, int64_t expireMs)
+{
+    Cancel(key);
+    TimerEntry entry;
+    entry.expireMs = expireMs;
+    // 到期的定时器在下一个刻度触发，刻度只向前推进
+    entry.expireTick = std::max(ToTick(expireMs, true), currentTick_ + 1);
+    Place(key, entries_.emplace(key, entry).first->second);
+}
+
+bool TimingWheel::Cancel(uint64_t key)
+{
+    auto iter = entries_.find(key);
+    if (iter == entries_.end()) {
+        return false;
+    }
+    Unlink(iter->second);
+    entries_.erase(iter);
+    return true;
+}
+
+bool TimingWheel::IsArmed(uint64_t key) const
+{
+    return entries_.count(key) != 0;
+}
+
+size_t TimingWheel::Size() const
+{
+    return entries_.size();
+}
+
+void TimingWheel::Place(uint64_t key, TimerEntry &entry)
+{
+    // 超出最高层范围的定时器先放在最高层最远的槽位，级联时重新放置
+    uint64_t maxDelta = (1ull << (SLOT_BITS * LEVEL_COUNT)) - 1;
+    uint64_t tick = std::min(entry.expireTick, currentTick_ + maxDelta);
+    uint64_t delta = tick - currentTick_;
+    uint32_t level = 0;
+    while (level + 1 < LEVEL_COUNT && delta >= (1ull << (SLOT_BITS * (level + 1)))) {
+        level++;
+    }
+    entry.level = level;
+    entry.slot = static_cast<uint32_t>((tick >> (SLOT_BITS * level)) & SLOT_MASK);
+    auto &slot = slots_[level][entry.slot];
+    entry.pos = slot.insert(slot.end(), key);
+    occupied_[level] |= 1ull << entry.slot;
+}
+
+void TimingWheel::Unlink(const TimerEntry &entry)
+{
+    auto &slot = slots_[entry.level][entry.slot];
+    slot.erase(entry.pos);
+    if (slot.empty()) {
+        occupied_[entry.level] &= ~(1ull << entry.slot);
+    }
+}
+
+void TimingWheel::Cascade(uint32_t level)
+{
+    uint32_t index = static_cast<uint32_t>((currentTick_ >> (SLOT_BITS * level)) & SLOT_MASK);
+    std::list<uint64_t> keys;
+    keys.swap(slots_[level][index]);
+    occupied_[level] &= ~(1ull << index);
+    for (uint64_t key : keys) {
+        Place(key, entries_[key]);
+    }
+}
+
+void TimingWheel::Expire(std::vector<ExpiredTimer> &expired)
+{
+    uint32_t index = static_cast<uint32_t>(currentTick_ & SLOT_MASK);
+    std::list<uint64_t> keys;
+    keys.swap(slots_[0][index]);
+    occupied_[0] &= ~(1ull << index);
+    for (uint64_t key : keys) {
+        auto iter = entries_.find(key);
+        expired.push_back({key, iter->second.expireMs});
+        entries_.erase(iter);
+    }
+}
+
+void TimingWheel::Advance(int64_t nowMs, std::vector<ExpiredTimer> &expired)
+{
+    uint64_t targetTick = ToTick(nowMs, false);
+    while (currentTick_ < targetTick) {
+        if (entries_.empty()) {
+            // 没有定时器时直接跳到目标刻度
+            currentTick_ = targetTick;
+            break;
+        }
+        currentTick_++;
+        for (uint32_t level = 1; level < LEVEL_COUNT; level++) {
+            if ((currentTick_ & ((1ull << (SLOT_BITS * level)) - 1)) != 0) {
+                break;
+            }
+            Cascade(level);
+        }
+        Expire(expired);
+    }
+}
+
+int64_t TimingWheel::GetNextWakeupMs() const
+{
+    if (entries_.empty()) {
+        return -1;
+    }
+    uint64_t nextTick = UINT64_MAX;
+    for (uint32_t level = 0; level < LEVEL_COUNT; level++) {
+        if (occupied_[level] == 0) {
+            continue;
+        }
+        uint32_t shift = SLOT_BITS * level;
+        uint64_t block = currentTick_ >> shift;
+        // 找到当前位置之后第一个非空槽位，该槽位在对应块的起始刻度触发或级联
+        for (uint64_t step = 1; step <= SLOT_COUNT; step++) {
+            if ((occupied_[level] & (1ull << ((block + step) & SLOT_MASK))) != 0) {
+                nextTick = std::min(nextTick, (block + step) << shift);
+                break;
+            }
+        }
+    }
+    return startMs_ + static_cast<int64_t>(nextTick) * tickMs_;
+}
+}  // namespace BackgroundTaskMgr
+}  // namespace OHOS
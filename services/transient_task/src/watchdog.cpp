@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Copyright (c) 2022-2026 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -15,55 +15,30 @@
 
 #include "watchdog.h"
 
-#include "iservice_registry.h"
-#include "system_ability_definition.h"
-
-#include "background_task_mgr_service.h"
-#include "hisysevent.h"
 #include "transient_task_log.h"
 
-using namespace std;
-
 namespace OHOS {
 namespace BackgroundTaskMgr {
 
-Watchdog::Watchdog(const wptr<BackgroundTaskMgrService>& service, const std::shared_ptr<DecisionMaker>& decision,
-    const std::shared_ptr<AppExecFwk::EventRunner>& runner) : service_(service), decision_(decision)
-{
-    if (runner != nullptr) {
-        SetEventRunner(runner);
-    }
-}
+Watchdog::Watchdog(const std::shared_ptr<TimerManager>& timerManager) : timerManager_(timerManager) {}
 
 bool Watchdog::AddWatchdog(int32_t requestId, const std::shared_ptr<KeyInfo>& info, int32_t interval)
 {
     BGTASK_LOGI("AddWatchdog %{public}d", requestId);
-    return SendEvent(requestId, info, interval);
+    if (info == nullptr || timerManager_ == nullptr) {
+        return false;
+    }
+    // 看门狗与超时定时器共用一个时间轮，到期后由 TimerManager 强制取消任务
+    return timerManager_->AddTimer(requestId, interval, TimerType::WATCHDOG);
 }
 
 void Watchdog::RemoveWatchdog(int32_t requestId)
 {
     BGTASK_LOGI("RemoveWatchdog %{public}d", requestId);
-    RemoveEvent(requestId);
-}
-
-void Watchdog::ProcessEvent(const AppExecFwk::InnerEvent::Pointer& event)
-{
-    if (event == nullptr) {
-        return;
-    }
-    int32_t requestId = event->GetInnerEventId();
-    const shared_ptr<KeyInfo>& info = event->GetSharedObject<KeyInfo>();
-    if (info == nullptr) {
-        return;
-    }
-    auto bgTask = service_.promote();
-    if (bgTask == nullptr) {
-        BGTASK_LOGE("fail to get bgTask service.");
+    if (timerManager_ == nullptr) {
         return;
     }
-    BGTASK_LOGI("handle watchdog, force cancel requestId: %{public}d", requestId);
-    bgTask->ForceCancelSuspendDelay(requestId);
+    timerManager_->RemoveTimer(requestId, TimerType::WATCHDOG);
 }
 }  // namespace BackgroundTaskMgr
-}  // namespace OHOS
\ No newline at end of file
+}  // namespace OHOS